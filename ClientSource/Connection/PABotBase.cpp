@@ -30,6 +30,12 @@ using std::endl;
 namespace PokemonAutomation{
 
 
+const size_t PABotBase::PENDING_WINDOW;
+const size_t PABotBase::PENDING_RESERVED;
+const uint64_t PABotBase::SEQNUM_BATCHED;
+const size_t PABotBase::TIMER_WHEEL_SLOTS;
+const int PABotBase::TIMER_TICK_MILLIS;
+
 
 PABotBase::PABotBase(
     Logger& logger,
@@ -42,6 +48,21 @@ PABotBase::PABotBase(
     , m_send_seq(1)
     , m_retransmit_delay(retransmit_delay)
     , m_last_ack(current_time())
+    , m_max_pending_requests(PABB_DEVICE_QUEUE_SIZE)
+    , m_max_batch_size(0)
+    , m_adaptive_retransmit(false)
+    , m_srtt(WallClock::duration::zero())
+    , m_rttvar(WallClock::duration::zero())
+    , m_batch_commands(0)
+    , m_pending(PENDING_WINDOW)
+    , m_oldest_seqnum(1)
+    , m_pending_requests(0)
+    , m_pending_commands(0)
+    , m_unacked_commands(0)
+    , m_timer_epoch(current_time())
+    , m_timer_wheel{}
+    , m_timer_cursor(0)
+    , m_timers_armed(0)
     , m_state(State::RUNNING)
     , m_error(false)
     , m_retransmit_thread(run_with_catch, "PABotBase::retransmit_thread()", [this]{ retransmit_thread(); })
@@ -55,18 +76,35 @@ PABotBase::~PABotBase(){
     }
 }
 
+void PABotBase::enable_pipelining(size_t queue_size, size_t max_batch_size){
+    m_sanitizer.check_usage();
+
+    queue_size = std::min<size_t>(queue_size, PABB_MAX_DEVICE_QUEUE_SIZE);
+    max_batch_size = std::min<size_t>(max_batch_size, PABB_MAX_BATCH_MESSAGE_SIZE);
+
+    {
+        SpinLockGuard lg(m_state_lock, "PABotBase::enable_pipelining()");
+        m_max_pending_requests.store(queue_size == 0 ? PABB_DEVICE_QUEUE_SIZE : queue_size);
+
+        //  A batch needs room for its seqnum and at least 2 entries.
+        m_max_batch_size = max_batch_size >= sizeof(pabb_MsgCommandBatch) + 2 * sizeof(pabb_MsgCommandBatchEntry)
+            ? max_batch_size
+            : 0;
+        m_adaptive_retransmit = true;
+    }
+
+    m_logger.log(
+        "Pipelining enabled: queue size = " + std::to_string(m_max_pending_requests.load()) +
+        ", max batch size = " + std::to_string(m_max_batch_size)
+    );
+}
+
 size_t PABotBase::inflight_requests(){
     m_sanitizer.check_usage();
 
     //  Must be called under m_state_lock.
 
-    size_t ret = m_pending_requests.size();
-    for (const auto& item : m_pending_commands){
-        if (item.second.state == AckState::NOT_ACKED){
-            ret++;
-        }
-    }
-    return ret;
+    return m_pending_requests + m_unacked_commands;
 }
 
 void PABotBase::connect(){
@@ -130,7 +168,7 @@ void PABotBase::wait_for_all_requests(const Cancellable* cancelled){
         }
         {
             SpinLockGuard lg1(m_state_lock, "PABotBase::wait_for_all_requests()");
-            if (m_pending_requests.empty() && m_pending_commands.empty()){
+            if (m_pending_requests == 0 && m_pending_commands == 0 && m_batch_commands == 0){
                 return;
             }
         }
@@ -157,7 +195,7 @@ bool PABotBase::try_stop_all_commands(){
 
     m_sanitizer.check_usage();
 
-    uint64_t seqnum = try_issue_request(nullptr, Microcontroller::DeviceRequest_request_stop(), true, MAX_PENDING_REQUESTS);
+    uint64_t seqnum = try_issue_request(nullptr, Microcontroller::DeviceRequest_request_stop(), true, m_max_pending_requests);
     if (seqnum != 0){
         clear_all_active_commands(seqnum);
         return true;
@@ -190,7 +228,7 @@ void PABotBase::stop_all_commands(){
 bool PABotBase::try_next_command_interrupt(){
     m_sanitizer.check_usage();
 
-    uint64_t seqnum = try_issue_request(nullptr, Microcontroller::DeviceRequest_next_command_interrupt(), true, MAX_PENDING_REQUESTS);
+    uint64_t seqnum = try_issue_request(nullptr, Microcontroller::DeviceRequest_next_command_interrupt(), true, m_max_pending_requests);
     if (seqnum != 0){
         clear_all_active_commands(seqnum);
         return true;
@@ -211,60 +249,208 @@ void PABotBase::clear_all_active_commands(uint64_t seqnum){
     std::lock_guard<std::mutex> lg0(m_sleep_lock);
     SpinLockGuard lg1(m_state_lock, "PABotBase::next_command_interrupt()");
 
-    if (!m_pending_commands.empty()){
-        //  Remove all active commands up to the seqnum.
-        while (true){
-            auto iter = m_pending_commands.begin();
-            if (iter == m_pending_commands.end() || iter->first > seqnum){
-                break;
-            }
-            iter->second.sanitizer.check_usage();
-            m_pending_commands.erase(iter);
+    //  Remove all active commands up to the seqnum.
+    for (uint64_t c = oldest_live_seqnum(); c <= seqnum && m_pending_commands != 0; c++){
+        PendingMessage* entry = find_pending(c);
+        if (entry != nullptr && entry->is_command){
+            remove_pending(*entry);
         }
     }
 
+    //  The open batch was issued before the stop. Drop it too.
+    m_batch = BotBaseMessage();
+    m_batch_commands = 0;
+
     m_cv.notify_all();
 }
-template <typename Map>
-uint64_t PABotBase::infer_full_seqnum(const Map& map, seqnum_t seqnum) const{
-    m_sanitizer.check_usage();
+PABotBase::PendingMessage* PABotBase::find_pending(seqnum_t seqnum){
+    //  The protocol uses a 32-bit seqnum that wraps around. Internally we use
+    //  a full 64-bit seqnum so that it never wraps.
+
+    //  Since live seqnums never span more than PENDING_WINDOW, the lower bits
+    //  of the 32-bit seqnum determine the slot. So there is no ambiguity on
+    //  which message is being referred to.
+    PendingMessage& entry = m_pending[seqnum & (PENDING_WINDOW - 1)];
+    if (entry.seqnum == 0 || (seqnum_t)entry.seqnum != seqnum){
+        return nullptr;
+    }
+    entry.sanitizer.check_usage();
+    return &entry;
+}
+PABotBase::PendingMessage* PABotBase::find_pending(uint64_t seqnum){
+    PendingMessage& entry = m_pending[seqnum & (PENDING_WINDOW - 1)];
+    if (entry.seqnum == 0 || entry.seqnum != seqnum){
+        return nullptr;
+    }
+    entry.sanitizer.check_usage();
+    return &entry;
+}
+PABotBase::PendingMessage& PABotBase::add_pending(bool is_command, BotBaseMessage message, bool silent_remove){
+    //  The caller must have already checked that the seqnum is in the window.
+    uint64_t seqnum = m_send_seq;
+    PendingMessage& entry = m_pending[seqnum & (PENDING_WINDOW - 1)];
+    entry.sanitizer.check_usage();
+    if (entry.seqnum != 0){
+        throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Duplicate sequence number: " + std::to_string(seqnum));
+    }
 
-    //  The protocol uses a 32-bit seqnum that wraps around. For our purposes of
-    //  retransmits, we use a full 64-bit seqnum to maintain sorting order
-    //  across the wrap-arounds.
+    seqnum_t seqnum_s = (seqnum_t)seqnum;
+    memcpy(&message.body[0], &seqnum_s, sizeof(seqnum_t));
 
-    //  Since the oldest unacked messaged will never be more than 63 (MAX_SEQNUM_GAP)
-    //  requests old, there is no ambiguity on which request is being referred
-    //  to with just the lower 32 bits.
-    //  Here we infer the upper 32 bits of the seqnum to obtain the full 64-bit
-    //  seqnum that we need to index our map.
+    m_send_seq = seqnum + 1;
 
-    //  This needs to be called inside the lock. Furthermore, the map must not
-    //  be empty. If it is empty, we know we don't have it and can drop it
-    //  before we even call this function.
+    entry.seqnum = seqnum;
+    entry.is_command = is_command;
+    entry.state = AckState::NOT_ACKED;
+    entry.silent_remove = silent_remove;
+    entry.retransmitted = false;
+    entry.request = std::move(message);
+    entry.first_sent = current_time();
+    arm_timer(entry, entry.first_sent + m_retransmit_delay.load(std::memory_order_relaxed));
+
+    if (is_command){
+        m_pending_commands++;
+        m_unacked_commands++;
+    }else{
+        m_pending_requests++;
+    }
+    return entry;
+}
+void PABotBase::mark_acked(PendingMessage& entry){
+    if (entry.state != AckState::NOT_ACKED){
+        return;
+    }
+    disarm_timer(entry);
+    if (entry.is_command){
+        m_unacked_commands--;
+    }
+    entry.state = AckState::ACKED;
+}
+void PABotBase::remove_pending(PendingMessage& entry){
+    if (entry.state == AckState::NOT_ACKED){
+        disarm_timer(entry);
+        if (entry.is_command){
+            m_unacked_commands--;
+        }
+    }
+    if (entry.is_command){
+        m_pending_commands--;
+    }else{
+        m_pending_requests--;
+    }
 
-    //  Figure out the upper 32 bits of the seqnum.
-    uint64_t lo = map.begin()->first;
-    uint64_t hi = map.rbegin()->first;
-    uint64_t lo_candidate = (lo & 0xffffffff00000000) | seqnum;
-    uint64_t hi_candidate = (hi & 0xffffffff00000000) | seqnum;
-    return lo_candidate >= lo
-        ? lo_candidate
-        : hi_candidate;
+    //  Keep the buffers around for the next message in this slot.
+    entry.seqnum = 0;
+    entry.request.body.clear();
+    entry.ack.body.clear();
 }
 
-uint64_t PABotBase::oldest_live_seqnum() const{
+uint64_t PABotBase::oldest_live_seqnum(){
     m_sanitizer.check_usage();
 
     //  Must call under state lock.
-    uint64_t oldest = m_send_seq;
-    if (!m_pending_requests.empty()){
-        oldest = std::min(oldest, m_pending_requests.begin()->first);
+
+    //  Entries are removed roughly in order. So this only ever advances by
+    //  a few slots at a time.
+    while (m_oldest_seqnum < m_send_seq && m_pending[m_oldest_seqnum & (PENDING_WINDOW - 1)].seqnum != m_oldest_seqnum){
+        m_oldest_seqnum++;
     }
-    if (!m_pending_commands.empty()){
-        oldest = std::min(oldest, m_pending_commands.begin()->first);
+    return m_oldest_seqnum;
+}
+bool PABotBase::window_available(bool urgent){
+    m_sanitizer.check_usage();
+
+    //  Must call under state lock.
+
+    static_assert(
+        PENDING_WINDOW - PENDING_RESERVED >= 2 * PABB_MAX_DEVICE_QUEUE_SIZE,
+        "The pending window is too small for the largest device queue."
+    );
+
+    size_t window = urgent ? PENDING_WINDOW : PENDING_WINDOW - PENDING_RESERVED;
+    return m_send_seq - oldest_live_seqnum() < window;
+}
+
+uint64_t PABotBase::timer_tick(WallClock time) const{
+    if (time <= m_timer_epoch){
+        return 0;
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time - m_timer_epoch).count() / TIMER_TICK_MILLIS;
+}
+void PABotBase::arm_timer(PendingMessage& entry, WallClock deadline){
+    //  Never put a timer behind the cursor. It would wait a full rotation.
+    uint64_t tick = std::max(timer_tick(deadline), m_timer_cursor);
+    entry.timer_slot = tick % TIMER_WHEEL_SLOTS;
+    PendingMessage*& head = m_timer_wheel[entry.timer_slot];
+    entry.deadline = deadline;
+    entry.timer_prev = nullptr;
+    entry.timer_next = head;
+    if (head != nullptr){
+        head->timer_prev = &entry;
+    }
+    head = &entry;
+    entry.timer_armed = true;
+    m_timers_armed++;
+}
+void PABotBase::disarm_timer(PendingMessage& entry){
+    if (!entry.timer_armed){
+        return;
+    }
+    if (entry.timer_prev != nullptr){
+        entry.timer_prev->timer_next = entry.timer_next;
+    }else{
+        m_timer_wheel[entry.timer_slot] = entry.timer_next;
+    }
+    if (entry.timer_next != nullptr){
+        entry.timer_next->timer_prev = entry.timer_prev;
+    }
+    entry.timer_prev = nullptr;
+    entry.timer_next = nullptr;
+    entry.timer_armed = false;
+    m_timers_armed--;
+}
+void PABotBase::process_timers(WallClock now, std::chrono::milliseconds retransmit_delay){
+    //  Must be called under m_state_lock.
+
+    //  Only whole ticks that have fully elapsed are processed. So a timer
+    //  fires up to one tick late, but never early.
+    uint64_t now_tick = timer_tick(now);
+    if (now_tick <= m_timer_cursor){
+        return;
+    }
+
+    //  Collect everything that's due from the buckets we've passed.
+    //  If we've fallen more than a rotation behind, every bucket is passed.
+    //  Timers for later rotations stay where they are.
+    PendingMessage* due[PENDING_WINDOW];
+    size_t due_count = 0;
+    uint64_t ticks = std::min<uint64_t>(now_tick - m_timer_cursor, (uint64_t)TIMER_WHEEL_SLOTS);
+    for (uint64_t t = 0; t < ticks; t++){
+        PendingMessage* entry = m_timer_wheel[(m_timer_cursor + t) % TIMER_WHEEL_SLOTS];
+        while (entry != nullptr){
+            PendingMessage* next = entry->timer_next;
+            if (timer_tick(entry->deadline) < now_tick && due_count < PENDING_WINDOW){
+                disarm_timer(*entry);
+                due[due_count++] = entry;
+            }
+            entry = next;
+        }
+    }
+    m_timer_cursor = now_tick;
+
+    //  Retransmit in seqnum order so the device sees commands in the order
+    //  they were issued.
+    std::sort(
+        due, due + due_count,
+        [](const PendingMessage* a, const PendingMessage* b){ return a->seqnum < b->seqnum; }
+    );
+    for (size_t c = 0; c < due_count; c++){
+        PendingMessage& entry = *due[c];
+        entry.sanitizer.check_usage();
+        entry.retransmitted = true;
+        send_message(entry.request, true);
+        arm_timer(entry, now + retransmit_delay);
     }
-    return oldest;
 }
 
 template <typename Params>
@@ -282,27 +468,24 @@ void PABotBase::process_ack_request(BotBaseMessage message){
     {
         SpinLockGuard lg(m_state_lock, "PABotBase::process_ack_request()");
 
-        if (m_pending_requests.empty()){
+        PendingMessage* entry = find_pending(seqnum);
+        if (entry == nullptr || entry->is_command){
             m_sniffer->log("Unexpected request ack message: seqnum = " + std::to_string(seqnum));
             return;
         }
 
-        uint64_t full_seqnum = infer_full_seqnum(m_pending_requests, seqnum);
-        std::map<uint64_t, PendingRequest>::iterator iter = m_pending_requests.find(full_seqnum);
-        if (iter == m_pending_requests.end()){
-            m_sniffer->log("Unexpected request ack message: seqnum = " + std::to_string(seqnum));
-            return;
-        }
-        iter->second.sanitizer.check_usage();
-
-        state = iter->second.state;
+        state = entry->state;
         if (state == AckState::NOT_ACKED){
-            if (iter->second.silent_remove){
-                m_pending_requests.erase(iter);
+            if (!entry->retransmitted){
+                on_rtt_sample(current_time() - entry->first_sent);
+            }
+            if (entry->silent_remove){
+                remove_pending(*entry);
             }else{
-                iter->second.state = AckState::ACKED;
-                iter->second.ack = std::move(message);
+                mark_acked(*entry);
+                entry->ack = std::move(message);
             }
+            flush_batch(m_max_pending_requests);
         }
     }
 
@@ -336,26 +519,23 @@ void PABotBase::process_ack_command(BotBaseMessage message){
 
     SpinLockGuard lg(m_state_lock, "PABotBase::process_ack_command()");
 
-    if (m_pending_commands.empty()){
+    PendingMessage* entry = find_pending(seqnum);
+    if (entry == nullptr || !entry->is_command){
         m_sniffer->log("Unexpected command ack message: seqnum = " + std::to_string(seqnum));
         return;
     }
 
-    uint64_t full_seqnum = infer_full_seqnum(m_pending_commands, seqnum);
-    auto iter = m_pending_commands.find(full_seqnum);
-    if (iter == m_pending_commands.end()){
-        m_sniffer->log("Unexpected command ack message: seqnum = " + std::to_string(seqnum));
-        return;
-    }
-    iter->second.sanitizer.check_usage();
-
     m_last_ack.store(current_time(), std::memory_order_release);
 
-    switch (iter->second.state){
+    switch (entry->state){
     case AckState::NOT_ACKED:
-//        std::cout << "acked: " << full_seqnum << std::endl;
-        iter->second.state = AckState::ACKED;
-        iter->second.ack = std::move(message);
+//        std::cout << "acked: " << entry->seqnum << std::endl;
+        if (!entry->retransmitted){
+            on_rtt_sample(current_time() - entry->first_sent);
+        }
+        mark_acked(*entry);
+        entry->ack = std::move(message);
+        flush_batch(m_max_pending_requests);
         return;
     case AckState::ACKED:
         m_sniffer->log("Duplicate command ack message: seqnum = " + std::to_string(seqnum));
@@ -387,33 +567,25 @@ void PABotBase::process_command_finished(BotBaseMessage message){
 
     send_message(BotBaseMessage(PABB_MSG_ACK_REQUEST, std::string((char*)&ack, sizeof(ack))), false);
 
-    if (m_pending_commands.empty()){
-        m_sniffer->log(
-            "Unexpected command finished message: seqnum = " + std::to_string(seqnum) +
-            ", command_seqnum = " + std::to_string(command_seqnum)
-        );
-        return;
-    }
-
-    uint64_t full_seqnum = infer_full_seqnum(m_pending_commands, command_seqnum);
-    auto iter = m_pending_commands.find(full_seqnum);
-    if (iter == m_pending_commands.end()){
+    PendingMessage* entry = find_pending(command_seqnum);
+    if (entry == nullptr || !entry->is_command){
         m_sniffer->log(
             "Unexpected command finished message: seqnum = " + std::to_string(seqnum) +
             ", command_seqnum = " + std::to_string(command_seqnum)
         );
         return;
     }
-    iter->second.sanitizer.check_usage();
 
-    switch (iter->second.state){
+    switch (entry->state){
     case AckState::NOT_ACKED:
     case AckState::ACKED:
-        iter->second.state = AckState::FINISHED;
-        iter->second.ack = std::move(message);
-        if (iter->second.silent_remove){
-            m_pending_commands.erase(iter);
+        mark_acked(*entry);
+        entry->state = AckState::FINISHED;
+        entry->ack = std::move(message);
+        if (entry->silent_remove){
+            remove_pending(*entry);
         }
+        flush_batch(m_max_pending_requests);
         m_cv.notify_all();
         return;
     case AckState::FINISHED:
@@ -465,49 +637,38 @@ void PABotBase::retransmit_thread(){
     m_sanitizer.check_usage();
 
 //    cout << "retransmit_thread()" << endl;
-    auto last_sent = current_time();
     while (m_state.load(std::memory_order_acquire) == State::RUNNING){
-        auto now = current_time();
+        std::chrono::milliseconds retransmit_delay = m_retransmit_delay.load(std::memory_order_relaxed);
 
-        if (now - last_sent < m_retransmit_delay){
-            std::unique_lock<std::mutex> lg(m_sleep_lock);
-            if (m_state.load(std::memory_order_acquire) != State::RUNNING){
-                break;
-            }
-            if (m_error.load(std::memory_order_acquire)){
-                break;
-            }
-            m_cv.wait_for(lg, m_retransmit_delay);
-            continue;
+        //  Process retransmits.
+        bool timers_armed;
+        {
+            SpinLockGuard lg(m_state_lock, "PABotBase::retransmit_thread()");
+
+            //  Retransmit everything whose timer has expired.
+            process_timers(current_time(), retransmit_delay);
+
+            //  Safety net in case nothing else frees up a slot for the open batch.
+            flush_batch(m_max_pending_requests);
+
+            timers_armed = m_timers_armed != 0;
         }
 
-        //  Process retransmits.
-        SpinLockGuard lg(m_state_lock, "PABotBase::retransmit_thread()");
-//        std::cout << "retransmit_thread - m_pending_messages.size(): " << m_pending_messages.size() << std::endl;
-//        cout << "m_pending_messages.size()" << endl;
-
-        //  Retransmit
-        //      Iterate through all pending requests and retransmit them in
-        //  chronological order. Skip the ones that are new.
-        for (auto& item : m_pending_requests){
-            item.second.sanitizer.check_usage();
-            if (
-                item.second.state == AckState::NOT_ACKED &&
-                current_time() - item.second.first_sent >= m_retransmit_delay
-            ){
-                send_message(item.second.request, true);
-            }
+        //  Tick the wheel while anything is waiting for an ack. Otherwise
+        //  there's nothing to do until the next message is sent.
+        std::unique_lock<std::mutex> lg(m_sleep_lock);
+        if (m_state.load(std::memory_order_acquire) != State::RUNNING){
+            break;
         }
-        for (auto& item : m_pending_commands){
-            item.second.sanitizer.check_usage();
-            if (
-                item.second.state == AckState::NOT_ACKED &&
-                current_time() - item.second.first_sent >= m_retransmit_delay
-            ){
-                send_message(item.second.request, true);
-            }
+        if (m_error.load(std::memory_order_acquire)){
+            break;
         }
-        last_sent = current_time();
+        m_cv.wait_for(
+            lg,
+            timers_armed
+                ? std::chrono::milliseconds(TIMER_TICK_MILLIS)
+                : retransmit_delay
+        );
     }
 //    cout << "retransmit_thread() - exit" << endl;
 }
@@ -549,35 +710,19 @@ uint64_t PABotBase::try_issue_request(
         return 0;
     }
 
-    //  Don't get too far ahead of the oldest seqnum.
-    uint64_t seqnum = m_send_seq;
-    if (seqnum - oldest_live_seqnum() > MAX_SEQNUM_GAP){
+    //  Don't get too far ahead of the oldest seqnum. Stop and interrupt
+    //  requests may still go out when a long command is holding it back.
+    bool urgent =
+        message.type == PABB_MSG_REQUEST_STOP ||
+        message.type == PABB_MSG_REQUEST_NEXT_CMD_INTERRUPT;
+    if (!window_available(urgent)){
         return 0;
     }
 
-    seqnum_t seqnum_s = (seqnum_t)seqnum;
-    memcpy(&message.body[0], &seqnum_s, sizeof(seqnum_t));
-
-    std::pair<std::map<uint64_t, PendingRequest>::iterator, bool> ret = m_pending_requests.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(seqnum),
-        std::forward_as_tuple()
-    );
-    if (!ret.second){
-        throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Duplicate sequence number: " + std::to_string(seqnum));
-    }
-
-    m_send_seq = seqnum + 1;
-
-    PendingRequest& handle = ret.first->second;
-
-    handle.silent_remove = silent_remove;
-    handle.request = std::move(message);
-    handle.first_sent = current_time();
-
+    PendingMessage& handle = add_pending(false, std::move(message), silent_remove);
     send_message(handle.request, false);
 
-    return seqnum;
+    return handle.seqnum;
 }
 uint64_t PABotBase::try_issue_command(
     const Cancellable* cancelled,
@@ -607,47 +752,123 @@ uint64_t PABotBase::try_issue_command(
         throw ConnectionException(&m_logger, "Serial connection was interrupted.");
     }
 
+    //  Pipelined: Keep commands in order behind the open batch.
+    if (m_max_batch_size != 0){
+        flush_batch(queue_limit);
+        if (m_batch_commands == 0 && command_slot_available(queue_limit, false)){
+            return send_command(std::move(message), silent_remove);
+        }
+
+        //  The device queue is full. Pack it into the batch to send as soon
+        //  as a slot frees up.
+        if (!silent_remove || !append_to_batch(message)){
+            return 0;
+        }
+
+        //  Batched commands don't have a seqnum yet.
+        return SEQNUM_BATCHED;
+    }
+
+    if (!command_slot_available(queue_limit, true)){
+        return 0;
+    }
+    return send_command(std::move(message), silent_remove);
+}
+bool PABotBase::command_slot_available(size_t queue_limit, bool log_throttle){
+    m_sanitizer.check_usage();
+
+    //  Must be called under m_state_lock.
+
     //  Command queue is full.
-    if (m_pending_commands.size() >= queue_limit){
+    if (m_pending_commands >= queue_limit){
 //        cout << "Command queue is full" << endl;
-        return 0;
+        return false;
     }
 
     //  Too many unacked requests in flight.
     if (inflight_requests() >= queue_limit){
-        m_logger.log("Message throttled due to too many inflight requests.");
-        return 0;
+        if (log_throttle){
+            m_logger.log("Message throttled due to too many inflight requests.");
+        }
+        return false;
     }
 
     //  Don't get too far ahead of the oldest seqnum.
-    uint64_t seqnum = m_send_seq;
-    if (seqnum - oldest_live_seqnum() > MAX_SEQNUM_GAP){
-        return 0;
+    if (!window_available(false)){
+        return false;
     }
 
-    seqnum_t seqnum_s = (seqnum_t)seqnum;
-    memcpy(&message.body[0], &seqnum_s, sizeof(seqnum_t));
+    return true;
+}
+uint64_t PABotBase::send_command(BotBaseMessage message, bool silent_remove){
+    m_sanitizer.check_usage();
 
-    std::pair<std::map<uint64_t, PendingCommand>::iterator, bool> ret = m_pending_commands.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(seqnum),
-        std::forward_as_tuple()
-    );
-    if (!ret.second){
-        throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Duplicate sequence number: " + std::to_string(seqnum));
+    //  Must be called under m_state_lock.
+
+    PendingMessage& handle = add_pending(true, std::move(message), silent_remove);
+    send_message(handle.request, false);
+
+    return handle.seqnum;
+}
+bool PABotBase::append_to_batch(const BotBaseMessage& message){
+    m_sanitizer.check_usage();
+
+    //  Must be called under m_state_lock.
+
+    size_t params = message.body.size() - sizeof(seqnum_t);
+    if (m_batch_commands == 0){
+        m_batch = BotBaseMessage(PABB_MSG_COMMAND_BATCH, std::string(sizeof(pabb_MsgCommandBatch), 0));
+    }
+    if (m_batch.body.size() + sizeof(pabb_MsgCommandBatchEntry) + params > m_max_batch_size){
+        return false;
     }
 
-    m_send_seq = seqnum + 1;
+    pabb_MsgCommandBatchEntry entry;
+    entry.type = message.type;
+    entry.length = (uint8_t)params;
+    m_batch.body.append((const char*)&entry, sizeof(entry));
+    m_batch.body.append(message.body, sizeof(seqnum_t), params);
+    m_batch_commands++;
+    return true;
+}
+void PABotBase::flush_batch(size_t queue_limit){
+    m_sanitizer.check_usage();
 
-    PendingCommand& handle = ret.first->second;
+    //  Must be called under m_state_lock.
 
-    handle.silent_remove = silent_remove;
-    handle.request = std::move(message);
-    handle.first_sent = current_time();
+    if (m_batch_commands == 0 || !command_slot_available(queue_limit, false)){
+        return;
+    }
+    if (m_state.load(std::memory_order_acquire) != State::RUNNING){
+        return;
+    }
+    send_command(std::move(m_batch), true);
+    m_batch = BotBaseMessage();
+    m_batch_commands = 0;
+}
+void PABotBase::on_rtt_sample(WallClock::duration rtt){
+    m_sanitizer.check_usage();
 
-    send_message(handle.request, false);
+    //  Must be called under m_state_lock.
+
+    if (!m_adaptive_retransmit){
+        return;
+    }
+
+    //  Same estimator as TCP. (RFC 6298)
+    if (m_srtt == WallClock::duration::zero()){
+        m_srtt = rtt;
+        m_rttvar = rtt / 2;
+    }else{
+        WallClock::duration error = m_srtt > rtt ? m_srtt - rtt : rtt - m_srtt;
+        m_rttvar = (3 * m_rttvar + error) / 4;
+        m_srtt = (7 * m_srtt + rtt) / 8;
+    }
 
-    return seqnum;
+    std::chrono::milliseconds delay = std::chrono::duration_cast<std::chrono::milliseconds>(m_srtt + 4 * m_rttvar);
+    delay = std::max(delay, std::chrono::milliseconds(PABB_MIN_RETRANSMIT_DELAY_MILLIS));
+    delay = std::min(delay, std::chrono::milliseconds(PABB_MAX_RETRANSMIT_DELAY_MILLIS));
+    m_retransmit_delay.store(delay, std::memory_order_relaxed);
 }
 uint64_t PABotBase::issue_request(
     const Cancellable* cancelled,
@@ -664,17 +885,17 @@ uint64_t PABotBase::issue_request(
     //  ack (for a request) or a finish (for a command) is received.
     //
     //  If (silent_remove = true), the receiving thread will remove the request
-    //  from the map and do nothing else. This is for async commands.
+    //  from the table and do nothing else. This is for async commands.
     //
     //  If (silent_remove = false), the receiving thread will not remove the
     //  request. Instead, it will notify whatever thread is waiting for the
     //  result. That waiting thread will process the return value (if any) and
-    //  remove the request from the map. This is for synchronous commands where
+    //  remove the request from the table. This is for synchronous commands where
     //  the function waits for the command to finish before returning.
     //
 
     while (true){
-        uint64_t seqnum = try_issue_request(cancelled, request, silent_remove, MAX_PENDING_REQUESTS);
+        uint64_t seqnum = try_issue_request(cancelled, request, silent_remove, m_max_pending_requests);
         if (seqnum != 0){
             return seqnum;
         }
@@ -706,17 +927,17 @@ uint64_t PABotBase::issue_command(
     //  ack (for a request) or a finish (for a command) is received.
     //
     //  If (silent_remove = true), the receiving thread will remove the request
-    //  from the map and do nothing else. This is for async commands.
+    //  from the table and do nothing else. This is for async commands.
     //
     //  If (silent_remove = false), the receiving thread will not remove the
     //  request. Instead, it will notify whatever thread is waiting for the
     //  result. That waiting thread will process the return value (if any) and
-    //  remove the request from the map. This is for synchronous commands where
+    //  remove the request from the table. This is for synchronous commands where
     //  the function waits for the command to finish before returning.
     //
 
     while (true){
-        uint64_t seqnum = try_issue_command(cancelled, request, silent_remove, MAX_PENDING_REQUESTS);
+        uint64_t seqnum = try_issue_command(cancelled, request, silent_remove, m_max_pending_requests);
         if (seqnum != 0){
             return seqnum;
         }
@@ -741,9 +962,9 @@ bool PABotBase::try_issue_request(
     m_sanitizer.check_usage();
 
     if (!request.is_command()){
-        return try_issue_request(cancelled, request, true, MAX_PENDING_REQUESTS) != 0;
+        return try_issue_request(cancelled, request, true, m_max_pending_requests) != 0;
     }else{
-        return try_issue_command(cancelled, request, true, MAX_PENDING_REQUESTS) != 0;
+        return try_issue_command(cancelled, request, true, m_max_pending_requests) != 0;
     }
 }
 void PABotBase::issue_request(
@@ -779,26 +1000,25 @@ BotBaseMessage PABotBase::wait_for_request(uint64_t seqnum){
     while (true){
         {
             SpinLockGuard slg(m_state_lock, "PABotBase::issue_request_and_wait()");
-            auto iter = m_pending_requests.find(seqnum);
-            if (iter == m_pending_requests.end()){
+            PendingMessage* entry = find_pending(seqnum);
+            if (entry == nullptr){
                 throw OperationCancelledException();
             }
-            iter->second.sanitizer.check_usage();
 
             State state = m_state.load(std::memory_order_acquire);
             if (state != State::RUNNING){
-                m_pending_requests.erase(iter);
+                remove_pending(*entry);
                 m_cv.notify_all();
                 throw InvalidConnectionStateException();
             }
             if (m_error.load(std::memory_order_acquire)){
-                m_pending_requests.erase(iter);
+                remove_pending(*entry);
                 m_cv.notify_all();
                 throw ConnectionException(&m_logger, "Serial connection was interrupted.");
             }
-            if (iter->second.state == AckState::ACKED){
-                BotBaseMessage ret = std::move(iter->second.ack);
-                m_pending_requests.erase(iter);
+            if (entry->state == AckState::ACKED){
+                BotBaseMessage ret = std::move(entry->ack);
+                remove_pending(*entry);
                 m_cv.notify_all();
                 return ret;
             }
@@ -25,7 +25,7 @@
 #define PokemonAutomation_PABotBase_H
 
 #include <string.h>
-#include <map>
+#include <vector>
 #include <atomic>
 #include <condition_variable>
 #include <thread>
@@ -41,8 +41,25 @@ namespace PokemonAutomation{
 
 
 class PABotBase : public BotBase, private PABotBaseConnection{
-    static const size_t MAX_PENDING_REQUESTS = PABB_DEVICE_QUEUE_SIZE;
-    static const seqnum_t MAX_SEQNUM_GAP = (seqnum_t)-1 >> 2;
+    //  Size of the pending table. The newest live seqnum is never more than
+    //  this many ahead of the oldest one. This must be a power-of-two that
+    //  divides 2^32 so that the 32-bit seqnum on the wire is enough to find
+    //  the slot.
+    static const size_t PENDING_WINDOW = 128;
+
+    //  Requests still get sent while a long-running command holds the oldest
+    //  seqnum, so the window can fill up behind it. Everything except stop
+    //  and interrupt requests stops this many slots short of the window so
+    //  that those can always get through and clear the queue.
+    //
+    //  Normal traffic needs at most 2 * PABB_MAX_DEVICE_QUEUE_SIZE slots.
+    //  (the command queue plus the unacked requests)
+    static const size_t PENDING_RESERVED = 16;
+
+    //  Retransmit timer wheel. A full rotation covers 640ms. Timers that are
+    //  further out than that stay in their bucket for more than one rotation.
+    static const size_t TIMER_WHEEL_SLOTS = 64;
+    static const int TIMER_TICK_MILLIS = 10;
 
 public:
     PABotBase(
@@ -58,6 +75,18 @@ public:
     void connect();
     void stop();
 
+    //  Turn on the pipelining extension. Only call this if the device's
+    //  protocol version is at least PABB_PROTOCOL_VERSION_PIPELINE.
+    //
+    //  This allows "queue_size" commands in flight, packs commands into
+    //  batches of up to "max_batch_size" bytes when the device queue is full,
+    //  and adapts the retransmit delay to the measured ack round-trip time.
+    void enable_pipelining(size_t queue_size, size_t max_batch_size);
+
+    std::chrono::milliseconds retransmit_delay() const{
+        return m_retransmit_delay.load(std::memory_order_relaxed);
+    }
+
     std::chrono::time_point<std::chrono::system_clock> last_ack() const{
         return m_last_ack.load(std::memory_order_acquire);
     }
@@ -95,27 +124,47 @@ private:
         ACKED,
         FINISHED,
     };
-    struct PendingRequest{
-        AckState state = AckState::NOT_ACKED;
-        bool silent_remove;
-        BotBaseMessage request;
-        BotBaseMessage ack;
-        WallClock first_sent;
-        LifetimeSanitizer sanitizer;
-    };
-    struct PendingCommand{
+    //  Requests and commands share the seqnum space. So they share the table.
+    struct PendingMessage{
+        uint64_t seqnum = 0;    //  Zero if the slot is free.
+        bool is_command = false;
         AckState state = AckState::NOT_ACKED;
-        bool silent_remove;
+        bool silent_remove = false;
+        bool retransmitted = false;
         BotBaseMessage request;
         BotBaseMessage ack;
         WallClock first_sent;
+
+        //  Retransmit timer. Linked into m_timer_wheel while not acked.
+        bool timer_armed = false;
+        size_t timer_slot = 0;
+        WallClock deadline;
+        PendingMessage* timer_prev = nullptr;
+        PendingMessage* timer_next = nullptr;
+
         LifetimeSanitizer sanitizer;
     };
 
-    template <typename Map>
-    uint64_t infer_full_seqnum(const Map& map, seqnum_t seqnum) const;
+    //  All of these must be called under m_state_lock.
+
+    //  Find the live entry for a seqnum. Returns null if there isn't one.
+    PendingMessage* find_pending(seqnum_t seqnum);
+    PendingMessage* find_pending(uint64_t seqnum);
+
+    PendingMessage& add_pending(bool is_command, BotBaseMessage message, bool silent_remove);
+    void mark_acked(PendingMessage& entry);
+    void remove_pending(PendingMessage& entry);
+
+    uint64_t oldest_live_seqnum();
+
+    //  Returns true if the next seqnum is still within the window.
+    //  "urgent" messages may use the reserved slots.
+    bool window_available(bool urgent);
 
-    uint64_t oldest_live_seqnum() const;
+    uint64_t timer_tick(WallClock time) const;
+    void arm_timer(PendingMessage& entry, WallClock deadline);
+    void disarm_timer(PendingMessage& entry);
+    void process_timers(WallClock now, std::chrono::milliseconds retransmit_delay);
 
     template <typename Params> void process_ack_request(BotBaseMessage message);
     template <typename Params> void process_ack_command(BotBaseMessage message);
@@ -125,12 +174,32 @@ private:
 
     void clear_all_active_commands(uint64_t seqnum);
 
+    //  Update the retransmit delay with an ack that came back "rtt" after
+    //  the message was first sent. (not retransmitted)
+    void on_rtt_sample(WallClock::duration rtt);
+
     void retransmit_thread();
 
 private:
     size_t inflight_requests();
 
+    //  Must be called under m_state_lock.
+    bool command_slot_available(size_t queue_limit, bool log_throttle);
+    uint64_t send_command(BotBaseMessage message, bool silent_remove);
+
+    //  Append a command to the open batch. Returns false if it doesn't fit.
+    bool append_to_batch(const BotBaseMessage& message);
+
+    //  Send the open batch if there is room for it.
+    void flush_batch(size_t queue_limit);
+
+    //  Returned by try_issue_command() when the command was packed into the
+    //  open batch. It has no seqnum until the batch is sent. Live seqnums
+    //  never get this high.
+    static const uint64_t SEQNUM_BATCHED = ~(uint64_t)0;
+
     //  Returns the seqnum of the request. If failed, returns zero.
+    //  try_issue_command() may also return SEQNUM_BATCHED.
     uint64_t try_issue_request(
         const Cancellable* cancelled,
         const BotBaseRequest& request, bool silent_remove,
@@ -142,7 +211,7 @@ private:
         size_t queue_limit
     );
 
-    //  Returns the seqnum of the request.
+    //  Returns the seqnum of the request, or SEQNUM_BATCHED for a command.
     uint64_t issue_request(
         const Cancellable* cancelled,
         const BotBaseRequest& request, bool silent_remove
@@ -171,11 +240,35 @@ private:
     Logger& m_logger;
 
     uint64_t m_send_seq;
-    std::chrono::milliseconds m_retransmit_delay;
+    std::atomic<std::chrono::milliseconds> m_retransmit_delay;
     std::atomic<std::chrono::time_point<std::chrono::system_clock>> m_last_ack;
 
-    std::map<uint64_t, PendingRequest> m_pending_requests;
-    std::map<uint64_t, PendingCommand> m_pending_commands;
+    std::atomic<size_t> m_max_pending_requests;
+
+    //  Pipelining extension. (under m_state_lock)
+    size_t m_max_batch_size;        //  Zero if batching is disabled.
+    bool m_adaptive_retransmit;
+    WallClock::duration m_srtt;     //  Smoothed ack round-trip time.
+    WallClock::duration m_rttvar;   //  Round-trip time variation.
+
+    //  Commands waiting for a free device queue slot, packed into a single
+    //  PABB_MSG_COMMAND_BATCH. Not sent yet and has no seqnum yet.
+    BotBaseMessage m_batch;
+    size_t m_batch_commands;
+
+    //  Pending requests and commands, indexed by seqnum % PENDING_WINDOW.
+    //  (under m_state_lock)
+    std::vector<PendingMessage> m_pending;
+    uint64_t m_oldest_seqnum;
+    size_t m_pending_requests;
+    size_t m_pending_commands;
+    size_t m_unacked_commands;
+
+    //  Unacked entries, bucketed by retransmit deadline. (under m_state_lock)
+    const WallClock m_timer_epoch;
+    PendingMessage* m_timer_wheel[TIMER_WHEEL_SLOTS];
+    uint64_t m_timer_cursor;    //  The next tick to process.
+    size_t m_timers_armed;
 
     //  If you need both locks, always acquire m_sleep_lock first!
     SpinLock m_state_lock;
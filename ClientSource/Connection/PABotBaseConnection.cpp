@@ -67,7 +67,10 @@ void PABotBaseConnection::send_message(const BotBaseMessage& message, bool is_re
     m_sniffer->on_send(message, is_retransmit);
 
     size_t total_bytes = PABB_PROTOCOL_OVERHEAD + message.body.size();
-    if (total_bytes > PABB_MAX_PACKET_SIZE){
+    size_t max_bytes = message.type == PABB_MSG_COMMAND_BATCH
+        ? PABB_MAX_BATCH_PACKET_SIZE
+        : PABB_MAX_PACKET_SIZE;
+    if (total_bytes > max_bytes){
         throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too long.");
     }
 
@@ -277,6 +277,17 @@ int register_message_converters_framework_requests(){
             return ss.str();
         }
     );
+    register_message_converter(
+        PABB_MSG_REQUEST_PIPELINE_INFO,
+        [](const std::string& body){
+            std::ostringstream ss;
+            ss << "PABB_MSG_REQUEST_PIPELINE_INFO - ";
+            if (body.size() != sizeof(pabb_MsgRequestPipelineInfo)){ ss << "(invalid size)" << std::endl; return ss.str(); }
+            const auto* params = (const pabb_MsgRequestPipelineInfo*)body.c_str();
+            ss << "seqnum = " << (uint64_t)params->seqnum;
+            return ss.str();
+        }
+    );
     register_message_converter(
         PABB_MSG_COMMAND_END_PROGRAM_CALLBACK,
         [](const std::string& body){
@@ -300,6 +311,26 @@ int register_message_converters_framework_requests(){
             return ss.str();
         }
     );
+    register_message_converter(
+        PABB_MSG_COMMAND_BATCH,
+        [](const std::string& body){
+            std::ostringstream ss;
+            ss << "PABB_MSG_COMMAND_BATCH - ";
+            if (body.size() < sizeof(pabb_MsgCommandBatch)){ ss << "(invalid size)" << std::endl; return ss.str(); }
+            const auto* params = (const pabb_MsgCommandBatch*)body.c_str();
+            ss << "seqnum = " << (uint64_t)params->seqnum;
+            size_t index = sizeof(pabb_MsgCommandBatch);
+            while (index + sizeof(pabb_MsgCommandBatchEntry) <= body.size()){
+                const auto* entry = (const pabb_MsgCommandBatchEntry*)(body.c_str() + index);
+                ss << ", 0x" << std::hex << (unsigned)entry->type << std::dec;
+                index += sizeof(pabb_MsgCommandBatchEntry) + entry->length;
+            }
+            if (index != body.size()){
+                ss << " (invalid size)";
+            }
+            return ss.str();
+        }
+    );
     return 0;
 }
 int register_message_converters_custom_info(){
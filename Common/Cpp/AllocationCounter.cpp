@@ -0,0 +1,40 @@
+/*  Allocation Counter
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Replace the global allocator so that "new" is counted. The array,
+ *  nothrow and sized forms all forward to these by default.
+ *
+ */
+
+#include <stdlib.h>
+#include <new>
+#include "AllocationCounter.h"
+
+
+void* operator new(size_t bytes){
+    PokemonAutomation::AllocationCounter::record(bytes);
+    if (bytes == 0){
+        bytes = 1;
+    }
+    while (true){
+        void* ptr = malloc(bytes);
+        if (ptr != nullptr){
+            return ptr;
+        }
+
+        //  Same as the default allocator. Give the new-handler a chance to
+        //  free up memory before giving up.
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr){
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+void operator delete(void* ptr) noexcept{
+    free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept{
+    free(ptr);
+}
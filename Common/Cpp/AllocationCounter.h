@@ -0,0 +1,81 @@
+/*  Allocation Counter
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Count heap allocations. This is used by the benchmarks to see how much
+ *  memory an inference routine allocates.
+ *
+ *  This covers "operator new" and "aligned_malloc()". Counting is off by
+ *  default. When it's off, each allocation only pays for a relaxed load.
+ *
+ *  This header is all that's needed to record allocations. The replacement
+ *  of "operator new" is in AllocationCounter.cpp. It is not part of the
+ *  normal build. Build with the CMake option PA_COUNT_ALLOCATIONS (qmake:
+ *  CONFIG+=pa_count_allocations) to link it in. Programs that don't link it
+ *  only count "aligned_malloc()".
+ *
+ */
+
+#ifndef PokemonAutomation_AllocationCounter_H
+#define PokemonAutomation_AllocationCounter_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+namespace PokemonAutomation{
+
+
+struct AllocationStats{
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+
+class AllocationCounter{
+public:
+    static void set_enabled(bool enabled){
+        counters().enabled.store(enabled, std::memory_order_relaxed);
+    }
+    static bool enabled(){
+        return counters().enabled.load(std::memory_order_relaxed);
+    }
+
+    static void record(size_t bytes){
+        if (!enabled()){
+            return;
+        }
+        Counters& state = counters();
+        state.allocations.fetch_add(1, std::memory_order_relaxed);
+        state.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    //  Totals since the start of the program. Take the difference of two of
+    //  these to get the allocations in between.
+    static AllocationStats current(){
+        AllocationStats ret;
+        const Counters& state = counters();
+        ret.allocations = state.allocations.load(std::memory_order_relaxed);
+        ret.bytes = state.bytes.load(std::memory_order_relaxed);
+        return ret;
+    }
+
+private:
+    struct Counters{
+        std::atomic<bool> enabled{false};
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+
+    //  Constant-initialized. So there is no guard on access and it is usable
+    //  by allocations that happen before the static initializers run.
+    static Counters& counters(){
+        static Counters state;
+        return state;
+    }
+};
+
+
+
+}
+#endif
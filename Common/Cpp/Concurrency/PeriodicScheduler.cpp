@@ -77,6 +77,47 @@ void* PeriodicScheduler::request_next_event(WallClock timestamp){
         return event.event;
     }
 }
+void PeriodicScheduler::request_all_due_events(std::vector<void*>& events, WallClock timestamp){
+    events.clear();
+
+    //  Find everything that's due first. Otherwise an event that gets
+    //  rescheduled to exactly "timestamp" will be returned again.
+    using ScheduleIter = std::multimap<WallClock, SingleEvent>::iterator;
+    auto end = m_schedule.upper_bound(timestamp);
+    std::vector<ScheduleIter> due;
+    for (auto iter = m_schedule.begin(); iter != end; ++iter){
+        due.emplace_back(iter);
+    }
+    std::vector<ScheduleIter> added;
+    added.reserve(due.size());
+    events.reserve(due.size());
+
+    //  Schedule the next events first so that we retain strong exception
+    //  safety if it throws.
+    try{
+        for (ScheduleIter item : due){
+            //  Current SingleEvent refers to a no longer existing PeriodicEvent.
+            auto iter = m_events.find(item->second.event);
+            if (iter == m_events.end() || item->second.id != iter->second.id){
+                continue;
+            }
+            WallClock next = std::max(item->first + iter->second.period, timestamp);
+            added.emplace_back(m_schedule.emplace(next, item->second));
+            events.emplace_back(item->second.event);
+        }
+    }catch (...){
+        for (ScheduleIter item : added){
+            m_schedule.erase(item);
+        }
+        events.clear();
+        throw;
+    }
+
+    //  Now remove the current events.
+    for (ScheduleIter item : due){
+        m_schedule.erase(item);
+    }
+}
 
 
 
@@ -169,13 +210,24 @@ void PeriodicRunner::thread_loop(){
         idle_since_last_check = WallClock::duration(0);
 //        cout << m_utilization.utilization() << endl;
 
-        void* event = m_scheduler.request_next_event(now);
+        if (batch_events()){
+            m_scheduler.request_all_due_events(m_ready, now);
 
-        //  Event is available now. Run it.
-        if (event != nullptr){
-            run(event, is_back_to_back);
-            is_back_to_back = true;
-            continue;
+            //  Events are available now. Run them.
+            if (!m_ready.empty()){
+                run_batch(m_ready, is_back_to_back);
+                is_back_to_back = true;
+                continue;
+            }
+        }else{
+            void* event = m_scheduler.request_next_event(now);
+
+            //  Event is available now. Run it.
+            if (event != nullptr){
+                run(event, is_back_to_back);
+                is_back_to_back = true;
+                continue;
+            }
         }
         is_back_to_back = false;
 
@@ -196,6 +248,15 @@ void PeriodicRunner::thread_loop(){
         idle_since_last_check += end - start;
     }
 }
+void PeriodicRunner::run_batch(const std::vector<void*>& events, bool is_back_to_back) noexcept{
+    for (void* event : events){
+        if (cancelled()){
+            return;
+        }
+        run(event, is_back_to_back);
+        is_back_to_back = true;
+    }
+}
 void PeriodicRunner::stop_thread(){
     PeriodicRunner::cancel(nullptr);
     m_runner.reset();
@@ -10,6 +10,7 @@
 #define PokemonAutomation_PeriodicScheduler_H
 
 #include <chrono>
+#include <vector>
 #include <map>
 #include <mutex>
 #include <condition_variable>
@@ -41,6 +42,11 @@ public:
     //  If nothing is before the current timestamp, return nullptr.
     void* request_next_event(WallClock timestamp = current_time());
 
+    //  Same as above, but return every event that is before the current
+    //  timestamp. Each event is returned at most once and is rescheduled for
+    //  its next period.
+    void request_all_due_events(std::vector<void*>& events, WallClock timestamp = current_time());
+
 private:
     //  "id" is needed to solve the ABA problem if the same pointer is removed/re-added.
     struct PeriodicEvent{
@@ -84,6 +90,17 @@ protected:
     //  is too slow to keep up.
     virtual void run(void* event, bool is_back_to_back) noexcept = 0;
 
+    //  If this returns true, all the events that are due at the same time
+    //  are handed to "run_batch()" together. Otherwise they are run
+    //  one-by-one with "run()" and pending add/remove calls can get in
+    //  between them. This is checked before each batch.
+    virtual bool batch_events() const{ return false; }
+
+    //  Run all the events that are due at the same time. The default
+    //  implementation runs them one-by-one with "run()". Override this to
+    //  process them together. (e.g. on multiple threads)
+    virtual void run_batch(const std::vector<void*>& events, bool is_back_to_back) noexcept;
+
 private:
     void thread_loop();
 protected:
@@ -100,6 +117,7 @@ private:
     UtilizationTracker m_utilization;
 
     PeriodicScheduler m_scheduler;
+    std::vector<void*> m_ready;
 
     std::unique_ptr<AsyncTask> m_runner;
 };
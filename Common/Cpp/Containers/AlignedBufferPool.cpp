@@ -0,0 +1,129 @@
+/*  Aligned Buffer Pool
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Compiler.h"
+#include "AlignedMalloc.h"
+#include "AlignedBufferPool.h"
+
+namespace PokemonAutomation{
+
+
+AlignedBufferPool& AlignedBufferPool::instance(){
+    //  Intentionally leaked so that buffers owned by other statics can still
+    //  be returned during shutdown.
+    static AlignedBufferPool& pool = *new AlignedBufferPool();
+    return pool;
+}
+
+AlignedBufferPool::~AlignedBufferPool(){
+    clear();
+}
+AlignedBufferPool::AlignedBufferPool(size_t max_cached_bytes)
+    : m_max_cached_bytes(max_cached_bytes)
+{}
+
+size_t AlignedBufferPool::round_up(size_t bytes){
+    if (bytes < MIN_POOLED_BYTES){
+        return (bytes + PA_ALIGNMENT - 1) & ~(size_t)(PA_ALIGNMENT - 1);
+    }
+
+    //  4 classes per power of two. A 1920x1080 RGB32 frame lands in 8 MiB.
+    size_t top = 1;
+    while ((top << 1) <= bytes - 1){
+        top <<= 1;
+    }
+    size_t step = top >> 2;
+    return (bytes + step - 1) & ~(step - 1);
+}
+
+
+void* AlignedBufferPool::allocate(size_t bytes, size_t& capacity){
+    capacity = round_up(bytes);
+    if (capacity >= MIN_POOLED_BYTES){
+        SpinLockGuard lg(m_lock, "AlignedBufferPool::allocate()");
+        auto iter = m_free.find(capacity);
+        if (iter != m_free.end() && !iter->second.empty()){
+            void* ptr = iter->second.back();
+            iter->second.pop_back();
+            m_cached_bytes -= capacity;
+            m_hits++;
+            return ptr;
+        }
+        m_misses++;
+    }
+    return aligned_malloc(capacity, PA_ALIGNMENT);
+}
+void AlignedBufferPool::release(void* ptr, size_t capacity) noexcept{
+    if (ptr == nullptr){
+        return;
+    }
+    if (capacity >= MIN_POOLED_BYTES){
+        try{
+            SpinLockGuard lg(m_lock, "AlignedBufferPool::release()");
+            if (m_cached_bytes + capacity <= m_max_cached_bytes){
+                m_free[capacity].emplace_back(ptr);
+                m_cached_bytes += capacity;
+                return;
+            }
+        }catch (...){}
+    }
+    aligned_free(ptr);
+}
+
+
+void AlignedBufferPool::clear(){
+    std::map<size_t, std::vector<void*>> free;
+    {
+        SpinLockGuard lg(m_lock, "AlignedBufferPool::clear()");
+        free = std::move(m_free);
+        m_free.clear();
+        m_cached_bytes = 0;
+    }
+    for (auto& item : free){
+        for (void* ptr : item.second){
+            aligned_free(ptr);
+        }
+    }
+}
+
+AlignedBufferPool::Stats AlignedBufferPool::stats() const{
+    SpinLockGuard lg(m_lock, "AlignedBufferPool::stats()");
+    Stats ret;
+    ret.hits = m_hits;
+    ret.misses = m_misses;
+    ret.cached_bytes = m_cached_bytes;
+    return ret;
+}
+
+
+
+PooledBuffer::~PooledBuffer(){
+    AlignedBufferPool::instance().release(m_ptr, m_capacity);
+}
+PooledBuffer::PooledBuffer(PooledBuffer&& x) noexcept
+    : m_ptr(x.m_ptr)
+    , m_capacity(x.m_capacity)
+{
+    x.m_ptr = nullptr;
+    x.m_capacity = 0;
+}
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& x) noexcept{
+    if (this != &x){
+        AlignedBufferPool::instance().release(m_ptr, m_capacity);
+        m_ptr = x.m_ptr;
+        m_capacity = x.m_capacity;
+        x.m_ptr = nullptr;
+        x.m_capacity = 0;
+    }
+    return *this;
+}
+PooledBuffer::PooledBuffer(size_t bytes){
+    m_ptr = AlignedBufferPool::instance().allocate(bytes, m_capacity);
+}
+
+
+
+}
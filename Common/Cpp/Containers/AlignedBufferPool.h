@@ -0,0 +1,98 @@
+/*  Aligned Buffer Pool
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A process-wide cache of large aligned buffers.
+ *
+ *  Video frames and the images derived from them are multi-megabyte buffers
+ *  that get allocated and freed many times per second. Instead of going back
+ *  to the heap (and the OS) every time, freed buffers are kept here and
+ *  handed out again to the next request of the same size class.
+ *
+ *  Requests are rounded up to one of 4 size classes per power of two.
+ *  Small requests are not worth pooling and go straight to aligned_malloc().
+ *
+ */
+
+#ifndef PokemonAutomation_AlignedBufferPool_H
+#define PokemonAutomation_AlignedBufferPool_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <vector>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+
+namespace PokemonAutomation{
+
+
+class AlignedBufferPool{
+public:
+    static const size_t MIN_POOLED_BYTES = (size_t)64 << 10;
+    static const size_t DEFAULT_LIMIT = (size_t)256 << 20;
+
+    static AlignedBufferPool& instance();
+
+    struct Stats{
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t cached_bytes = 0;
+    };
+
+public:
+    ~AlignedBufferPool();
+    AlignedBufferPool(size_t max_cached_bytes = DEFAULT_LIMIT);
+
+    //  Returns a buffer of at least "bytes" bytes aligned to PA_ALIGNMENT.
+    //  "capacity" is set to the actual size of the buffer which must be
+    //  passed back to "release()". The contents are uninitialized.
+    void* allocate(size_t bytes, size_t& capacity);
+
+    //  Return a buffer obtained from "allocate()".
+    void release(void* ptr, size_t capacity) noexcept;
+
+    //  Free everything that isn't in use.
+    void clear();
+
+    Stats stats() const;
+
+private:
+    static size_t round_up(size_t bytes);
+
+private:
+    mutable SpinLock m_lock;
+    const size_t m_max_cached_bytes;
+    size_t m_cached_bytes = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    std::map<size_t, std::vector<void*>> m_free;
+};
+
+
+
+//  Owning handle to a buffer from the global AlignedBufferPool.
+class PooledBuffer{
+public:
+    ~PooledBuffer();
+    PooledBuffer(PooledBuffer&& x) noexcept;
+    PooledBuffer& operator=(PooledBuffer&& x) noexcept;
+    PooledBuffer(const PooledBuffer&) = delete;
+    void operator=(const PooledBuffer&) = delete;
+
+public:
+    PooledBuffer() = default;
+    PooledBuffer(size_t bytes);
+
+    size_t capacity() const{ return m_capacity; }
+    const void* data() const{ return m_ptr; }
+          void* data()      { return m_ptr; }
+
+private:
+    void* m_ptr = nullptr;
+    size_t m_capacity = 0;
+};
+
+
+
+}
+#endif
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <new>
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/AllocationCounter.h"
 #include "AlignedMalloc.h"
 
 #define PA_ENABLE_MALLOC_CHECKING
@@ -32,6 +33,8 @@ void* aligned_malloc(size_t bytes, size_t alignment){
     }
 #endif
 
+    AllocationCounter::record(bytes);
+
     size_t actual_bytes = bytes + alignment + sizeof(size_t)*4;
     void* free_ptr = malloc(actual_bytes);
     if (free_ptr == nullptr){
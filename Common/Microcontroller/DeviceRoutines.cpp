@@ -31,6 +31,14 @@ uint8_t program_id(BotBase& botbase){
     ).convert<PABB_MSG_ACK_REQUEST_I8>(botbase.logger(), response);
     return response.data;
 }
+void pipeline_info(BotBase& botbase, size_t& queue_size, size_t& max_batch_size){
+    pabb_MsgAckRequestI16 response;
+    botbase.issue_request_and_wait(
+        DeviceRequest_pipeline_info()
+    ).convert<PABB_MSG_ACK_REQUEST_I16>(botbase.logger(), response);
+    queue_size = response.data & 0xff;
+    max_batch_size = response.data >> 8;
+}
 
 
 }
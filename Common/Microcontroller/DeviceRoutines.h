@@ -18,6 +18,9 @@ uint32_t protocol_version(BotBase& botbase);
 uint32_t program_version(BotBase& botbase);
 uint8_t program_id(BotBase& botbase);
 
+//  Requires PABB_PROTOCOL_VERSION_PIPELINE.
+void pipeline_info(BotBase& botbase, size_t& queue_size, size_t& max_batch_size);
+
 
 class DeviceRequest_seqnum_reset : public BotBaseRequest{
 public:
@@ -79,6 +82,16 @@ public:
         return BotBaseMessage(PABB_MSG_REQUEST_PROGRAM_ID, params);
     }
 };
+class DeviceRequest_pipeline_info : public BotBaseRequest{
+public:
+    pabb_MsgRequestPipelineInfo params;
+    DeviceRequest_pipeline_info()
+        : BotBaseRequest(false)
+    {}
+    virtual BotBaseMessage message() const override{
+        return BotBaseMessage(PABB_MSG_REQUEST_PIPELINE_INFO, params);
+    }
+};
 
 
 
@@ -117,6 +117,30 @@
  *      -   PABotBase can still handle other messages while it is running a long
  *          command.
  * 
+ * 
+ *  Pipelining Extension: (PABB_PROTOCOL_VERSION_PIPELINE)
+ * 
+ *      Devices at or above this protocol version support the following. Older
+ *  devices never see any of it since the client only uses it after it has
+ *  checked the protocol version. No firmware in this tree implements it yet,
+ *  so the client only negotiates it when SERIAL_PIPELINING is turned on in
+ *  the debug settings.
+ * 
+ *      -   PABB_MSG_REQUEST_PIPELINE_INFO returns the size of the device's
+ *          command queue and the largest batch message it accepts. The client
+ *          may keep that many commands in flight instead of
+ *          PABB_DEVICE_QUEUE_SIZE.
+ * 
+ *      -   PABB_MSG_COMMAND_BATCH packs several commands into one message.
+ *          It takes a single seqnum and a single slot in the command queue.
+ *          The device runs the commands in order. It acks the batch as one
+ *          command and sends one PABB_MSG_REQUEST_COMMAND_FINISHED once the
+ *          last of them is done.
+ * 
+ *      -   The client derives the retransmit delay from the measured ack
+ *          round-trip time instead of using PABB_RETRANSMIT_DELAY_MILLIS.
+ *          This is entirely client-side.
+ * 
  */
 
 #ifndef PokemonAutomation_MessageProtocol_H
@@ -155,6 +179,9 @@
 //
 #define PABB_PROTOCOL_VERSION           2021052612
 
+//  Lowest device protocol version that supports the pipelining extension.
+#define PABB_PROTOCOL_VERSION_PIPELINE  2021052613
+
 //  Program versioning doesn't matter. It's just for informational purposes.
 #define PABB_PROGRAM_VERSION            2022120800
 
@@ -165,6 +192,16 @@
 #define PABB_PROTOCOL_OVERHEAD          (2 + sizeof(uint32_t))
 #define PABB_MAX_PACKET_SIZE            (PABB_MAX_MESSAGE_SIZE + PABB_PROTOCOL_OVERHEAD)
 
+//  Pipelining extension limits. The device reports its actual limits which
+//  may be smaller.
+#define PABB_MAX_DEVICE_QUEUE_SIZE      32  //  Must be a power-of-two.
+#define PABB_MAX_BATCH_MESSAGE_SIZE     64
+#define PABB_MAX_BATCH_PACKET_SIZE      (PABB_MAX_BATCH_MESSAGE_SIZE + PABB_PROTOCOL_OVERHEAD)
+
+//  Bounds for the adaptive retransmit delay.
+#define PABB_MIN_RETRANSMIT_DELAY_MILLIS    20
+#define PABB_MAX_RETRANSMIT_DELAY_MILLIS    320
+
 typedef uint32_t seqnum_t;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -295,6 +332,15 @@ typedef struct{
     seqnum_t seqnum;
 } PABB_PACK pabb_MsgRequestNextCmdInterrupt;
 
+#define PABB_MSG_REQUEST_PIPELINE_INFO          0x48
+//  Requires PABB_PROTOCOL_VERSION_PIPELINE.
+//  Responds with PABB_MSG_ACK_REQUEST_I16:
+//      bits 0-7:   Command queue size. (power-of-two, <= PABB_MAX_DEVICE_QUEUE_SIZE)
+//      bits 8-15:  Max size of a PABB_MSG_COMMAND_BATCH message. (<= PABB_MAX_BATCH_MESSAGE_SIZE)
+typedef struct{
+    seqnum_t seqnum;
+} PABB_PACK pabb_MsgRequestPipelineInfo;
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Custom Info
 
@@ -318,6 +364,20 @@ typedef struct{
     bool on;
 } PABB_PACK pabb_MsgCommandSetLeds;
 
+#define PABB_MSG_COMMAND_BATCH                  0x82
+//  Requires PABB_PROTOCOL_VERSION_PIPELINE.
+//  The seqnum is followed by one or more entries. Each entry is:
+//      uint8_t     type of the command
+//      uint8_t     size of the command's parameters
+//      ...         the command's parameters without its seqnum
+typedef struct{
+    seqnum_t seqnum;
+} PABB_PACK pabb_MsgCommandBatch;
+typedef struct{
+    uint8_t type;
+    uint8_t length;
+} PABB_PACK pabb_MsgCommandBatchEntry;
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
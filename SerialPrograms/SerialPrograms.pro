@@ -72,6 +72,7 @@ SOURCES += \
     ../ClientSource/Connection/PABotBaseConnection.cpp \
     ../ClientSource/Libraries/Logging.cpp \
     ../ClientSource/Libraries/MessageConverter.cpp \
+    ../Common/Cpp/Containers/AlignedBufferPool.cpp \
     ../Common/CRC32.cpp \
     ../Common/Cpp/CancellableScope.cpp \
     ../Common/Cpp/Concurrency/AsyncDispatcher.cpp \
@@ -152,6 +153,7 @@ SOURCES += \
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.cpp \
+    Source/CommonFramework/AudioPipeline/Spectrum/SpectrumSlabPool.cpp \
     Source/CommonFramework/AudioPipeline/Tools/AudioFormatUtils.cpp \
     Source/CommonFramework/AudioPipeline/Tools/TimeSampleBuffer.cpp \
     Source/CommonFramework/AudioPipeline/Tools/TimeSampleBufferReader.cpp \
@@ -175,14 +177,18 @@ SOURCES += \
     Source/CommonFramework/ImageMatch/ImageMatchResult.cpp \
     Source/CommonFramework/ImageMatch/SilhouetteDictionaryMatcher.cpp \
     Source/CommonFramework/ImageMatch/SubObjectTemplateMatcher.cpp \
+    Source/CommonFramework/ImageMatch/ThumbnailIndex.cpp \
     Source/CommonFramework/ImageMatch/WaterfillTemplateMatcher.cpp \
+    Source/CommonFramework/ImageTools/BinaryImage_FilterHsv32.cpp \
     Source/CommonFramework/ImageTools/BinaryImage_FilterRgb32.cpp \
     Source/CommonFramework/ImageTools/ColorClustering.cpp \
     Source/CommonFramework/ImageTools/FloatPixel.cpp \
     Source/CommonFramework/ImageTools/ImageBoxes.cpp \
     Source/CommonFramework/ImageTools/ImageFilter.cpp \
     Source/CommonFramework/ImageTools/ImageGradient.cpp \
+    Source/CommonFramework/ImageTools/ImageIntegralCache.cpp \
     Source/CommonFramework/ImageTools/ImageManip.cpp \
+    Source/CommonFramework/ImageTools/ImageScaler.cpp \
     Source/CommonFramework/ImageTools/ImageStats.cpp \
     Source/CommonFramework/ImageTools/SolidColorTest.cpp \
     Source/CommonFramework/ImageTools/WaterfillUtilities.cpp \
@@ -194,6 +200,7 @@ SOURCES += \
     Source/CommonFramework/ImageTypes/ImageViewRGB32.cpp \
     Source/CommonFramework/Inference/AnomalyDetector.cpp \
     Source/CommonFramework/Inference/AudioPerSpectrumDetectorBase.cpp \
+    Source/CommonFramework/Inference/AudioTemplateBank.cpp \
     Source/CommonFramework/Inference/AudioTemplateCache.cpp \
     Source/CommonFramework/Inference/BlackBorderDetector.cpp \
     Source/CommonFramework/Inference/BlackScreenDetector.cpp \
@@ -218,11 +225,15 @@ SOURCES += \
     Source/CommonFramework/Notifications/MessageAttachment.cpp \
     Source/CommonFramework/Notifications/ProgramNotifications.cpp \
     Source/CommonFramework/Notifications/SenderNotificationTable.cpp \
+    Source/CommonFramework/OCR/OCR_DictionaryIndex.cpp \
     Source/CommonFramework/OCR/OCR_DictionaryMatcher.cpp \
     Source/CommonFramework/OCR/OCR_DictionaryOCR.cpp \
+    Source/CommonFramework/OCR/OCR_GlyphClassifier.cpp \
     Source/CommonFramework/OCR/OCR_LargeDictionaryMatcher.cpp \
+    Source/CommonFramework/OCR/OCR_LevenshteinScorer.cpp \
     Source/CommonFramework/OCR/OCR_NumberReader.cpp \
     Source/CommonFramework/OCR/OCR_RawOCR.cpp \
+    Source/CommonFramework/OCR/OCR_ResultCache.cpp \
     Source/CommonFramework/OCR/OCR_Routines.cpp \
     Source/CommonFramework/OCR/OCR_SmallDictionaryMatcher.cpp \
     Source/CommonFramework/OCR/OCR_StringMatchResult.cpp \
@@ -257,6 +268,7 @@ SOURCES += \
     Source/CommonFramework/Tools/DebugDumper.cpp \
     Source/CommonFramework/Tools/ErrorDumper.cpp \
     Source/CommonFramework/Tools/FileDownloader.cpp \
+    Source/CommonFramework/Tools/ImageEncoder.cpp \
     Source/CommonFramework/Tools/InterruptableCommands.cpp \
     Source/CommonFramework/Tools/MultiConsoleErrors.cpp \
     Source/CommonFramework/Tools/ProgramEnvironment.cpp \
@@ -267,7 +279,11 @@ SOURCES += \
     Source/CommonFramework/VideoPipeline/Backends/CameraImplementations.cpp \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt5.cpp \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.cpp \
+    Source/CommonFramework/VideoPipeline/Backends/CameraWidgetReplay.cpp \
+    Source/CommonFramework/VideoPipeline/Backends/VideoReplaySource.cpp \
     Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt5.cpp \
+    Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt6.cpp \
+    Source/CommonFramework/VideoPipeline/BufferPoolStats.cpp \
     Source/CommonFramework/VideoPipeline/CameraOption.cpp \
     Source/CommonFramework/VideoPipeline/ThreadUtilizationStats.cpp \
     Source/CommonFramework/VideoPipeline/UI/CameraSelectorWidget.cpp \
@@ -296,6 +312,7 @@ SOURCES += \
     Source/Kernels/AbsFFT/Kernels_AbsFFT.cpp \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_Default.cpp \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_x86_AVX2.cpp \
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_x86_AVX512.cpp \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Core_x86_SSE41.cpp \
     Source/Kernels/Algorithm/Kernels_Algorithm_DisjointSet.cpp \
     Source/Kernels/AudioStreamConversion/AudioStreamConversion.cpp \
@@ -316,17 +333,36 @@ SOURCES += \
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix_Core_x64_AVX2.cpp \
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix_Core_x64_AVX512.cpp \
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix_Core_x64_SSE42.cpp \
+    Source/Kernels/HammingDistance/Kernels_HammingDistance.cpp \
+    Source/Kernels/HammingDistance/Kernels_HammingDistance_Default.cpp \
+    Source/Kernels/HammingDistance/Kernels_HammingDistance_x64_AVX2.cpp \
+    Source/Kernels/HammingDistance/Kernels_HammingDistance_x64_SSE42.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_Default.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_AVX2.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_AVX512.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_SSE42.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_arm64_NEON.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_Default.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_AVX2.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_AVX512.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_SSE41.cpp \
+    Source/Kernels/ImageScale/Kernels_ImageScale.cpp \
+    Source/Kernels/ImageScale/Kernels_ImageScale_arm64_NEON.cpp \
+    Source/Kernels/ImageScale/Kernels_ImageScale_Default.cpp \
+    Source/Kernels/ImageScale/Kernels_ImageScale_x64_AVX2.cpp \
+    Source/Kernels/ImageScale/Kernels_ImageScale_x64_SSE41.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_Default.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_arm64_NEON.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_AVX2.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_AVX512.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_x64_SSE41.cpp \
+    Source/Kernels/ImageStats/Kernels_ImageIntegralSumSqr.cpp \
+    Source/Kernels/ImageStats/Kernels_ImageIntegralSumSqr_Default.cpp \
+    Source/Kernels/ImageStats/Kernels_ImageIntegralSumSqr_x64_AVX2.cpp \
+    Source/Kernels/ImageStats/Kernels_ImageIntegralSumSqr_x64_SSE41.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev_Default.cpp \
@@ -337,6 +373,10 @@ SOURCES += \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_AVX2.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_AVX512.cpp \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_SSE41.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDevScaled.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDevScaled_Default.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDevScaled_x64_AVX2.cpp \
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDevScaled_x64_SSE41.cpp \
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.cpp \
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Core_Default.cpp \
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Core_x86_AVX2.cpp \
@@ -347,6 +387,11 @@ SOURCES += \
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Core_x86_AVX2.cpp \
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Core_x86_AVX512.cpp \
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Core_x86_SSE41.cpp \
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion.cpp \
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_Default.cpp \
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_x64_AVX2.cpp \
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_x64_AVX512.cpp \
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_x64_SSE41.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x16_x64_AVX2.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x32_x64_AVX512-GF.cpp \
@@ -355,6 +400,7 @@ SOURCES += \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x64_x64_AVX512.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x8_x64_SSE42.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.cpp \
+    Source/Kernels/Waterfill/Kernels_Waterfill_Parallel.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Session.cpp \
     Source/NintendoSwitch/Commands/NintendoSwitch_Commands_Device.cpp \
     Source/NintendoSwitch/Commands/NintendoSwitch_Commands_DigitEntry.cpp \
@@ -846,6 +892,7 @@ SOURCES += \
     Source/PokemonSwSh/Resources/PokemonSwSh_TypeMatchup.cpp \
     Source/PokemonSwSh/Resources/PokemonSwSh_TypeSprites.cpp \
     Source/PokemonSwSh/ShinyHuntTracker.cpp \
+    Source/Tests/CommandLineBenchmark.cpp \
     Source/Tests/CommandLineTests.cpp \
     Source/Tests/CommonFramework_Tests.cpp \
     Source/Tests/Kernels_Tests.cpp \
@@ -872,6 +919,8 @@ HEADERS += \
     ../ClientSource/Connection/StreamInterface.h \
     ../ClientSource/Libraries/Logging.h \
     ../ClientSource/Libraries/MessageConverter.h \
+    ../Common/Cpp/AllocationCounter.h \
+    ../Common/Cpp/Containers/AlignedBufferPool.h \
     ../Common/CRC32.h \
     ../Common/Compiler.h \
     ../Common/Cpp/AbstractLogger.h \
@@ -993,6 +1042,7 @@ HEADERS += \
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.h \
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.h \
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.h \
+    Source/CommonFramework/AudioPipeline/Spectrum/SpectrumSlabPool.h \
     Source/CommonFramework/AudioPipeline/Tools/AudioFormatUtils.h \
     Source/CommonFramework/AudioPipeline/Tools/AudioNormalization.h \
     Source/CommonFramework/AudioPipeline/Tools/TimeSampleBuffer.h \
@@ -1029,7 +1079,9 @@ HEADERS += \
     Source/CommonFramework/ImageMatch/ImageMatchResult.h \
     Source/CommonFramework/ImageMatch/SilhouetteDictionaryMatcher.h \
     Source/CommonFramework/ImageMatch/SubObjectTemplateMatcher.h \
+    Source/CommonFramework/ImageMatch/ThumbnailIndex.h \
     Source/CommonFramework/ImageMatch/WaterfillTemplateMatcher.h \
+    Source/CommonFramework/ImageTools/BinaryImage_FilterHsv32.h \
     Source/CommonFramework/ImageTools/BinaryImage_FilterRgb32.h \
     Source/CommonFramework/ImageTools/ColorClustering.h \
     Source/CommonFramework/ImageTools/DistanceToLine.h \
@@ -1037,7 +1089,9 @@ HEADERS += \
     Source/CommonFramework/ImageTools/ImageBoxes.h \
     Source/CommonFramework/ImageTools/ImageFilter.h \
     Source/CommonFramework/ImageTools/ImageGradient.h \
+    Source/CommonFramework/ImageTools/ImageIntegralCache.h \
     Source/CommonFramework/ImageTools/ImageManip.h \
+    Source/CommonFramework/ImageTools/ImageScaler.h \
     Source/CommonFramework/ImageTools/ImageStats.h \
     Source/CommonFramework/ImageTools/SolidColorTest.h \
     Source/CommonFramework/ImageTools/WaterfillUtilities.h \
@@ -1049,6 +1103,7 @@ HEADERS += \
     Source/CommonFramework/ImageTypes/ImageViewRGB32.h \
     Source/CommonFramework/Inference/AnomalyDetector.h \
     Source/CommonFramework/Inference/AudioPerSpectrumDetectorBase.h \
+    Source/CommonFramework/Inference/AudioTemplateBank.h \
     Source/CommonFramework/Inference/AudioTemplateCache.h \
     Source/CommonFramework/Inference/BlackBorderDetector.h \
     Source/CommonFramework/Inference/BlackScreenDetector.h \
@@ -1079,11 +1134,15 @@ HEADERS += \
     Source/CommonFramework/Notifications/ProgramInfo.h \
     Source/CommonFramework/Notifications/ProgramNotifications.h \
     Source/CommonFramework/Notifications/SenderNotificationTable.h \
+    Source/CommonFramework/OCR/OCR_DictionaryIndex.h \
     Source/CommonFramework/OCR/OCR_DictionaryMatcher.h \
     Source/CommonFramework/OCR/OCR_DictionaryOCR.h \
+    Source/CommonFramework/OCR/OCR_GlyphClassifier.h \
     Source/CommonFramework/OCR/OCR_LargeDictionaryMatcher.h \
+    Source/CommonFramework/OCR/OCR_LevenshteinScorer.h \
     Source/CommonFramework/OCR/OCR_NumberReader.h \
     Source/CommonFramework/OCR/OCR_RawOCR.h \
+    Source/CommonFramework/OCR/OCR_ResultCache.h \
     Source/CommonFramework/OCR/OCR_Routines.h \
     Source/CommonFramework/OCR/OCR_SmallDictionaryMatcher.h \
     Source/CommonFramework/OCR/OCR_StringMatchResult.h \
@@ -1120,6 +1179,7 @@ HEADERS += \
     Source/CommonFramework/Tools/DebugDumper.h \
     Source/CommonFramework/Tools/ErrorDumper.h \
     Source/CommonFramework/Tools/FileDownloader.h \
+    Source/CommonFramework/Tools/ImageEncoder.h \
     Source/CommonFramework/Tools/InterruptableCommands.h \
     Source/CommonFramework/Tools/MultiConsoleErrors.h \
     Source/CommonFramework/Tools/ProgramEnvironment.h \
@@ -1130,7 +1190,11 @@ HEADERS += \
     Source/CommonFramework/VideoPipeline/Backends/CameraImplementations.h \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt5.h \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.h \
+    Source/CommonFramework/VideoPipeline/Backends/CameraWidgetReplay.h \
+    Source/CommonFramework/VideoPipeline/Backends/VideoReplaySource.h \
     Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt5.h \
+    Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt6.h \
+    Source/CommonFramework/VideoPipeline/BufferPoolStats.h \
     Source/CommonFramework/VideoPipeline/CameraInfo.h \
     Source/CommonFramework/VideoPipeline/CameraOption.h \
     Source/CommonFramework/VideoPipeline/CameraSession.h \
@@ -1167,8 +1231,10 @@ HEADERS += \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch.h \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_Default.h \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_x86_AVX2.h \
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_x86_AVX512.h \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch_x86_SSE41.h \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_x86_AVX2.h \
+    Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_x86_AVX512.h \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_BaseTransform_x86_SSE41.h \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_BitReverse.h \
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Butterflies.h \
@@ -1205,10 +1271,16 @@ HEADERS += \
     Source/Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixCore.tpp \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.h \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.tpp \
+    Source/Kernels/HammingDistance/Kernels_HammingDistance.h \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.h \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV.h \
+    Source/Kernels/ImageScale/Kernels_ImageScale.h \
+    Source/Kernels/ImageScale/Kernels_ImageScale_Routines.h \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h \
+    Source/Kernels/ImageStats/Kernels_ImageIntegralSumSqr.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h \
+    Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDevScaled.h \
     Source/Kernels/Kernels_Alignment.h \
     Source/Kernels/Kernels_BitScan.h \
     Source/Kernels/Kernels_BitSet.h \
@@ -1221,6 +1293,8 @@ HEADERS += \
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Routines.h \
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution.h \
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Routines.h \
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion.h \
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_Routines.h \
     Source/Kernels/Waterfill/Kernels_Waterfill.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x16_x64_AVX2.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x32_x64_AVX512-GF.h \
@@ -1747,6 +1821,7 @@ HEADERS += \
     Source/PokemonSwSh/Resources/PokemonSwSh_TypeMatchup.h \
     Source/PokemonSwSh/Resources/PokemonSwSh_TypeSprites.h \
     Source/PokemonSwSh/ShinyHuntTracker.h \
+    Source/Tests/CommandLineBenchmark.h \
     Source/Tests/CommandLineTests.h \
     Source/Tests/CommonFramework_Tests.h \
     Source/Tests/Kernels_Tests.h \
@@ -1759,6 +1834,13 @@ HEADERS += \
 
 
 
+# Count heap allocations in the command line benchmarks. This replaces the
+# global operator new, so keep it out of release builds.
+# Enable with: qmake CONFIG+=pa_count_allocations
+pa_count_allocations{
+    SOURCES += ../Common/Cpp/AllocationCounter.cpp
+}
+
 exists(../../Internal/SerialPrograms/TelemetryURLs.h){
     DEFINES += PA_OFFICIAL
     SOURCES += ../../Internal/SerialPrograms/NintendoSwitch_TestPrograms.cpp
@@ -76,7 +76,7 @@ public:
 
 
 private:
-    virtual void on_fft(size_t sample_rate, std::shared_ptr<AlignedVector<float>> fft_output) override;
+    virtual void on_fft(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output) override;
 
     bool sanitize_format();
     void push_input_changed();
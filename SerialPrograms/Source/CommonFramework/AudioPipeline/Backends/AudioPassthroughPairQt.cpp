@@ -69,7 +69,7 @@ public:
     ~InternalFFTListener(){
         m_parent.m_fft_runner->remove_listener(*this);
     }
-    virtual void on_fft(size_t sample_rate, std::shared_ptr<AlignedVector<float>> fft_output) override{
+    virtual void on_fft(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output) override{
         //  This is already inside the lock.
 //        SpinLockGuard lg(m_parent.m_lock);
         for (FFTListener* listener : m_parent.m_listeners){
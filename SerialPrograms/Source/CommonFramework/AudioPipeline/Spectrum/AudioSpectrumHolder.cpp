@@ -22,6 +22,7 @@ AudioSpectrumHolder::AudioSpectrumHolder()
     , m_spectrograph(m_numFreqVisBlocks, m_numFreqWindows)
     , m_freqVisStamps(m_numFreqWindows)
 {
+    m_spectrums.reserve(m_spectrum_history_length);
     m_last_spectrum.values.resize(m_numFreqVisBlocks);
     m_last_spectrum.colors.resize(m_numFreqVisBlocks);
 
@@ -99,9 +100,10 @@ void AudioSpectrumHolder::clear(){
         // update m_spectrum_stamp_start in case the audio widget is used
         // again to store new spectrums.
         if (m_spectrums.size() > 0){
-            m_spectrum_stamp_start = m_spectrums.front().stamp + 1;
+            m_spectrum_stamp_start = spectrum(0).stamp + 1;
         }
         m_spectrums.clear();
+        m_spectrums_newest = 0;
 
         m_spectrograph.clear();
         memset(m_last_spectrum.values.data(), 0, m_last_spectrum.values.size() * sizeof(float));
@@ -151,10 +153,14 @@ void AudioSpectrumHolder::push_spectrum(size_t sample_rate, std::shared_ptr<cons
     const AlignedVector<float>& output = *fft_output;
 
     {
-        const size_t stamp = (m_spectrums.size() > 0) ? m_spectrums.front().stamp + 1 : m_spectrum_stamp_start;
-        m_spectrums.emplace_front(stamp, sample_rate, fft_output);
-        if (m_spectrums.size() > m_spectrum_history_length){
-            m_spectrums.pop_back();
+        const size_t stamp = (m_spectrums.size() > 0) ? spectrum(0).stamp + 1 : m_spectrum_stamp_start;
+        if (m_spectrums.size() < m_spectrum_history_length){
+            m_spectrums_newest = m_spectrums.size();
+            m_spectrums.emplace_back(stamp, sample_rate, fft_output);
+        }else{
+            // Overwrite the oldest. This releases its FFT output back to the FFT streamer.
+            m_spectrums_newest = (m_spectrums_newest + 1) % m_spectrums.size();
+            m_spectrums[m_spectrums_newest] = AudioSpectrum(stamp, sample_rate, fft_output);
         }
 
         // std::cout << "Loadd FFT output , stamp " << spectrum->stamp << std::endl;
@@ -249,7 +255,8 @@ std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_since(uint64_t startin
 
     std::lock_guard<std::mutex> lg(m_state_lock);
 
-    for (const auto& ptr : m_spectrums){
+    for (size_t i = 0; i < m_spectrums.size(); i++){
+        const AudioSpectrum& ptr = spectrum(i);
         if (ptr.stamp >= startingStamp){
             spectrums.emplace_back(ptr);
         } else{
@@ -263,13 +270,10 @@ std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_latest(size_t numLates
 
     std::lock_guard<std::mutex> lg(m_state_lock);
 
-    size_t i = 0;
-    for (const auto& ptr : m_spectrums){
-        if (i == numLatestSpectrums){
-            break;
-        }
-        spectrums.push_back(ptr);
-        i++;
+    const size_t count = std::min(numLatestSpectrums, m_spectrums.size());
+    spectrums.reserve(count);
+    for (size_t i = 0; i < count; i++){
+        spectrums.push_back(spectrum(i));
     }
     return spectrums;
 }
@@ -65,6 +65,12 @@ public:
     void saveAudioFrequenciesToDisk(bool enable);
 
 
+private:
+    // The i-th newest spectrum in history. i = 0 is the newest.
+    const AudioSpectrum& spectrum(size_t i) const{
+        return m_spectrums[(m_spectrums_newest + m_spectrums.size() - i) % m_spectrums.size()];
+    }
+
 private:
     // Num frequencies to store for the output of one fft computation.
     const size_t m_numFreqs;
@@ -88,9 +94,10 @@ private:
 
     // record the past FFT output frequencies to serve as the interface
     // of audio inference for automation programs.
-    // The head of the list is the most recent FFT window, while the tail
-    // is the oldest in history.
-    std::list<AudioSpectrum> m_spectrums;
+    // This is a ring buffer of at most `m_spectrum_history_length` FFT windows.
+    // m_spectrums[m_spectrums_newest] is the most recent FFT window.
+    std::vector<AudioSpectrum> m_spectrums;
+    size_t m_spectrums_newest = 0;
     size_t m_spectrum_history_length = 40;
     // The initial timestamp for the incoming spectrums.
     size_t m_spectrum_stamp_start = 0;
@@ -13,6 +13,15 @@
 namespace PokemonAutomation{
 
 
+//  AudioSpectrumHolder keeps the last 40 spectrums. Leave room for the ones
+//  still held by the inference callbacks.
+const size_t FFT_OUTPUT_POOL_CAPACITY = 128;
+
+//  Most audio blocks fill zero or one window. Larger ones (like a file being
+//  streamed in) fill several. Transform up to this many at once.
+const size_t FFT_MAX_BATCH = 8;
+
+
 
 std::unique_ptr<AudioFloatToFFT> make_FFT_streamer(AudioChannelFormat format){
     switch (format){
@@ -52,12 +61,19 @@ AudioFloatToFFT::AudioFloatToFFT(
     , m_fft_sample_size(average_pairs ? 2 : 1)
     , m_buffer(NUM_FFT_SAMPLES)
     , m_buffered(NUM_FFT_SAMPLES)
-    , m_fft_input(NUM_FFT_SAMPLES)
+    , m_fft_inputs(FFT_MAX_BATCH * NUM_FFT_SAMPLES)
+    , m_fft_input_ptrs(FFT_MAX_BATCH)
+    , m_fft_output_ptrs(FFT_MAX_BATCH)
+    , m_fft_outputs(FFT_MAX_BATCH)
+    , m_output_pool(NUM_FFT_SAMPLES / 2, FFT_OUTPUT_POOL_CAPACITY)
 {
     if (samples_per_frame == 0 || samples_per_frame > 2){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Channels must be 1 or 2.");
     }
     memset(m_buffer.data(), 0, m_buffer.size() * sizeof(float));
+    for (size_t c = 0; c < FFT_MAX_BATCH; c++){
+        m_fft_input_ptrs[c] = m_fft_inputs.data() + c * NUM_FFT_SAMPLES;
+    }
 }
 AudioFloatToFFT::~AudioFloatToFFT(){}
 void AudioFloatToFFT::on_samples(const float* data, size_t frames){
@@ -82,13 +98,15 @@ void AudioFloatToFFT::on_samples(const float* data, size_t frames){
         ptr += block * m_fft_sample_size;
         frames -= block;
 
-        //  Buffer is full. Time to run FFT!
+        //  Buffer is full. Queue it up for the FFT.
         if (m_buffered == m_buffer.size()){
-//            cout << "run_fft()" << endl;
-            run_fft();
+            queue_window();
             drop_from_front(FFT_SLIDING_WINDOW_STEP);
         }
     }
+
+    //  Transform all the windows from this block together.
+    run_fft();
 }
 void AudioFloatToFFT::convert(float* fft_input, const float* audio_stream, size_t frames){
     if (!m_average){
@@ -99,8 +117,12 @@ void AudioFloatToFFT::convert(float* fft_input, const float* audio_stream, size_
         fft_input[c] = (audio_stream[2*c + 0] + audio_stream[2*c + 1]) * 0.5f;
     }
 }
-void AudioFloatToFFT::run_fft(){
-    float* ptr = m_fft_input.data();
+void AudioFloatToFFT::queue_window(){
+    if (m_queued == FFT_MAX_BATCH){
+        run_fft();
+    }
+
+    float* ptr = m_fft_input_ptrs[m_queued];
     size_t remaining = NUM_FFT_SAMPLES;
     size_t index = m_start;
     while (remaining > 0){
@@ -113,11 +135,27 @@ void AudioFloatToFFT::run_fft(){
             index = 0;
         }
     }
-    std::shared_ptr<AlignedVector<float>> out = std::make_unique<AlignedVector<float>>(NUM_FFT_SAMPLES / 2);
-    Kernels::AbsFFT::fft_abs(FFT_LENGTH_POWER_OF_TWO, out->data(), m_fft_input.data());
-    for (FFTListener* listener : m_listeners){
-        listener->on_fft(m_sample_rate, out);
+
+    std::shared_ptr<AlignedVector<float>>& out = m_fft_outputs[m_queued];
+    out = m_output_pool.acquire();
+    m_fft_output_ptrs[m_queued] = out->data();
+    m_queued++;
+}
+void AudioFloatToFFT::run_fft(){
+    if (m_queued == 0){
+        return;
+    }
+    Kernels::AbsFFT::fft_abs(
+        FFT_LENGTH_POWER_OF_TWO, m_queued,
+        m_fft_output_ptrs.data(), m_fft_input_ptrs.data()
+    );
+    for (size_t c = 0; c < m_queued; c++){
+        std::shared_ptr<AlignedVector<float>> out = std::move(m_fft_outputs[c]);
+        for (FFTListener* listener : m_listeners){
+            listener->on_fft(m_sample_rate, out);
+        }
     }
+    m_queued = 0;
 }
 void AudioFloatToFFT::drop_from_front(size_t frames){
     if (frames >= m_buffered){
@@ -8,13 +8,16 @@
 #define PokemonAutomation_AudioPipeline_FFTStreamer_H
 
 #include "CommonFramework/AudioPipeline/AudioStream.h"
+#include "SpectrumSlabPool.h"
 
 namespace PokemonAutomation{
 
 
 
+//  The FFT outputs are recycled once every listener is done with them.
+//  So listeners must not modify them.
 struct FFTListener{
-    virtual void on_fft(size_t sample_rate, std::shared_ptr<AlignedVector<float>> fft_output) = 0;
+    virtual void on_fft(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output) = 0;
 };
 
 
@@ -35,6 +38,7 @@ public:
 
 private:
     void convert(float* fft_input, const float* audio_stream, size_t frames);
+    void queue_window();
     void run_fft();
     void drop_from_front(size_t frames);
 
@@ -49,7 +53,13 @@ private:
     size_t m_start = 0;
     size_t m_end = 0;
 
-    AlignedVector<float> m_fft_input;
+    //  Full windows waiting to be transformed together.
+    size_t m_queued = 0;
+    AlignedVector<float> m_fft_inputs;
+    std::vector<float*> m_fft_input_ptrs;
+    std::vector<float*> m_fft_output_ptrs;
+    std::vector<std::shared_ptr<AlignedVector<float>>> m_fft_outputs;
+    SpectrumSlabPool m_output_pool;
 
     std::set<FFTListener*> m_listeners;
 };
@@ -0,0 +1,52 @@
+/*  Spectrum Slab Pool
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <atomic>
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "SpectrumSlabPool.h"
+
+namespace PokemonAutomation{
+
+
+
+SpectrumSlabPool::SpectrumSlabPool(size_t length, size_t capacity)
+    : m_length(length)
+    , m_capacity(capacity)
+{
+    m_slabs.reserve(capacity);
+}
+
+std::shared_ptr<AlignedVector<float>> SpectrumSlabPool::acquire(){
+    const size_t size = m_slabs.size();
+    for (size_t c = 0; c < size; c++){
+        size_t index = m_next + c;
+        if (index >= size){
+            index -= size;
+        }
+        std::shared_ptr<AlignedVector<float>>& slab = m_slabs[index];
+        if (slab.use_count() != 1){
+            continue;
+        }
+
+        //  use_count() is a relaxed load. Pair it with the release of the last
+        //  holder so that holder's reads finish before we overwrite the slab.
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        m_next = index + 1 == size ? 0 : index + 1;
+        return slab;
+    }
+
+    std::shared_ptr<AlignedVector<float>> slab = std::make_shared<AlignedVector<float>>(m_length);
+    if (size < m_capacity){
+        m_slabs.emplace_back(slab);
+        m_next = 0;
+    }
+    return slab;
+}
+
+
+
+}
@@ -0,0 +1,50 @@
+/*  Spectrum Slab Pool
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A pool of reference-counted FFT output buffers that are recycled once
+ *  every holder of them lets go. This keeps the FFT streamer from allocating
+ *  a new buffer for every FFT hop.
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_SpectrumSlabPool_H
+#define PokemonAutomation_AudioPipeline_SpectrumSlabPool_H
+
+#include <memory>
+#include <vector>
+#include "Common/Cpp/Containers/AlignedVector.h"
+
+namespace PokemonAutomation{
+
+
+//  Not thread-safe. acquire() must be called from a single thread. The buffers
+//  it hands out can be held and released on any thread.
+class SpectrumSlabPool{
+public:
+    //  length: number of floats in each buffer.
+    //  capacity: max number of buffers the pool keeps. If all of them are still
+    //  held when a new one is needed, acquire() falls back to allocating.
+    SpectrumSlabPool(size_t length, size_t capacity);
+
+    //  Return a buffer of `length` floats that nobody else references.
+    //  Its contents are unspecified.
+    std::shared_ptr<AlignedVector<float>> acquire();
+
+    size_t slabs() const{ return m_slabs.size(); }
+
+private:
+    size_t m_length;
+    size_t m_capacity;
+
+    //  A slab is free when the pool holds the only reference to it.
+    std::vector<std::shared_ptr<AlignedVector<float>>> m_slabs;
+    //  Where to start looking for a free slab. Slabs are released roughly in
+    //  the order they are acquired, so this usually hits on the first try.
+    size_t m_next = 0;
+};
+
+
+
+}
+#endif
@@ -77,6 +77,9 @@ void PreloadSettings::load(const JsonValue& json){
     if (debug_obj){
         debug_obj->read_boolean(DEBUG.COLOR_CHECK, "COLOR_CHECK");
         debug_obj->read_boolean(DEBUG.IMAGE_TEMPLATE_MATCHING, "IMAGE_TEMPLATE_MATCHING");
+        debug_obj->read_boolean(DEBUG.OCR_DICTIONARY_INDEX, "OCR_DICTIONARY_INDEX");
+        debug_obj->read_boolean(DEBUG.OCR_GLYPH_CLASSIFIER, "OCR_GLYPH_CLASSIFIER");
+        debug_obj->read_boolean(DEBUG.SERIAL_PIPELINING, "SERIAL_PIPELINING");
     }
 }
 
@@ -158,6 +161,18 @@ GlobalSettings::GlobalSettings()
         "Thread priority of computation threads.",
         DEFAULT_PRIORITY_COMPUTE
     )
+    , PARALLEL_VIDEO_INFERENCE(
+        "<b>Parallel Video Inference:</b><br>"
+        "Run all the video detectors that are due on the same frame in parallel instead of one after another.",
+        LockWhileRunning::LOCKED,
+        false
+    )
+    , OCR_CACHE_SIZE(
+        "<b>OCR Cache Size:</b><br>"
+        "Remember the text read from this many images so that reading the same image again skips the OCR. Set to zero to disable.",
+        LockWhileRunning::UNLOCKED,
+        1024
+    )
     , AUDIO_FILE_VOLUME_SCALE(
         "<b>Audio File Input Volume Scale:</b><br>"
         "Multiply audio file playback by this factor. (This is linear scale. So each factor of 10 is 20dB.)",
@@ -214,6 +229,8 @@ GlobalSettings::GlobalSettings()
     PA_ADD_OPTION(REALTIME_THREAD_PRIORITY0);
     PA_ADD_OPTION(INFERENCE_PRIORITY0);
     PA_ADD_OPTION(COMPUTE_PRIORITY0);
+    PA_ADD_OPTION(PARALLEL_VIDEO_INFERENCE);
+    PA_ADD_OPTION(OCR_CACHE_SIZE);
 
     PA_ADD_OPTION(AUDIO_FILE_VOLUME_SCALE);
     PA_ADD_OPTION(AUDIO_DEVICE_VOLUME_SCALE);
@@ -260,6 +277,12 @@ void GlobalSettings::load_json(const JsonValue& json){
             COMMAND_LINE_TEST_FOLDER = "CommandLineTests";
         }
 
+        command_line_tests_setting->read_integer(COMMAND_LINE_BENCHMARK_ITERATIONS, "BENCHMARK_ITERATIONS");
+        if (!command_line_tests_setting->read_string(COMMAND_LINE_BENCHMARK_OUTPUT, "BENCHMARK_OUTPUT")){
+            COMMAND_LINE_BENCHMARK_OUTPUT = "CommandLineBenchmark.json";
+        }
+        command_line_tests_setting->read_boolean(COMMAND_LINE_BENCHMARK_ALL_PROCESSOR_LEVELS, "BENCHMARK_ALL_PROCESSOR_LEVELS");
+
         const JsonArray* test_list = command_line_tests_setting->get_array("TEST_LIST");
         if (test_list){
             for (const auto& value: *test_list){
@@ -299,6 +322,9 @@ void GlobalSettings::load_json(const JsonValue& json){
                     std::cout << "- " << name << std::endl;
                 }
             }
+            if (COMMAND_LINE_BENCHMARK_ITERATIONS > 0){
+                std::cout << "Benchmark with " << COMMAND_LINE_BENCHMARK_ITERATIONS << " iterations per test file." << std::endl;
+            }
         }
     }
 }
@@ -311,6 +337,9 @@ JsonValue GlobalSettings::to_json() const{
     JsonObject command_line_test_obj;
     command_line_test_obj["RUN"] = COMMAND_LINE_TEST_MODE;
     command_line_test_obj["FOLDER"] = COMMAND_LINE_TEST_FOLDER;
+    command_line_test_obj["BENCHMARK_ITERATIONS"] = COMMAND_LINE_BENCHMARK_ITERATIONS;
+    command_line_test_obj["BENCHMARK_OUTPUT"] = COMMAND_LINE_BENCHMARK_OUTPUT;
+    command_line_test_obj["BENCHMARK_ALL_PROCESSOR_LEVELS"] = COMMAND_LINE_BENCHMARK_ALL_PROCESSOR_LEVELS;
 
     {
         JsonArray test_list;
@@ -334,6 +363,9 @@ JsonValue GlobalSettings::to_json() const{
     const auto& debug_settings = PreloadSettings::instance().DEBUG;
     debug_obj["COLOR_CHECK"] = debug_settings.COLOR_CHECK;
     debug_obj["IMAGE_TEMPLATE_MATCHING"] = debug_settings.IMAGE_TEMPLATE_MATCHING;
+    debug_obj["OCR_DICTIONARY_INDEX"] = debug_settings.OCR_DICTIONARY_INDEX;
+    debug_obj["OCR_GLYPH_CLASSIFIER"] = debug_settings.OCR_GLYPH_CLASSIFIER;
+    debug_obj["SERIAL_PIPELINING"] = debug_settings.SERIAL_PIPELINING;
     obj["DEBUG"] = std::move(debug_obj);
 
     return obj;
@@ -47,6 +47,9 @@ public:
 struct DebugSettings{
     bool COLOR_CHECK = false;
     bool IMAGE_TEMPLATE_MATCHING = false;
+    bool OCR_DICTIONARY_INDEX = false;
+    bool OCR_GLYPH_CLASSIFIER = false;
+    bool SERIAL_PIPELINING = false;
 };
 
 
@@ -99,6 +102,8 @@ public:
     ThreadPriorityOption REALTIME_THREAD_PRIORITY0;
     ThreadPriorityOption INFERENCE_PRIORITY0;
     ThreadPriorityOption COMPUTE_PRIORITY0;
+    BooleanCheckBoxOption PARALLEL_VIDEO_INFERENCE;
+    SimpleIntegerOption<uint32_t> OCR_CACHE_SIZE;
 
     FloatingPointOption AUDIO_FILE_VOLUME_SCALE;
     FloatingPointOption AUDIO_DEVICE_VOLUME_SCALE;
@@ -121,6 +126,13 @@ public:
     // Which tests to ignore running under the command line test mode.
     // If a test path appears in both COMMAND_LINE_TEST_LIST and COMMAND_LINE_IGNORE_LIST, it's still ignored.
     std::vector<std::string> COMMAND_LINE_IGNORE_LIST;
+    // If non-zero, run each test file this many more times to benchmark it.
+    // See Tests/CommandLineBenchmark.h.
+    size_t COMMAND_LINE_BENCHMARK_ITERATIONS = 0;
+    // Where to write the benchmark results.
+    std::string COMMAND_LINE_BENCHMARK_OUTPUT;
+    // Repeat the benchmark at every available processor level.
+    bool COMMAND_LINE_BENCHMARK_ALL_PROCESSOR_LEVELS = false;
 };
 
 
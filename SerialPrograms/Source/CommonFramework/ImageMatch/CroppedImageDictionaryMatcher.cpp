@@ -37,6 +37,20 @@ void CroppedImageDictionaryMatcher::add(const std::string& slug, const ImageView
         std::forward_as_tuple(slug),
         std::forward_as_tuple(trim_image_alpha(image).copy(), m_weight)
     );
+    if (m_prune_keep != 0){
+        m_thumbnails.add(slug, trim_image_alpha(image));
+    }
+}
+void CroppedImageDictionaryMatcher::set_pruning(size_t keep, bool verify){
+    m_prune_keep = keep;
+    m_prune_verify = verify;
+    m_thumbnails.clear();
+    if (keep == 0){
+        return;
+    }
+    for (const auto& item : m_database){
+        m_thumbnails.add(item.first, item.second.image_template());
+    }
 }
 
 
@@ -53,15 +67,53 @@ ImageMatchResult CroppedImageDictionaryMatcher::match(
     Color background;
     ImageRGB32 processed = process_image(image, background);
 
+    if (m_prune_keep == 0 || m_prune_keep >= m_database.size()){
+        return match_exhaustive(processed, background, alpha_spread);
+    }
+
+    results = match_pruned(processed, background, alpha_spread);
+    if (m_prune_verify){
+        ImageMatchResult exhaustive = match_exhaustive(processed, background, alpha_spread);
+        if (!verify_pruned_match("CroppedImageDictionaryMatcher", results, exhaustive)){
+            return exhaustive;
+        }
+    }
+    return results;
+}
+ImageMatchResult CroppedImageDictionaryMatcher::match_exhaustive(
+    const ImageViewRGB32& processed, Color background,
+    double alpha_spread
+) const{
+    ImageMatchResult results;
     for (const auto& item : m_database){
         double alpha = item.second.diff(processed, background);
         results.add(alpha, item.first);
         results.clear_beyond_spread(alpha_spread);
     }
-
     return results;
 }
+ImageMatchResult CroppedImageDictionaryMatcher::match_pruned(
+    const ImageViewRGB32& processed, Color background,
+    double alpha_spread
+) const{
+    //  Rank with the same metric as the full comparison, just on thumbnails.
+    ImageRGB32 thumbnail = m_thumbnails.make_thumbnail(processed);
+    std::vector<const std::string*> survivors = m_thumbnails.rank(
+        m_prune_keep,
+        [&](const std::string& slug, const ExactImageMatcher& matcher){
+            const WeightedExactImageMatcher& full = m_database.find(slug)->second;
+            return matcher.rmsd(thumbnail, background) * full.m_multiplier;
+        }
+    );
 
+    ImageMatchResult results;
+    for (const std::string* slug : survivors){
+        double alpha = m_database.find(*slug)->second.diff(processed, background);
+        results.add(alpha, *slug);
+        results.clear_beyond_spread(alpha_spread);
+    }
+    return results;
+}
 
 
 
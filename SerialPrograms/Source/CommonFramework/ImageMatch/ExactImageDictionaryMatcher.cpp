@@ -5,10 +5,12 @@
  */
 
 #include <cmath>
+#include <limits>
 #include <vector>
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/ImageTools/ImageScaler.h"
 #include "ImageDiff.h"
 #include "ExactImageDictionaryMatcher.h"
 
@@ -41,6 +43,9 @@ std::vector<ImageRGB32> make_image_set(
     ptrdiff_t scale = (ptrdiff_t)(std::sqrt(num_image_pixels / num_template_pixels) + 0.5);
     scale = std::max<ptrdiff_t>(scale, 1);
 
+    //  All the crops are (nearly always) the same size. So share one plan.
+    ImageScaler scaler(width, height);
+
     std::vector<ImageRGB32> ret;
     ptrdiff_t limit = (ptrdiff_t)tolerance;
     for (ptrdiff_t y = -limit; y <= limit; y++){
@@ -50,7 +55,7 @@ std::vector<ImageRGB32> make_image_set(
 //            }
 
             ret.emplace_back(
-                extract_box_reference(screen, box, x * scale, y * scale).scale_to(width, height)
+                scaler.scale(extract_box_reference(screen, box, x * scale, y * scale))
             );
 //            cout << "make_image_set(): image = " << ret.back().width() << " x " << ret.back().height() << endl;
 //            if (x == 0 && y == 0){
@@ -107,14 +112,17 @@ void ExactImageDictionaryMatcher::scale_to_dimensions(ImageRGB32& image) const{
 
 double ExactImageDictionaryMatcher::compare(
     const WeightedExactImageMatcher& sprite,
-    const std::vector<ImageRGB32>& images
+    const std::vector<ImageRGB32>& images,
+    double max_alpha
 ){
 //    sprite.m_image.save("sprite.png");
 //    images[0].save("image.png");
 
     double best = 10000;
     for (const ImageRGB32& image : images){
-        double rmsd_alpha = sprite.diff(image);
+        //  Anything worse than what we already have for this sprite doesn't
+        //  matter either. So let the matcher stop early on those.
+        double rmsd_alpha = sprite.diff(image, std::min(max_alpha, best));
 //        cout << rmsd_alpha << endl;
 //        if (rmsd_alpha < 0.38){
 //            sprite.m_image.save("sprite.png");
@@ -125,6 +133,12 @@ double ExactImageDictionaryMatcher::compare(
 //    cout << best << endl;
     return best;
 }
+double ExactImageDictionaryMatcher::max_alpha(const ImageMatchResult& results, double alpha_spread){
+    if (results.results.empty()){
+        return std::numeric_limits<double>::infinity();
+    }
+    return results.results.begin()->first + alpha_spread;
+}
 
 ImageMatchResult ExactImageDictionaryMatcher::match(
     const ImageViewRGB32& image, const ImageFloatBox& box,
@@ -142,7 +156,12 @@ ImageMatchResult ExactImageDictionaryMatcher::match(
 //        if (item.first != "linoone-galar"){
 //            continue;
 //        }
-        double alpha = compare(item.second, image_set);
+        double max_alpha = ExactImageDictionaryMatcher::max_alpha(results, alpha_spread);
+        double alpha = compare(item.second, image_set, max_alpha);
+        if (alpha > max_alpha){
+            //  Would be removed by "clear_beyond_spread()" anyway.
+            continue;
+        }
         results.add(alpha, item.first);
         results.clear_beyond_spread(alpha_spread);
     }
@@ -165,7 +184,12 @@ ImageMatchResult ExactImageDictionaryMatcher::subset_match(
     std::vector<ImageRGB32> image_set = make_image_set(image, box,  m_width, m_height, tolerance);
     for (const auto& slug : subset){
         const auto& matcher = image_matcher(slug);
-        double alpha = compare(matcher, image_set);
+        double max_alpha = ExactImageDictionaryMatcher::max_alpha(results, alpha_spread);
+        double alpha = compare(matcher, image_set, max_alpha);
+        if (alpha > max_alpha){
+            //  Would be removed by "clear_beyond_spread()" anyway.
+            continue;
+        }
         results.add(alpha, slug);
         results.clear_beyond_spread(alpha_spread);
     }
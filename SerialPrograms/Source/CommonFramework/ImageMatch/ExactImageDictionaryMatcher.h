@@ -66,10 +66,16 @@ public:
 
 
 private:
+    //  Return the best score of "sprite" against all "images".
+    //  Only scores up to "max_alpha" matter. If the best score is larger,
+    //  the result may be any value larger than "max_alpha".
     static double compare(
         const WeightedExactImageMatcher& sprite,
-        const std::vector<ImageRGB32>& images
+        const std::vector<ImageRGB32>& images,
+        double max_alpha
     );
+    //  Largest score that can still survive "clear_beyond_spread()".
+    static double max_alpha(const ImageMatchResult& results, double alpha_spread);
 
 
 private:
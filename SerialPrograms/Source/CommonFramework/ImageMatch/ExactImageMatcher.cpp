@@ -5,7 +5,10 @@
  */
 
 #include <cmath>
+#include <limits>
 #include "Common/Cpp/Exceptions.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqrDevScaled.h"
 #include "ImageDiff.h"
 #include "ExactImageMatcher.h"
 
@@ -27,14 +30,18 @@ ExactImageMatcher::ExactImageMatcher(ImageRGB32 image)
 //    cout << m_stats.stddev.sum() << endl;
 }
 
-ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& image) const{
-    FloatPixel image_brightness = pixel_average(image, m_image);
+FloatPixel ExactImageMatcher::brightness_scale(const FloatPixel& image_brightness) const{
     FloatPixel scale = image_brightness / m_stats.average;
 
     if (std::isnan(scale.r)) scale.r = 1.0;
     if (std::isnan(scale.g)) scale.g = 1.0;
     if (std::isnan(scale.b)) scale.b = 1.0;
     scale.bound(0.8, 1.2);
+    return scale;
+}
+ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& image) const{
+    FloatPixel image_brightness = pixel_average(image, m_image);
+    FloatPixel scale = brightness_scale(image_brightness);
 
     ImageRGB32 ret = m_image.copy();
     scale_brightness(ret, scale);
@@ -81,6 +88,52 @@ double ExactImageMatcher::rmsd_masked(const ImageViewRGB32& image) const{
     ImageRGB32 reference = scale_template_brightness(scaled);
     return pixel_RMSD_masked(reference, scaled);
 }
+double ExactImageMatcher::rmsd(const ImageViewRGB32& image, double max_rmsd) const{
+    if (!image){
+        return 1000.;
+    }
+
+    ImageViewRGB32 view = image;
+    ImageRGB32 scaled;
+    if (image.width() != m_image.width() || image.height() != m_image.height()){
+        scaled = image.scale_to(m_image.width(), m_image.height());
+        view = scaled;
+    }
+
+    //  Same as "pixel_average(view, m_image)", but we also want the count.
+    Kernels::PixelSums sums;
+    Kernels::pixel_sum_sqr(
+        sums, view.width(), view.height(),
+        view.data(), view.bytes_per_row(),
+        m_image.data(), m_image.bytes_per_row()
+    );
+    FloatPixel image_brightness((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
+    image_brightness /= (double)sums.count;
+    FloatPixel scale = brightness_scale(image_brightness);
+
+    //  Convert the RMSD limit into a sum-of-squares limit. Leave some slack
+    //  so that rounding never causes a result under the limit to be dropped.
+    uint64_t max_sumsqrs = std::numeric_limits<uint64_t>::max();
+    double limit = max_rmsd * max_rmsd * (double)sums.count * (1 + 1e-9) + 1;
+    if (limit < 1e19){
+        max_sumsqrs = (uint64_t)limit;
+    }
+
+    uint64_t count = 0;
+    uint64_t sumsqrs = 0;
+    bool finished = Kernels::sum_sqr_deviation_scaled(
+        count, sumsqrs,
+        m_image.width(), m_image.height(),
+        m_image.data(), m_image.bytes_per_row(),
+        view.data(), view.bytes_per_row(),
+        (float)scale.r, (float)scale.g, (float)scale.b,
+        max_sumsqrs
+    );
+    if (!finished){
+        return std::numeric_limits<double>::infinity();
+    }
+    return std::sqrt((double)sumsqrs / (double)count);
+}
 
 
 
@@ -109,6 +162,15 @@ double WeightedExactImageMatcher::diff_masked(const ImageViewRGB32& image) const
     }
     return rmsd_masked(image) * m_multiplier;
 }
+double WeightedExactImageMatcher::diff(const ImageViewRGB32& image, double max_diff) const{
+    if (!image){
+        return 1000.;
+    }
+    double max_rmsd = m_multiplier > 0
+        ? max_diff / m_multiplier
+        : std::numeric_limits<double>::infinity();
+    return rmsd(image, max_rmsd) * m_multiplier;
+}
 
 
 
@@ -48,12 +48,19 @@ public:
     // If both two images have alpha==0 on one pixel, that pixel is ignored.
     double rmsd_masked(const ImageViewRGB32& image) const;
 
+    // Same as rmsd(image), but for when only results up to `max_rmsd` matter.
+    // If the RMSD is larger than `max_rmsd`, this may stop early and return infinity.
+    // The template is never copied. Brightness scaling is done on the fly.
+    double rmsd(const ImageViewRGB32& image, double max_rmsd) const;
+
     const ImageRGB32& image_template() const { return m_image; }
 
 private:
     // scale stored image template according to the brightness of `image`, assign
     // the scaled template to `reference`.
     ImageRGB32 scale_template_brightness(const ImageViewRGB32& image) const;
+    // Brightness multiplier to apply to the template so that it matches `image_brightness`.
+    FloatPixel brightness_scale(const FloatPixel& image_brightness) const;
 
 protected:
     ImageRGB32 m_image;
@@ -87,6 +94,9 @@ public:
     double diff(const ImageViewRGB32& image, Color background) const;
     // Like ExactImageMatcher::rmsd_masked(image) but scale based on template stddev.
     double diff_masked(const ImageViewRGB32& image) const;
+    // Like ExactImageMatcher::rmsd(image, max_rmsd) but scale based on template stddev.
+    // If the result is larger than `max_diff`, this may stop early and return infinity.
+    double diff(const ImageViewRGB32& image, double max_diff) const;
 
 public:
     double m_multiplier;
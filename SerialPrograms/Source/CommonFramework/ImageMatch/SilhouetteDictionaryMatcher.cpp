@@ -33,6 +33,20 @@ void SilhouetteDictionaryMatcher::add(const std::string& slug, const ImageViewRG
         std::forward_as_tuple(slug),
         std::forward_as_tuple(trim_image_alpha(image).copy())
     );
+    if (m_prune_keep != 0){
+        m_thumbnails.add(slug, trim_image_alpha(image));
+    }
+}
+void SilhouetteDictionaryMatcher::set_pruning(size_t keep, bool verify){
+    m_prune_keep = keep;
+    m_prune_verify = verify;
+    m_thumbnails.clear();
+    if (keep == 0){
+        return;
+    }
+    for (const auto& item : m_database){
+        m_thumbnails.add(item.first, item.second.image_template());
+    }
 }
 
 
@@ -46,6 +60,24 @@ ImageMatchResult SilhouetteDictionaryMatcher::match(
         return results;
     }
 
+    if (m_prune_keep == 0 || m_prune_keep >= m_database.size()){
+        return match_exhaustive(image, alpha_spread);
+    }
+
+    results = match_pruned(image, alpha_spread);
+    if (m_prune_verify){
+        ImageMatchResult exhaustive = match_exhaustive(image, alpha_spread);
+        if (!verify_pruned_match("SilhouetteDictionaryMatcher", results, exhaustive)){
+            return exhaustive;
+        }
+    }
+    return results;
+}
+ImageMatchResult SilhouetteDictionaryMatcher::match_exhaustive(
+    const ImageViewRGB32& image,
+    double alpha_spread
+) const{
+    ImageMatchResult results;
     for (const auto& item : m_database){
 //        if (item.first != "solosis"){
 //            continue;
@@ -54,10 +86,29 @@ ImageMatchResult SilhouetteDictionaryMatcher::match(
         results.add(alpha, item.first);
         results.clear_beyond_spread(alpha_spread);
     }
-
     return results;
 }
+ImageMatchResult SilhouetteDictionaryMatcher::match_pruned(
+    const ImageViewRGB32& image,
+    double alpha_spread
+) const{
+    //  Rank with the same metric as the full comparison, just on thumbnails.
+    ImageRGB32 thumbnail = m_thumbnails.make_thumbnail(image);
+    std::vector<const std::string*> survivors = m_thumbnails.rank(
+        m_prune_keep,
+        [&](const std::string&, const ExactImageMatcher& matcher){
+            return matcher.rmsd_masked(thumbnail);
+        }
+    );
 
+    ImageMatchResult results;
+    for (const std::string* slug : survivors){
+        double alpha = m_database.find(*slug)->second.rmsd_masked(image);
+        results.add(alpha, *slug);
+        results.clear_beyond_spread(alpha_spread);
+    }
+    return results;
+}
 
 
 
@@ -11,6 +11,7 @@
 #include "CommonFramework/ImageTools/FloatPixel.h"
 #include "ImageMatchResult.h"
 #include "ExactImageMatcher.h"
+#include "ThumbnailIndex.h"
 
 namespace PokemonAutomation{
     class ImageViewRGB32;
@@ -44,9 +45,27 @@ public:
     // If both two images have alpha==0 on one pixel, that pixel is ignored.
     ImageMatchResult match(const ImageViewRGB32& image, double alpha_spread) const;
 
+    // Optional coarse-to-fine matching for large dictionaries.
+    // If `keep` is non-zero, match() first compares the image against a 16x16
+    // thumbnail of every template and only runs the full comparison on the `keep`
+    // templates with the best thumbnail scores. Set `keep` to zero to go back to
+    // comparing against every template.
+    // If `verify` is true, match() also runs the exhaustive comparison, logs any
+    // difference and returns the exhaustive result.
+    void set_pruning(size_t keep, bool verify = false);
+
+
+private:
+    ImageMatchResult match_exhaustive(const ImageViewRGB32& image, double alpha_spread) const;
+    ImageMatchResult match_pruned(const ImageViewRGB32& image, double alpha_spread) const;
+
 
 private:
     std::map<std::string, ExactImageMatcher> m_database;
+
+    size_t m_prune_keep = 0;
+    bool m_prune_verify = false;
+    ThumbnailIndex m_thumbnails;
 };
 
 
@@ -0,0 +1,144 @@
+/*  Thumbnail Index
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "Kernels/ImageScale/Kernels_ImageScale.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "ThumbnailIndex.h"
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+
+ThumbnailIndex::ThumbnailIndex(size_t width, size_t height)
+    : m_width(width)
+    , m_height(height)
+{
+    if (width == 0 || height == 0){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Thumbnail size cannot be zero.");
+    }
+}
+void ThumbnailIndex::clear(){
+    m_thumbnails.clear();
+}
+void ThumbnailIndex::add(const std::string& slug, const ImageViewRGB32& image_template){
+    if (!image_template){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Null image.");
+    }
+    auto iter = m_thumbnails.find(slug);
+    if (iter != m_thumbnails.end()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Duplicate slug: " + slug);
+    }
+
+    m_thumbnails.emplace(
+        std::piecewise_construct,
+        std::forward_as_tuple(slug),
+        std::forward_as_tuple(make_thumbnail(image_template))
+    );
+}
+ImageRGB32 ThumbnailIndex::make_thumbnail(const ImageViewRGB32& image) const{
+    //  Average the whole area behind each thumbnail pixel. Nearest-neighbor
+    //  would rank the templates on whichever 256 pixels happen to be sampled.
+    //
+    //  Weight the colors by alpha so that the colors of transparent pixels
+    //  don't bleed into the edges. Thumbnail pixels that end up less than
+    //  half covered are transparent to the RMSD kernels.
+    size_t width = image.width();
+    size_t height = image.height();
+    ImageRGB32 premultiplied(width, height);
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            uint32_t pixel = image.pixel(c, r);
+            uint32_t alpha = pixel >> 24;
+            uint32_t red   = ((pixel >> 16) & 0xff) * alpha / 255;
+            uint32_t green = ((pixel >>  8) & 0xff) * alpha / 255;
+            uint32_t blue  = ((pixel >>  0) & 0xff) * alpha / 255;
+            premultiplied.pixel(c, r) = (alpha << 24) | (red << 16) | (green << 8) | blue;
+        }
+    }
+
+    ImageRGB32 ret = premultiplied.scale_to(m_width, m_height, Kernels::ImageScaleMode::AREA_AVERAGE);
+    for (size_t r = 0; r < m_height; r++){
+        for (size_t c = 0; c < m_width; c++){
+            uint32_t& pixel = ret.pixel(c, r);
+            uint32_t alpha = pixel >> 24;
+            if (alpha == 0){
+                continue;
+            }
+            uint32_t red   = std::min<uint32_t>(((pixel >> 16) & 0xff) * 255 / alpha, 255);
+            uint32_t green = std::min<uint32_t>(((pixel >>  8) & 0xff) * 255 / alpha, 255);
+            uint32_t blue  = std::min<uint32_t>(((pixel >>  0) & 0xff) * 255 / alpha, 255);
+            pixel = (alpha << 24) | (red << 16) | (green << 8) | blue;
+        }
+    }
+    return ret;
+}
+
+
+std::vector<const std::string*> ThumbnailIndex::rank(
+    size_t count,
+    const std::function<double(const std::string& slug, const ExactImageMatcher& thumbnail)>& score
+) const{
+    std::vector<std::pair<double, const std::string*>> scores;
+    scores.reserve(m_thumbnails.size());
+    for (const auto& item : m_thumbnails){
+        double current = score(item.first, item.second);
+        if (std::isnan(current)){
+            current = std::numeric_limits<double>::infinity();
+        }
+        scores.emplace_back(current, &item.first);
+    }
+
+    count = std::min(count, scores.size());
+    std::partial_sort(
+        scores.begin(), scores.begin() + count, scores.end(),
+        [](const std::pair<double, const std::string*>& a, const std::pair<double, const std::string*>& b){
+            return a.first < b.first;
+        }
+    );
+
+    std::vector<const std::string*> ret;
+    ret.reserve(count);
+    for (size_t c = 0; c < count; c++){
+        ret.emplace_back(scores[c].second);
+    }
+    return ret;
+}
+
+
+
+bool verify_pruned_match(
+    const char* matcher_name,
+    const ImageMatchResult& pruned,
+    const ImageMatchResult& exhaustive
+){
+    if (pruned.results == exhaustive.results){
+        return true;
+    }
+
+    std::string str = matcher_name;
+    str += ": Pruned search disagrees with exhaustive search.\n";
+    str += "Pruned:\n";
+    for (const auto& item : pruned.results){
+        str += "    " + std::to_string(item.first) + " : " + item.second + "\n";
+    }
+    str += "Exhaustive:\n";
+    for (const auto& item : exhaustive.results){
+        str += "    " + std::to_string(item.first) + " : " + item.second + "\n";
+    }
+    global_logger_tagged().log(str, COLOR_RED);
+    return false;
+}
+
+
+
+}
+}
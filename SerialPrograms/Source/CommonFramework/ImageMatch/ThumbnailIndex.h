@@ -0,0 +1,68 @@
+/*  Thumbnail Index
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Low resolution copies of every template in a dictionary. Dictionary
+ *  matchers can use this to quickly rank all the templates against an image
+ *  and then only run the full resolution comparison on the best few.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ThumbnailIndex_H
+#define PokemonAutomation_CommonFramework_ThumbnailIndex_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include "ImageMatchResult.h"
+#include "ExactImageMatcher.h"
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+class ThumbnailIndex{
+public:
+    ThumbnailIndex(size_t width = 16, size_t height = 16);
+
+    bool empty() const{ return m_thumbnails.empty(); }
+    size_t size() const{ return m_thumbnails.size(); }
+
+    void clear();
+
+    // Add the thumbnail of a template. Do not allow one slug to be added more than once.
+    void add(const std::string& slug, const ImageViewRGB32& image_template);
+
+    // Shrink `image` to the thumbnail size by alpha-weighted area averaging. Do this once
+    // per match and pass the result to the `score` function of rank().
+    ImageRGB32 make_thumbnail(const ImageViewRGB32& image) const;
+
+    // Score every thumbnail and return the slugs of the `count` lowest scores, best first.
+    // `score` is given the slug and the thumbnail of each template.
+    std::vector<const std::string*> rank(
+        size_t count,
+        const std::function<double(const std::string& slug, const ExactImageMatcher& thumbnail)>& score
+    ) const;
+
+
+private:
+    size_t m_width;
+    size_t m_height;
+    std::map<std::string, ExactImageMatcher> m_thumbnails;
+};
+
+
+// Compare the result of a pruned search against the exhaustive search.
+// Log the difference if there is one. Return true if they are the same.
+bool verify_pruned_match(
+    const char* matcher_name,
+    const ImageMatchResult& pruned,
+    const ImageMatchResult& exhaustive
+);
+
+
+
+}
+}
+#endif
@@ -0,0 +1,135 @@
+/*  Binary Image Filter HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Compiler.h"
+#include "Common/Cpp/Containers/FixedLimitVector.tpp"
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "CommonFramework/ImageTypes/ImageHSV32.h"
+#include "BinaryImage_FilterHsv32.h"
+
+namespace PokemonAutomation{
+
+
+
+//  The range kernels compare each byte independently. So a wrapping hue range
+//  is split into two ranges that are run in the same pass and OR'ed together.
+PA_FORCE_INLINE bool hue_wraps(uint32_t mins, uint32_t maxs){
+    return (uint8_t)(mins >> 16) > (uint8_t)(maxs >> 16);
+}
+PA_FORCE_INLINE uint32_t with_hue(uint32_t pixel, uint8_t hue){
+    return (pixel & 0xff00ffff) | ((uint32_t)hue << 16);
+}
+
+
+
+PackedBinaryMatrix compress_hsv32_to_binary_range(
+    const ImageViewHSV32& image,
+    uint8_t min_hue, uint8_t max_hue,
+    uint8_t min_saturation, uint8_t max_saturation,
+    uint8_t min_value, uint8_t max_value
+){
+    return compress_hsv32_to_binary_range(
+        image,
+        0xff000000 | ((uint32_t)min_hue << 16) | ((uint32_t)min_saturation << 8) | (uint32_t)min_value,
+        0xff000000 | ((uint32_t)max_hue << 16) | ((uint32_t)max_saturation << 8) | (uint32_t)max_value
+    );
+}
+PackedBinaryMatrix compress_hsv32_to_binary_range(
+    const ImageViewHSV32& image,
+    uint32_t mins, uint32_t maxs
+){
+    PackedBinaryMatrix ret(image.width(), image.height());
+    if (!hue_wraps(mins, maxs)){
+        Kernels::compress_rgb32_to_binary_range(
+            image.data(), image.bytes_per_row(),
+            ret, mins, maxs
+        );
+        return ret;
+    }
+
+    PackedBinaryMatrix upper(image.width(), image.height());
+    Kernels::CompressRgb32ToBinaryRangeFilter filters[] = {
+        {ret, with_hue(mins, 0), maxs},
+        {upper, mins, with_hue(maxs, 255)},
+    };
+    Kernels::compress_rgb32_to_binary_range(
+        image.data(), image.bytes_per_row(),
+        filters, 2
+    );
+    ret |= upper;
+    return ret;
+}
+std::vector<PackedBinaryMatrix> compress_hsv32_to_binary_range(
+    const ImageViewHSV32& image,
+    const std::vector<std::pair<uint32_t, uint32_t>>& filters
+){
+    //  Wrapping filters get an extra matrix for the upper half of the hue
+    //  range. These are merged back after the single pass over the image.
+    size_t wrapping = 0;
+    for (const auto& filter : filters){
+        wrapping += hue_wraps(filter.first, filter.second);
+    }
+
+    std::vector<PackedBinaryMatrix> ret;
+    std::vector<PackedBinaryMatrix> upper;
+    std::vector<size_t> upper_index;
+    upper.reserve(wrapping);
+    upper_index.reserve(wrapping);
+    FixedLimitVector<Kernels::CompressRgb32ToBinaryRangeFilter> vec(filters.size() + wrapping);
+    for (size_t c = 0; c < filters.size(); c++){
+        uint32_t mins = filters[c].first;
+        uint32_t maxs = filters[c].second;
+        ret.emplace_back(image.width(), image.height());
+        if (!hue_wraps(mins, maxs)){
+            vec.emplace_back(ret[c], mins, maxs);
+            continue;
+        }
+        upper.emplace_back(image.width(), image.height());
+        upper_index.emplace_back(c);
+        vec.emplace_back(ret[c], with_hue(mins, 0), maxs);
+        vec.emplace_back(upper.back(), mins, with_hue(maxs, 255));
+    }
+    Kernels::compress_rgb32_to_binary_range(
+        image.data(), image.bytes_per_row(),
+        vec.data(), vec.size()
+    );
+    for (size_t c = 0; c < upper.size(); c++){
+        ret[upper_index[c]] |= upper[c];
+    }
+    return ret;
+}
+
+
+
+PackedBinaryMatrix compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    uint8_t min_hue, uint8_t max_hue,
+    uint8_t min_saturation, uint8_t max_saturation,
+    uint8_t min_value, uint8_t max_value
+){
+    return compress_hsv32_to_binary_range(
+        ImageHSV32(image),
+        min_hue, max_hue,
+        min_saturation, max_saturation,
+        min_value, max_value
+    );
+}
+PackedBinaryMatrix compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    uint32_t mins, uint32_t maxs
+){
+    return compress_hsv32_to_binary_range(ImageHSV32(image), mins, maxs);
+}
+std::vector<PackedBinaryMatrix> compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    const std::vector<std::pair<uint32_t, uint32_t>>& filters
+){
+    return compress_hsv32_to_binary_range(ImageHSV32(image), filters);
+}
+
+
+
+}
@@ -0,0 +1,70 @@
+/*  Binary Image Filter HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Range filters over HSV32 pixels. See "Kernels_ImageHSV.h" for the pixel
+ *  layout. The "mins" and "maxs" parameters are packed the same way as the
+ *  pixels: 0xAAHHSSVV.
+ *
+ *  Hue is circular. If the min hue is greater than the max hue, the range
+ *  wraps around through 0. For example: min = 0xf0, max = 0x10 selects
+ *  [0xf0, 0xff] and [0x00, 0x10], which are the reds.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_BinaryImage_FilterHsv32_H
+#define PokemonAutomation_CommonFramework_BinaryImage_FilterHsv32_H
+
+#include <stdint.h>
+#include <vector>
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/ImageViewHSV32.h"
+#include "CommonFramework/ImageTypes/BinaryImage.h"
+
+namespace PokemonAutomation{
+
+
+
+PackedBinaryMatrix compress_hsv32_to_binary_range(
+    const ImageViewHSV32& image,
+    uint8_t min_hue, uint8_t max_hue,
+    uint8_t min_saturation, uint8_t max_saturation,
+    uint8_t min_value, uint8_t max_value
+);
+PackedBinaryMatrix compress_hsv32_to_binary_range(
+    const ImageViewHSV32& image,
+    uint32_t mins, uint32_t maxs
+);
+
+//  Run multiple filters at once. This is more memory efficient than making
+//  multiple calls to one filter at a time.
+std::vector<PackedBinaryMatrix> compress_hsv32_to_binary_range(
+    const ImageViewHSV32& image,
+    const std::vector<std::pair<uint32_t, uint32_t>>& filters
+);
+
+
+
+//  Same as above, but starting from an RGB image. The image is converted to
+//  HSV once, regardless of how many filters there are.
+//  If you are going to filter the same image again, convert it yourself with
+//  ImageHSV32 and use the above instead.
+PackedBinaryMatrix compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    uint8_t min_hue, uint8_t max_hue,
+    uint8_t min_saturation, uint8_t max_saturation,
+    uint8_t min_value, uint8_t max_value
+);
+PackedBinaryMatrix compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    uint32_t mins, uint32_t maxs
+);
+std::vector<PackedBinaryMatrix> compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    const std::vector<std::pair<uint32_t, uint32_t>>& filters
+);
+
+
+
+}
+#endif
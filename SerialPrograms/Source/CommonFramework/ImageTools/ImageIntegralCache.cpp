@@ -0,0 +1,137 @@
+/*  Image Integral Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Kernels/ImageStats/Kernels_ImageIntegralSumSqr.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "ImageIntegralCache.h"
+
+namespace PokemonAutomation{
+
+
+//  Building the table costs a few passes over the frame. Don't bother unless
+//  the boxes that have been queried add up to a decent fraction of it.
+const size_t BUILD_THRESHOLD_DIVISOR = 4;
+
+//  The 32-bit sums in the table are only exact below this many pixels.
+const size_t MAX_BOX_PIXELS = ((size_t)1 << 32) / 255;
+
+//  Number of tables that are currently built.
+std::atomic<size_t> LIVE_TABLES(0);
+
+
+const size_t ImageIntegralCache::MAX_TABLES;
+
+
+std::shared_ptr<ImageIntegralCache> ImageIntegralCache::make(std::shared_ptr<const ImageRGB32> frame){
+    if (!frame || !*frame){
+        return nullptr;
+    }
+    return std::make_shared<ImageIntegralCache>(std::move(frame));
+}
+
+
+
+ImageIntegralCache::~ImageIntegralCache(){
+    if (m_ready.load(std::memory_order_relaxed)){
+        LIVE_TABLES.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+ImageIntegralCache::ImageIntegralCache(std::shared_ptr<const ImageRGB32> frame)
+    : m_frame(std::move(frame))
+    , m_stride(m_frame->width() + 1)
+    , m_build_threshold(m_frame->width() * m_frame->height() / BUILD_THRESHOLD_DIVISOR)
+    , m_queried_pixels(0)
+    , m_ready(false)
+    , m_gave_up(false)
+{}
+
+
+bool ImageIntegralCache::pixel_sums(Kernels::PixelSums& sums, const ImageViewRGB32& image){
+    const ImageRGB32& frame = *m_frame;
+    size_t bytes_per_row = frame.bytes_per_row();
+    if (image.bytes_per_row() != bytes_per_row){
+        return false;
+    }
+
+    const char* begin = (const char*)frame.data();
+    const char* ptr = (const char*)image.data();
+    if (ptr < begin || ptr >= begin + bytes_per_row * frame.height()){
+        return false;
+    }
+    size_t offset = ptr - begin;
+    if (offset % sizeof(uint32_t) != 0){
+        return false;
+    }
+    size_t y = offset / bytes_per_row;
+    size_t x = offset % bytes_per_row / sizeof(uint32_t);
+    size_t width = image.width();
+    size_t height = image.height();
+    if (width == 0 || height == 0){
+        return false;
+    }
+    if (x + width > frame.width() || y + height > frame.height()){
+        return false;
+    }
+    if (width * height >= MAX_BOX_PIXELS){
+        return false;
+    }
+
+    if (!m_ready.load(std::memory_order_acquire)){
+        size_t queried = m_queried_pixels.fetch_add(width * height, std::memory_order_relaxed);
+        if (queried + width * height < m_build_threshold){
+            return false;
+        }
+
+        //  Someone else is building it. Don't wait for them.
+        std::unique_lock<std::mutex> lg(m_lock, std::try_to_lock);
+        if (!lg.owns_lock() || m_gave_up){
+            return false;
+        }
+        if (!m_ready.load(std::memory_order_acquire)){
+            if (!build()){
+                return false;
+            }
+            m_ready.store(true, std::memory_order_release);
+        }
+    }
+
+    Kernels::integral_sum_sqr_lookup(
+        sums,
+        (const uint32_t*)m_sums.data(), (const uint64_t*)m_sqrs.data(), m_stride,
+        x, y, width, height
+    );
+    return true;
+}
+bool ImageIntegralCache::build(){
+    //  Claim a slot. If they're all taken, this frame does without.
+    size_t live = LIVE_TABLES.load(std::memory_order_relaxed);
+    do{
+        if (live >= MAX_TABLES){
+            m_gave_up = true;
+            return false;
+        }
+    }while (!LIVE_TABLES.compare_exchange_weak(live, live + 1, std::memory_order_relaxed));
+
+    const ImageRGB32& frame = *m_frame;
+    size_t entries = m_stride * (frame.height() + 1);
+    try{
+        m_sums = PooledBuffer(entries * 4 * sizeof(uint32_t));
+        m_sqrs = PooledBuffer(entries * 3 * sizeof(uint64_t));
+    }catch (...){
+        LIVE_TABLES.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+    Kernels::build_integral_sum_sqr(
+        (uint32_t*)m_sums.data(), (uint64_t*)m_sqrs.data(), m_stride,
+        frame.width(), frame.height(),
+        frame.data(), frame.bytes_per_row()
+    );
+    return true;
+}
+
+
+
+}
@@ -0,0 +1,86 @@
+/*  Image Integral Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A lazily built summed-area table of a video frame.
+ *
+ *  Detectors check the color stats of many small boxes of the same frame.
+ *  Once enough pixels of a frame have been queried, a summed-area table is
+ *  built for the whole frame. After that, the stats of any box of the frame
+ *  are O(1) lookups.
+ *
+ *  Each frame gets one cache, made along with its VideoSnapshot. The video
+ *  backends hand out copies of the same snapshot for the same frame, so
+ *  every callback looking at a frame shares its table. The cache owns a
+ *  reference to the frame. The views a snapshot hands out, and every
+ *  sub-image cropped from them, own a reference to the cache. So the table
+ *  and the pixels it was built from stay alive as long as any view does.
+ *  "image_stats()" and friends use the cache of the view they are given.
+ *  Views that have no cache sum the pixels directly.
+ *
+ *  The tables are large. (about 80 MB for a 1080p frame) So only a few of
+ *  them may exist at once. If the limit is reached, frames fall back to
+ *  summing the pixels directly.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImageIntegralCache_H
+#define PokemonAutomation_CommonFramework_ImageIntegralCache_H
+
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include "Common/Cpp/Containers/AlignedBufferPool.h"
+
+namespace PokemonAutomation{
+
+namespace Kernels{
+    struct PixelSums;
+}
+class ImageViewRGB32;
+class ImageRGB32;
+
+
+class ImageIntegralCache{
+public:
+    //  The most tables that may be built at the same time.
+    static const size_t MAX_TABLES = 4;
+
+    //  Returns null if "frame" is empty.
+    static std::shared_ptr<ImageIntegralCache> make(std::shared_ptr<const ImageRGB32> frame);
+
+
+public:
+    ~ImageIntegralCache();
+    ImageIntegralCache(const ImageIntegralCache&) = delete;
+    void operator=(const ImageIntegralCache&) = delete;
+
+    ImageIntegralCache(std::shared_ptr<const ImageRGB32> frame);
+
+    //  If "image" lies within the frame and the table is (or can now be)
+    //  built, add its pixel sums to "sums" and return true. Otherwise return
+    //  false and leave "sums" untouched.
+    bool pixel_sums(Kernels::PixelSums& sums, const ImageViewRGB32& image);
+
+private:
+    bool build();
+
+private:
+    const std::shared_ptr<const ImageRGB32> m_frame;
+    const size_t m_stride;
+
+    //  Don't build the table until this many pixels have been queried.
+    const size_t m_build_threshold;
+    std::atomic<size_t> m_queried_pixels;
+
+    std::mutex m_lock;
+    std::atomic<bool> m_ready;
+    bool m_gave_up;
+    PooledBuffer m_sums;
+    PooledBuffer m_sqrs;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,51 @@
+/*  Image Scaler
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "ImageScaler.h"
+
+namespace PokemonAutomation{
+
+
+
+ImageScaler::ImageScaler(size_t width, size_t height, ImageScaleMode mode)
+    : m_width(width)
+    , m_height(height)
+    , m_mode(mode)
+{}
+ImageScaler::~ImageScaler() = default;
+
+
+const Kernels::ImageScalePlan& ImageScaler::plan(size_t in_width, size_t in_height){
+    if (!m_plan || m_plan->in_width() != in_width || m_plan->in_height() != in_height){
+        m_plan.reset(new Kernels::ImageScalePlan(in_width, in_height, m_width, m_height, m_mode));
+    }
+    return *m_plan;
+}
+
+
+ImageRGB32 ImageScaler::scale(const ImageViewRGB32& image){
+    ImageRGB32 ret;
+    scale(ret, image);
+    return ret;
+}
+void ImageScaler::scale(ImageRGB32& out, const ImageViewRGB32& image){
+    if (!image || m_width == 0 || m_height == 0){
+        out = ImageRGB32();
+        return;
+    }
+    if (out.width() != m_width || out.height() != m_height){
+        out = ImageRGB32(m_width, m_height);
+    }
+    plan(image.width(), image.height()).scale(
+        image.data(), image.bytes_per_row(),
+        out.data(), out.bytes_per_row()
+    );
+}
+
+
+
+}
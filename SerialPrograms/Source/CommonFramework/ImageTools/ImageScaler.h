@@ -0,0 +1,56 @@
+/*  Image Scaler
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Scale many images to the same output size.
+ *
+ *  The sampling plan is cached and only rebuilt when the input dimensions
+ *  change. So this is cheaper than ImageViewRGB32::scale_to() when scaling
+ *  many crops of the same size. (such as template matching candidates)
+ *
+ *  This class is not thread-safe. Use one per thread.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImageScaler_H
+#define PokemonAutomation_CommonFramework_ImageScaler_H
+
+#include <memory>
+#include "Kernels/ImageScale/Kernels_ImageScale.h"
+
+namespace PokemonAutomation{
+
+class ImageViewRGB32;
+class ImageRGB32;
+
+using ImageScaleMode = Kernels::ImageScaleMode;
+
+
+class ImageScaler{
+public:
+    ImageScaler(size_t width, size_t height, ImageScaleMode mode = ImageScaleMode::NEAREST);
+    ~ImageScaler();
+
+    size_t width() const{ return m_width; }
+    size_t height() const{ return m_height; }
+
+    ImageRGB32 scale(const ImageViewRGB32& image);
+
+    //  Scale into "out". If "out" already has the right dimensions, its
+    //  buffer is reused. Otherwise it is reallocated.
+    void scale(ImageRGB32& out, const ImageViewRGB32& image);
+
+private:
+    const Kernels::ImageScalePlan& plan(size_t in_width, size_t in_height);
+
+private:
+    size_t m_width;
+    size_t m_height;
+    ImageScaleMode m_mode;
+    std::unique_ptr<Kernels::ImageScalePlan> m_plan;
+};
+
+
+
+}
+#endif
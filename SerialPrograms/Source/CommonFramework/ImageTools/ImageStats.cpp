@@ -9,6 +9,7 @@
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "ImageBoxes.h"
+#include "ImageIntegralCache.h"
 #include "ImageStats.h"
 
 #include <iostream>
@@ -19,25 +20,31 @@ namespace PokemonAutomation{
 
 
 
-FloatPixel image_average(const ImageViewRGB32& image){
+//  If the image is part of a video snapshot, use its summed-area table.
+static Kernels::PixelSums pixel_sums(const ImageViewRGB32& image){
     Kernels::PixelSums sums;
+    ImageIntegralCache* cache = image.integral_cache();
+    if (cache != nullptr && cache->pixel_sums(sums, image)){
+        return sums;
+    }
     Kernels::pixel_sum_sqr(
         sums, image.width(), image.height(),
         image.data(), image.bytes_per_row(),
         image.data(), image.bytes_per_row()
     );
+    return sums;
+}
+
+
+FloatPixel image_average(const ImageViewRGB32& image){
+    Kernels::PixelSums sums = pixel_sums(image);
 
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
 
     return sum / (double)sums.count;
 }
 FloatPixel image_stddev(const ImageViewRGB32& image){
-    Kernels::PixelSums sums;
-    Kernels::pixel_sum_sqr(
-        sums, image.width(), image.height(),
-        image.data(), image.bytes_per_row(),
-        image.data(), image.bytes_per_row()
-    );
+    Kernels::PixelSums sums = pixel_sums(image);
 
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
     FloatPixel sqr((double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB);
@@ -51,12 +58,7 @@ FloatPixel image_stddev(const ImageViewRGB32& image){
     );
 }
 ImageStats image_stats(const ImageViewRGB32& image){
-    Kernels::PixelSums sums;
-    Kernels::pixel_sum_sqr(
-        sums, image.width(), image.height(),
-        image.data(), image.bytes_per_row(),
-        image.data(), image.bytes_per_row()
-    );
+    Kernels::PixelSums sums = pixel_sums(image);
 
     FloatPixel sum((double)sums.sumR, (double)sums.sumG, (double)sums.sumB);
     FloatPixel sqr((double)sums.sqrR, (double)sums.sqrG, (double)sums.sqrB);
@@ -6,7 +6,9 @@
 
 #include <map>
 #include "Common/Cpp/Color.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
+#include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Types.h"
 #include "CommonFramework/ImageMatch/WaterfillTemplateMatcher.h"
@@ -69,6 +71,50 @@ std::pair<PackedBinaryMatrix, size_t> remove_center_pixels(
     return std::pair<PackedBinaryMatrix, size_t>(std::move(matrix), distance_sqr_th);
 }
 
+namespace{
+
+AsyncDispatcher& waterfill_dispatcher(){
+    static AsyncDispatcher dispatcher(
+        [](){ GlobalSettings::instance().COMPUTE_PRIORITY0.set_on_this_thread(); },
+        0
+    );
+    return dispatcher;
+}
+
+}
+
+std::vector<Kernels::Waterfill::WaterfillObject> find_objects_inplace_parallel(PackedBinaryMatrix& matrix, size_t min_area){
+    return Kernels::Waterfill::find_objects_inplace(waterfill_dispatcher(), matrix, min_area);
+}
+
+bool find_objects_multirange(
+    const ImageViewRGB32& image,
+    const std::vector<std::pair<uint32_t, uint32_t>>& filters,
+    size_t min_area, bool keep_objects,
+    const std::function<bool(size_t filter_index, Kernels::Waterfill::WaterfillObject& object)>& on_object
+){
+    if (filters.empty()){
+        return false;
+    }
+
+    //  One pass over the image for all the filters.
+    std::vector<PackedBinaryMatrix> matrices = compress_rgb32_to_binary_range(image, filters);
+
+    //  Reuse the same session (and its internal buffers) for every matrix.
+    std::unique_ptr<Kernels::Waterfill::WaterfillSession> session = Kernels::Waterfill::make_WaterfillSession();
+    Kernels::Waterfill::WaterfillObject object;
+    for (size_t c = 0; c < matrices.size(); c++){
+        session->set_source(matrices[c]);
+        auto finder = session->make_iterator(min_area);
+        while (finder->find_next(object, keep_objects)){
+            if (on_object(c, object)){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 bool match_template_by_waterfill(
     const ImageViewRGB32 &image,
     const ImageMatch::WaterfillTemplateMatcher &matcher,
@@ -88,24 +134,18 @@ bool match_template_by_waterfill(
         }
         std::cout << ")" << std::endl;
     }
-    auto matrices = compress_rgb32_to_binary_range(image, filters);
 
     bool detected = false;
-    bool stop_match = false;
-    for(PokemonAutomation::PackedBinaryMatrix &matrix : matrices){
-        std::unique_ptr<Kernels::Waterfill::WaterfillSession> session = Kernels::Waterfill::make_WaterfillSession();
-        Kernels::Waterfill::WaterfillObject object;
-        const size_t min_area = area_thresholds.first;
-        session->set_source(matrix);
-        auto finder = session->make_iterator(min_area);
-        const bool keep_object_matrix = false;
-        while (finder->find_next(object, keep_object_matrix)){
+    const bool keep_object_matrix = false;
+    find_objects_multirange(
+        image, filters, area_thresholds.first, keep_object_matrix,
+        [&](size_t, Kernels::Waterfill::WaterfillObject& object){
             if (PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING){
                 std::cout << "Object area: " << object.area << std::endl;
             }
 
             if (object.area > area_thresholds.second){
-                continue;
+                return false;
             }
             double rmsd = matcher.rmsd_original(image, object);
             if (PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING){
@@ -114,18 +154,12 @@ bool match_template_by_waterfill(
 
             if (rmsd < rmsd_threshold){
                 detected = true;
-                
-                if (check_matched_object(object)){
-                    stop_match = true;
-                    break;
-                }
+                return check_matched_object(object);
             }
+            return false;
         }
+    );
 
-        if (stop_match){
-            break;
-        }
-    }
     if (PreloadSettings::debug().IMAGE_TEMPLATE_MATCHING){
         std::cout << "End match template by waterfill" << std::endl;
     }
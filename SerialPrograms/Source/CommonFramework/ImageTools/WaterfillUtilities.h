@@ -10,6 +10,7 @@
 
 #include <functional>
 #include <utility>
+#include <vector>
 #include "CommonFramework/ImageTypes/BinaryImage.h"
 
 namespace PokemonAutomation{
@@ -40,6 +41,29 @@ std::pair<PackedBinaryMatrix, size_t> remove_center_pixels(
     size_t num_removed_pixels_threshold
 );
 
+// Find all the waterfill objects of `matrix` with at least `min_area` pixels. This destroys `matrix`.
+// The result is the same as Kernels::Waterfill::find_objects_inplace(), in the same order. Full-frame matrices are split
+// into horizontal bands that are waterfilled in parallel on a compute thread pool owned by this function. That pool is
+// separate from the inference dispatcher so that inference callbacks can use this without waiting on their own pool.
+std::vector<Kernels::Waterfill::WaterfillObject> find_objects_inplace_parallel(PackedBinaryMatrix& matrix, size_t min_area);
+
+// Run multiple color filters over an image and call `on_object()` on each waterfill object as soon as it is found.
+// The filters are applied by compress_rgb32_to_binary_range(), then one waterfill session is reused for all of the
+// resulting matrices.
+//
+// filters: each filter is parameterized by min and max color thresholds for detected pixels.
+// min_area: objects with fewer pixels than this are skipped.
+// keep_objects: if true, WaterfillObject.object is constructed for each object.
+// `filter_index` is the index into `filters` of the filter that produced the object.
+// If `on_object()` returns true, stop the search immediately.
+// Return true if the search was stopped by `on_object()`.
+bool find_objects_multirange(
+    const ImageViewRGB32& image,
+    const std::vector<std::pair<uint32_t, uint32_t>>& filters,
+    size_t min_area, bool keep_objects,
+    const std::function<bool(size_t filter_index, Kernels::Waterfill::WaterfillObject& object)>& on_object
+);
+
 // Given an image first run waterfill (aka use a color filter) on it to detect pixels of a color range. Then for each connected
 // componet of the detected pixel region (aka waterfill object), we check if the object is close to an image template by
 // checking aspect ratio thresholds, area thresholds and RMSD threshold.
@@ -8,17 +8,18 @@
 #include <QImage>
 #include "Common/Cpp/Containers/Pimpl.tpp"
 #include "Common/Cpp/Exceptions.h"
-#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Common/Cpp/Containers/AlignedBufferPool.h"
 #include "ImageViewRGB32.h"
 #include "ImageRGB32.h"
 
 namespace PokemonAutomation{
 
 struct ImageRGB32::Data{
-    AlignedVector<uint32_t> self;
+    //  Frame-sized buffers are recycled through the global buffer pool.
+    PooledBuffer self;
     QImage qimage;
 
-    Data(size_t items) : self(items) {}
+    Data(size_t bytes) : self(bytes) {}
     Data(QImage image) : qimage(std::move(image)) {}
 };
 
@@ -52,9 +53,9 @@ ImageRGB32::ImageRGB32() = default;
 
 ImageRGB32::ImageRGB32(size_t width, size_t height)
     : ImageViewRGB32(width, height)
-    , m_data(CONSTRUCT_TOKEN, m_bytes_per_row / sizeof(uint32_t) * height)
+    , m_data(CONSTRUCT_TOKEN, m_bytes_per_row * height)
 {
-    m_ptr = m_data->self.data();
+    m_ptr = (uint32_t*)m_data->self.data();
 }
 ImageRGB32::ImageRGB32(const std::string& filename){
     QImage image(QString::fromStdString(filename));
@@ -6,6 +6,7 @@
 
 #include <QImage>
 #include "Common/Cpp/Exceptions.h"
+#include "Kernels/ImageScale/Kernels_ImageScale.h"
 #include "ImageRGB32.h"
 #include "ImageViewRGB32.h"
 
@@ -26,7 +27,22 @@ bool ImageViewRGB32::save(const std::string& path) const{
     return to_QImage_ref().save(QString::fromStdString(path));
 }
 ImageRGB32 ImageViewRGB32::scale_to(size_t width, size_t height) const{
-    return scaled_to_QImage(width, height);
+    return scale_to(width, height, Kernels::ImageScaleMode::NEAREST);
+}
+ImageRGB32 ImageViewRGB32::scale_to(size_t width, size_t height, Kernels::ImageScaleMode mode) const{
+    if (m_ptr == nullptr || width == 0 || height == 0){
+        return ImageRGB32();
+    }
+    if (m_width == width && m_height == height){
+        return copy();
+    }
+    ImageRGB32 ret(width, height);
+    Kernels::scale_image(
+        m_ptr, m_bytes_per_row, m_width, m_height,
+        ret.data(), ret.bytes_per_row(), width, height,
+        mode
+    );
+    return ret;
 }
 
 
@@ -9,14 +9,19 @@
 
 #include <opencv2/core/mat.hpp>
 #include <string>
+#include <memory>
 #include "ImageViewPlanar32.h"
 
 class QImage;
 
 namespace PokemonAutomation{
+namespace Kernels{
+    enum class ImageScaleMode;
+}
 
 
 class ImageRGB32;
+class ImageIntegralCache;
 
 
 class ImageViewRGB32 : public ImageViewPlanar32{
@@ -38,13 +43,32 @@ public:
     }
 
     PA_FORCE_INLINE ImageViewRGB32 sub_image(size_t min_x, size_t min_y, size_t width, size_t height) const{
-        return ImageViewPlanar32::sub_image(min_x, min_y, width, height);
+        ImageViewRGB32 ret = ImageViewPlanar32::sub_image(min_x, min_y, width, height);
+        ret.m_integral = m_integral;
+        return ret;
+    }
+
+public:
+    //  The summed-area table of the frame this view is part of. (see
+    //  ImageIntegralCache) Sub-images keep it. Null if there isn't one.
+    ImageIntegralCache* integral_cache() const{ return m_integral.get(); }
+
+    //  Return a copy of this view that uses "cache". "cache" must belong to
+    //  the frame that this view points into. The view keeps the cache alive,
+    //  and the cache keeps the frame alive.
+    ImageViewRGB32 with_integral_cache(std::shared_ptr<ImageIntegralCache> cache) const{
+        ImageViewRGB32 ret(*this);
+        ret.m_integral = std::move(cache);
+        return ret;
     }
 
 public:
     ImageRGB32 copy() const;
     bool save(const std::string& path) const;
+
+    //  Scale with nearest-neighbor sampling. (see ImageScaleMode::NEAREST)
     ImageRGB32 scale_to(size_t width, size_t height) const;
+    ImageRGB32 scale_to(size_t width, size_t height, Kernels::ImageScaleMode mode) const;
 
 public:
     //  QImage
@@ -60,6 +84,9 @@ private:
     PA_FORCE_INLINE ImageViewRGB32(const ImageViewPlanar32& x)
         : ImageViewPlanar32(x)
     {}
+
+private:
+    std::shared_ptr<ImageIntegralCache> m_integral;
 };
 
 
@@ -59,13 +59,9 @@ void AudioPerSpectrumDetectorBase::log_results(){
 }
 
 bool AudioPerSpectrumDetectorBase::process_spectrums(
-    const std::vector<AudioSpectrum>& newSpectrums,
+    const std::vector<AudioSpectrum>&,
     AudioFeed& audioFeed
 ){
-    if (newSpectrums.empty()){
-        return false;
-    }
-
     WallClock now = current_time();
 
     //  Clear last detection.
@@ -74,16 +70,20 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
         m_last_reported = false;
     }
 
-    const size_t sampleRate = newSpectrums[0].sample_rate;
-    // Lazy intialization of the spectrogram matcher.
-    if (m_matcher == nullptr || m_matcher->sampleRate() != sampleRate){
-        m_console.log("Loading spectrogram...");
-        m_matcher = build_spectrogram_matcher(sampleRate);
+    // Lazy intialization of the subscription. The matcher is built by the bank
+    // once the sample rate is known, and rebuilt when the sample rate changes.
+    if (m_subscription == nullptr){
+        m_subscription.reset(new AudioTemplateBank::Subscription(
+            audioFeed,
+            [this](size_t sampleRate){
+                m_console.log("Loading spectrogram...");
+                return build_spectrogram_matcher(sampleRate);
+            }
+        ));
     }
 
-    // Feed spectrum one by one to the matcher:
-    // newSpectrums are ordered from newest (largest timestamp) to oldest (smallest timestamp).
-    // To feed the spectrum from old to new, we need to go through the vector in the reverse order:
+    // The matches are ordered from oldest to newest.
+    const std::vector<AudioTemplateBank::Match> matches = m_subscription->poll();
 
 
 //#define PA_DEBUG_FORCE_PLA_SOUND
@@ -96,21 +96,16 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
     
     bool found = false;
     const float threshold = get_score_threshold();
-    for(auto it = newSpectrums.rbegin(); it != newSpectrums.rend(); it++){
-        std::vector<AudioSpectrum> singleSpectrum = {*it};
-        const float matcherScore = m_matcher->match(singleSpectrum);
+    for (const AudioTemplateBank::Match& match : matches){
+        const float matcherScore = match.score;
         // std::cout << "error: " << matcherScore << std::endl;
 
-        if (matcherScore == FLT_MAX){
-            continue; // error or not enough spectrum history
-        }
-
         // Record the lowest error found during the run
         m_lowest_error = std::min(m_lowest_error, matcherScore);
 
         found = matcherScore <= threshold;
 
-        uint64_t curStamp = m_matcher->latestTimestamp();
+        uint64_t curStamp = match.stamp;
 
 #ifdef PA_DEBUG_FORCE_PLA_SOUND
         if (debug_count % 300 > 300 - 5){
@@ -129,20 +124,11 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
             m_last_error = std::min(m_last_error, matcherScore);
 
             std::ostringstream os;
-            os << m_audio_name << " found, score " << matcherScore << "/" << threshold << ", scale: " << m_matcher->lastMatchedScale();
+            os << m_audio_name << " found, score " << matcherScore << "/" << threshold << ", scale: " << match.scale;
             m_console.log(os.str(), COLOR_BLUE);
-            audioFeed.add_overlay(curStamp+1-m_matcher->numMatchedWindows(), curStamp+1, m_detection_color);
-
-            // Since the target audio is found, no need to check detection on the rest of the spectrums in `newSpectrums`.
+            audioFeed.add_overlay(curStamp+1-match.num_windows, curStamp+1, m_detection_color);
 
-            // Tell m_matcher to skip the remaining spectrums so that if `process_spectrums()` gets
-            // called again on a newer batch of spectrums, m_matcher is happy.
-            m_matcher->skip(std::vector<AudioSpectrum>(
-                newSpectrums.begin(),
-                newSpectrums.begin() + std::distance(it + 1, newSpectrums.rend())
-            ));
-
-            // Skip the remaining spectrums.
+            // Since the target audio is found, no need to check detection on the rest of the matches.
             break;
         }
     }
@@ -172,7 +158,9 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
 }
 
 void AudioPerSpectrumDetectorBase::clear(){
-    m_matcher->clear();
+    if (m_subscription){
+        m_subscription->clear();
+    }
 }
 
 
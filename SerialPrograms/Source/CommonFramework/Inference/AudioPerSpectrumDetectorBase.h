@@ -23,6 +23,10 @@
  *  This is opposite to the other design choice that only matches the audio starting at the newest
  *  spectrum in `newSpectrums` when called. That design choice is better suited to non-time-critical
  *  audio matching and the matching algorithm can tolerate a few spectrums off on time axis.
+ *
+ *  The matcher is not run by the detector itself. It is subscribed to the AudioTemplateBank
+ *  of the audio feed so that all the detectors running on the same feed share the spectrum
+ *  history and each spectrum is filtered only once.
  */
 
 #ifndef PokemonAutomation_CommonFramework_AudioPerSpectrumDetectorBase_H
@@ -35,6 +39,7 @@
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "CommonFramework/InferenceInfra/AudioInferenceCallback.h"
+#include "AudioTemplateBank.h"
 
 namespace PokemonAutomation{
 
@@ -72,6 +77,8 @@ public:
     virtual float get_score_threshold() const = 0;
 
     // Implement AudioInferenceCallback::process_spectrums()
+    // The spectrums are pulled from `audioFeed` through its AudioTemplateBank, so all the
+    // spectrums since the last call are matched even if `newSpectrums` doesn't have them.
     virtual bool process_spectrums(
         const std::vector<AudioSpectrum>& newSpectrums,
         AudioFeed& audioFeed
@@ -117,7 +124,8 @@ protected:
     // so that the detector will not count the same detected audio multiple times.
     bool m_last_reported = false;
     
-    std::unique_ptr<SpectrogramMatcher> m_matcher;
+    // Subscription of the spectrogram matcher to the template bank of the audio feed.
+    std::unique_ptr<AudioTemplateBank::Subscription> m_subscription;
 
 };
 
@@ -0,0 +1,202 @@
+/*  Audio Template Bank
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cfloat>
+#include <deque>
+#include <map>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "SpectrogramMatcher.h"
+#include "AudioTemplateBank.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+//  If a subscriber stops polling, drop its oldest matches beyond this.
+const size_t MAX_PENDING_MATCHES = 1000;
+
+
+struct AudioTemplateBank::Entry{
+    MatcherFactory factory;
+    std::unique_ptr<SpectrogramMatcher> matcher;
+    std::deque<Match> pending;
+
+    Entry(MatcherFactory p_factory)
+        : factory(std::move(p_factory))
+    {}
+};
+
+
+struct AudioTemplateBankRegistry{
+    static AudioTemplateBankRegistry& instance(){
+        static AudioTemplateBankRegistry registry;
+        return registry;
+    }
+
+    SpinLock m_lock;
+    std::map<AudioFeed*, std::weak_ptr<AudioTemplateBank>> m_banks;
+};
+
+
+
+std::shared_ptr<AudioTemplateBank> AudioTemplateBank::get(AudioFeed& feed){
+    AudioTemplateBankRegistry& registry = AudioTemplateBankRegistry::instance();
+    SpinLockGuard lg(registry.m_lock);
+    std::weak_ptr<AudioTemplateBank>& slot = registry.m_banks[&feed];
+    std::shared_ptr<AudioTemplateBank> ret = slot.lock();
+    if (!ret){
+        ret.reset(new AudioTemplateBank(feed));
+        slot = ret;
+    }
+    return ret;
+}
+AudioTemplateBank::AudioTemplateBank(AudioFeed& feed)
+    : m_feed(feed)
+{}
+AudioTemplateBank::~AudioTemplateBank(){
+    AudioTemplateBankRegistry& registry = AudioTemplateBankRegistry::instance();
+    SpinLockGuard lg(registry.m_lock);
+    auto iter = registry.m_banks.find(&m_feed);
+    //  Another bank may have already replaced this one for the same feed.
+    if (iter != registry.m_banks.end() && iter->second.expired()){
+        registry.m_banks.erase(iter);
+    }
+}
+
+
+void AudioTemplateBank::regroup(){
+    m_groups.clear();
+    for (Entry* entry : m_entries){
+        if (entry->matcher == nullptr){
+            continue;
+        }
+        bool grouped = false;
+        for (std::vector<Entry*>& group : m_groups){
+            if (group[0]->matcher->sameFilter(*entry->matcher)){
+                group.emplace_back(entry);
+                grouped = true;
+                break;
+            }
+        }
+        if (!grouped){
+            m_groups.emplace_back(std::vector<Entry*>{entry});
+        }
+    }
+}
+
+void AudioTemplateBank::update(Entry& caller){
+    std::vector<AudioSpectrum> spectrums;
+    if (m_last_seqnum == ~(uint64_t)0){
+        spectrums = m_feed.spectrums_latest(1);
+    }else{
+        spectrums = m_feed.spectrums_since(m_last_seqnum + 1);
+    }
+
+    //  spectrums[0] has the newest spectrum with the largest stamp.
+    if (!spectrums.empty() && spectrums[0].sample_rate != m_sampleRate){
+        //  The matchers are built for a specific sample rate. Drop all of them
+        //  and let each subscriber rebuild its own in its next poll.
+        m_sampleRate = spectrums[0].sample_rate;
+        for (Entry* entry : m_entries){
+            entry->matcher.reset();
+        }
+        m_groups.clear();
+    }
+    if (caller.matcher == nullptr && m_sampleRate != 0){
+        //  If this throws, the spectrums are left in the feed for the next poll.
+        caller.matcher = caller.factory(m_sampleRate);
+        regroup();
+    }
+
+    if (spectrums.empty()){
+        return;
+    }
+    m_last_seqnum = spectrums[0].stamp;
+
+    //  Feed the spectrums from oldest to newest.
+    for (auto it = spectrums.rbegin(); it != spectrums.rend(); ++it){
+        process(*it);
+    }
+}
+
+void AudioTemplateBank::process(const AudioSpectrum& spectrum){
+    if (spectrum.sample_rate != m_sampleRate){
+        return;
+    }
+
+    std::vector<AudioSpectrum> single = {spectrum};
+    for (const std::vector<Entry*>& group : m_groups){
+        const SpectrogramMatcher& source = *group[0]->matcher;
+        for (Entry* entry : group){
+            SpectrogramMatcher& matcher = *entry->matcher;
+
+            //  Only the first matcher of the group filters the spectrum.
+            //  The rest take the filtered spectrum from it.
+            float score = entry == group[0]
+                ? matcher.match(single)
+                : matcher.match(source);
+            if (score == FLT_MAX){
+                continue;   // error or not enough spectrum history
+            }
+
+            if (entry->pending.size() >= MAX_PENDING_MATCHES){
+                entry->pending.pop_front();
+            }
+            entry->pending.emplace_back(Match{
+                matcher.latestTimestamp(),
+                score,
+                matcher.lastMatchedScale(),
+                matcher.numMatchedWindows(),
+            });
+        }
+    }
+}
+
+
+
+AudioTemplateBank::Subscription::Subscription(AudioFeed& feed, MatcherFactory factory)
+    : m_bank(AudioTemplateBank::get(feed))
+    , m_entry(new Entry(std::move(factory)))
+{
+    std::lock_guard<std::mutex> lg(m_bank->m_lock);
+    m_bank->m_entries.emplace_back(m_entry.get());
+}
+AudioTemplateBank::Subscription::~Subscription(){
+    std::lock_guard<std::mutex> lg(m_bank->m_lock);
+    std::vector<Entry*>& entries = m_bank->m_entries;
+    for (auto iter = entries.begin(); iter != entries.end(); ++iter){
+        if (*iter == m_entry.get()){
+            entries.erase(iter);
+            break;
+        }
+    }
+    m_bank->regroup();
+}
+
+std::vector<AudioTemplateBank::Match> AudioTemplateBank::Subscription::poll(){
+    std::lock_guard<std::mutex> lg(m_bank->m_lock);
+    m_bank->update(*m_entry);
+    std::vector<Match> ret(m_entry->pending.begin(), m_entry->pending.end());
+    m_entry->pending.clear();
+    return ret;
+}
+void AudioTemplateBank::Subscription::clear(){
+    std::lock_guard<std::mutex> lg(m_bank->m_lock);
+    if (m_entry->matcher){
+        m_entry->matcher->clear();
+    }
+    m_entry->pending.clear();
+}
+
+
+
+
+}
@@ -0,0 +1,112 @@
+/*  Audio Template Bank
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Share one spectrum history among all the audio template matchers running
+ *  on the same audio feed.
+ *
+ *  Each AudioFeed has at most one bank. The bank pulls each new spectrum from
+ *  the feed once, filters it once for each distinct spectrogram filter, and runs
+ *  every subscribed SpectrogramMatcher on it in a single pass. Detectors subscribe
+ *  with the matcher of the template they care about and read back the match
+ *  results of the spectrums they haven't seen yet.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_AudioTemplateBank_H
+#define PokemonAutomation_CommonFramework_AudioTemplateBank_H
+
+#include <stdint.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace PokemonAutomation{
+
+class AudioFeed;
+class AudioSpectrum;
+class SpectrogramMatcher;
+
+
+class AudioTemplateBank{
+public:
+    // Build the matcher of a subscriber for a sample rate.
+    // Called again when the sample rate of the audio feed changes.
+    // This is only ever called from the subscriber's own `Subscription::poll()`.
+    using MatcherFactory = std::function<std::unique_ptr<SpectrogramMatcher>(size_t sampleRate)>;
+
+    // Result of matching a template against the spectrums ending at `stamp`.
+    struct Match{
+        uint64_t stamp;
+        float score;
+        float scale;
+        // How many spectrums are matched, ending at `stamp`.
+        size_t num_windows;
+    };
+
+    class Subscription;
+
+    // Get the bank of `feed`. Create one if there isn't one yet.
+    // The bank is destroyed when the last reference goes away.
+    static std::shared_ptr<AudioTemplateBank> get(AudioFeed& feed);
+
+    ~AudioTemplateBank();
+
+private:
+    struct Entry;
+
+    AudioTemplateBank(AudioFeed& feed);
+
+    // Pull new spectrums from the audio feed and match them against all
+    // subscribed templates. `caller` is the entry of the subscriber polling.
+    // Must hold `m_lock`.
+    void update(Entry& caller);
+
+    // Match one spectrum against all subscribed templates. Must hold `m_lock`.
+    void process(const AudioSpectrum& spectrum);
+
+    // Group the entries by spectrogram filter. Must hold `m_lock`.
+    void regroup();
+
+private:
+    AudioFeed& m_feed;
+
+    std::mutex m_lock;
+    uint64_t m_last_seqnum = ~(uint64_t)0;
+    size_t m_sampleRate = 0;
+
+    std::vector<Entry*> m_entries;
+    // Entries with a matcher, grouped by spectrogram filter.
+    // The first entry of each group filters each spectrum for the rest of the group.
+    std::vector<std::vector<Entry*>> m_groups;
+};
+
+
+
+// A subscription of a template matcher to the bank of an audio feed.
+class AudioTemplateBank::Subscription{
+public:
+    Subscription(AudioFeed& feed, MatcherFactory factory);
+    ~Subscription();
+    Subscription(const Subscription&) = delete;
+    void operator=(const Subscription&) = delete;
+
+    // Match all the new spectrums in the audio feed and return the valid matches of
+    // this subscriber since the last call, ordered from oldest to newest.
+    // Throws if the matcher factory throws.
+    std::vector<Match> poll();
+
+    // Clear the spectrum history and pending matches of this subscriber.
+    void clear();
+
+private:
+    std::shared_ptr<AudioTemplateBank> m_bank;
+    std::unique_ptr<Entry> m_entry;
+};
+
+
+
+
+}
+#endif
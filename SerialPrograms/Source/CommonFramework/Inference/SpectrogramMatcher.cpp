@@ -2,10 +2,12 @@
 
 #include <cfloat>
 #include <cmath>
+#include <string.h>
 #include <iostream>
 #include <fstream>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Kernels/Kernels_Alignment.h"
 #include "Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.h"
 #include "Kernels/SpikeConvolution/Kernels_SpikeConvolution.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
@@ -140,13 +142,19 @@ SpectrogramMatcher::SpectrogramMatcher(
     }
 
     m_templateNorm = buildTemplateNorm();
+
+    // Same stride as the template windows so that the matched pointers have the same alignment.
+    m_ringStride = Kernels::align_int_up<PA_ALIGNMENT>(m_template.numFrequencies() * sizeof(float)) / sizeof(float);
+    m_ring = AlignedVector<float>(m_numSpectrumsNeeded * m_ringStride);
+    m_ringStamps.resize(m_numSpectrumsNeeded);
+    m_ringNormSqrs.resize(m_numSpectrumsNeeded);
 }
 
 uint64_t SpectrogramMatcher::latestTimestamp() const{
-    if (m_spectrums.size() == 0){
+    if (m_ringCount == 0){
         return SIZE_MAX;
     }
-    return m_spectrums.front().stamp;
+    return m_ringStamps[m_ringHead];
 }
 
 void SpectrogramMatcher::conv(const float* src, size_t num, float* dst){
@@ -189,138 +197,100 @@ std::vector<float> SpectrogramMatcher::buildTemplateNorm() const {
     return ret;
 }
 
-bool SpectrogramMatcher::updateToNewSpectrum(AudioSpectrum spectrum){
+bool SpectrogramMatcher::updateToNewSpectrum(const AudioSpectrum& spectrum){
     if (m_numOriginalFrequencies != spectrum.magnitudes->size()){
         std::cout << "Error: number of frequencies don't match in SpectrogramMatcher::match() " << 
             m_numOriginalFrequencies << " " << spectrum.magnitudes->size() << std::endl;
         return false;
     }
+    if (m_numSpectrumsNeeded == 0){
+        return false;
+    }
+
+    // Overwrite the oldest slot.
+    const size_t slot = (m_ringHead + 1) % m_numSpectrumsNeeded;
+    float* dst = ringSpectrum(slot);
+    const float* src = spectrum.magnitudes->data();
 
     switch(m_mode){
     case Mode::SPIKE_CONV:
-    {
         // Do the conv on new spectrum too.
-        AlignedVector<float> convedSpectrum(m_template.bufferSize());
-        conv(spectrum.magnitudes->data() + m_originalFreqStart,
-            m_originalFreqEnd - m_originalFreqStart, convedSpectrum.data());
-        
-        spectrum.magnitudes = std::make_unique<AlignedVector<float>>(std::move(convedSpectrum));
+        conv(src + m_originalFreqStart, m_originalFreqEnd - m_originalFreqStart, dst);
         break;
-    }
     case Mode::AVERAGE_5:
-    {
-        AlignedVector<float> avgedSpectrum(m_template.bufferSize());
         for(size_t j = 0; j < m_template.numFrequencies(); j++){
-            const float * rawFreqMag = spectrum.magnitudes->data() + m_originalFreqStart + j*5;
-            const float newMag = (rawFreqMag[0] + rawFreqMag[1] + rawFreqMag[2] + rawFreqMag[3] + rawFreqMag[4]) / 5.0f;
-            avgedSpectrum[j] = newMag;
+            const float * rawFreqMag = src + m_originalFreqStart + j*5;
+            dst[j] = (rawFreqMag[0] + rawFreqMag[1] + rawFreqMag[2] + rawFreqMag[3] + rawFreqMag[4]) / 5.0f;
         }
-        spectrum.magnitudes = std::make_unique<AlignedVector<float>>(std::move(avgedSpectrum));
         break;
-    }
     case Mode::RAW:
+        memcpy(dst + m_freqStart, src + m_freqStart, (m_freqEnd - m_freqStart) * sizeof(float));
         break;
     }
 
-    // Compute the norm square (= sum squares) of the spectrum, used for matching:
-    // TODO: if there will be multiple SpectrogramMatcher running on the same audio stream, can
-    // move this per-spectrum computation to a shared struct for those matchers to save computation.
+    // Compute the norm square (= sum squares) of the spectrum, used for matching.
+    // Other matchers with the same filter can reuse it through `match(const SpectrogramMatcher&)`.
     float spectrumNormSqr = 0.0f;
     for(size_t i = m_freqStart; i < m_freqEnd; i++){
-        float mag = (*spectrum.magnitudes)[i];
+        float mag = dst[i];
         spectrumNormSqr += mag * mag;
     }
-    m_spectrumNormSqrs.push_front(spectrumNormSqr);
 
-    m_spectrums.emplace_front(std::move(spectrum));
+    pushSpectrum(slot, spectrum.stamp, spectrumNormSqr);
 
     return true;
 }
 
+void SpectrogramMatcher::pushSpectrum(size_t slot, uint64_t stamp, float normSqr){
+    m_ringStamps[slot] = stamp;
+    m_ringNormSqrs[slot] = normSqr;
+    m_ringHead = slot;
+    m_ringCount = std::min(m_ringCount + 1, m_numSpectrumsNeeded);
+}
+
 bool SpectrogramMatcher::updateToNewSpectrums(const std::vector<AudioSpectrum>& newSpectrums){
     for(auto it = newSpectrums.rbegin(); it != newSpectrums.rend(); it++){
         if(!updateToNewSpectrum(*it)){
             return false;
         }
     }
-
-    // pop out too old spectrums
-    while(m_spectrums.size() > m_numSpectrumsNeeded){
-        m_spectrums.pop_back();
-        m_spectrumNormSqrs.pop_back();
-    }
-
     return true;
 }
 
 std::pair<float, float> SpectrogramMatcher::matchSubTemplate(size_t subIndex) const {
-#if 0
-    auto iter = m_spectrums.begin();
-    auto iter2 = m_spectrumNormSqrs.begin();
-    float streamSumSqr = 0.0f;
-    float sumMulti = 0.0f;
-
-    const size_t templateStart = m_templateRange[subIndex].first;
-    const size_t templateEnd = m_templateRange[subIndex].second;
-    for(size_t i = templateStart; i < templateEnd; i++, iter++, iter2++){
-        // match in order from latest window to oldest
-        const float* templateData = m_template.getWindow(templateEnd-1-i);
-        const float* streamData = iter->magnitudes->data();
-        streamSumSqr += *iter2;
-        for(size_t j = m_freqStart; j < m_freqEnd; j++){
-            sumMulti += templateData[j] * streamData[j];
-        }
-    }
-//    cout << "sumMulti = " << sumMulti << ", streamSumSqr = " << streamSumSqr << endl;
-    const float scale = (streamSumSqr < 1e-6f ? 1.0f : sumMulti / streamSumSqr);
-
-    iter = m_spectrums.begin();
-    float sum = 0.0f;
-    for(size_t i = templateStart; i < templateEnd; i++, iter++){
-        // match in order from latest window to oldest
-        const float* templateData = m_template.getWindow(templateEnd-1-i);
-        const float* streamData = iter->magnitudes->data();
-        for(size_t j = m_freqStart; j < m_freqEnd; j++){
-            float d = templateData[j] - scale * streamData[j];
-            sum += d * d;
-        }
-    }
-#else
     //  Build matrix.
-    auto iter = m_spectrums.begin();
     const size_t templateStart = m_templateRange[subIndex].first;
     const size_t templateEnd = m_templateRange[subIndex].second;
     size_t windows = templateEnd - templateStart;
-//    cout << windows << endl;
-//    cout << m_spectrums.size() << " / " << windows << endl;
     size_t freqs = m_freqEnd - m_freqStart;
     std::vector<const float*> matrixA(windows);
     std::vector<const float*> matrixT(windows);
-    for (size_t i = 0; i < windows; i++, iter++){
-//        cout << "Template: " << ((size_t)m_template.getWindow(templateEnd - 1 - i) % 64) << endl;
-//        cout << "Samples:  " << ((size_t)iter->magnitudes->data() % 64) << endl;
+    double streamSumSqr = 0;
+    for (size_t i = 0; i < windows; i++){
+        // Match in order from latest window to oldest.
+        // Note that every sub-template is paired with the first `windows` template windows
+        // and normalized by `m_templateNorm[0]`.
+        const size_t slot = ringSlot(i);
         matrixT[i] = m_freqStart + m_template.getWindow(windows - 1 - i);
-        matrixA[i] = m_freqStart + iter->magnitudes->data();
-//        cout << matrixT[i] << " : " << matrixA[i] << endl;
+        matrixA[i] = m_freqStart + ringSpectrum(slot);
+        streamSumSqr += m_ringNormSqrs[slot];
     }
 
-    //  Compute scale.
+    //  Compute scale. This is the only pass over the spectrums.
+    //  scale = A.T / |A|^2, so A.T can be recovered from the stored norms.
     float scale = Kernels::ScaleInvariantMatrixMatch::compute_scale(
         freqs, windows,
         matrixA.data(), matrixT.data()
     );
+    const double sumMulti = (double)scale * streamSumSqr;
     scale = std::min<float>(scale, 1000000);
 
-    //  Compute error.
-    float sum = Kernels::ScaleInvariantMatrixMatch::compute_error(
-        freqs, windows,
-        scale,
-        matrixA.data(), matrixT.data()
-    );
-#endif
-
+    //  Compute error: |s A - T|^2 = s^2 |A|^2 - 2 s A.T + |T|^2
+    const double templateSumSqr = (double)m_templateNorm[0] * m_templateNorm[0];
+    double sum = (double)scale * scale * streamSumSqr - 2.0 * scale * sumMulti + templateSumSqr;
+    sum = std::max(sum, 0.0);
 
-    float score = sqrt(sum) / m_templateNorm[0];
+    float score = (float)(std::sqrt(sum) / m_templateNorm[0]);
     score = std::min<float>(score, 1.0);
 
     return std::make_pair(score, scale);
@@ -330,25 +300,55 @@ float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& newSpectrums){
     if (!updateToNewSpectrums(newSpectrums)){
         return FLT_MAX;
     }
+    return matchStoredSpectrums();
+}
+
+bool SpectrogramMatcher::sameFilter(const SpectrogramMatcher& x) const{
+    //  The filter kernel and the filtered frequency range are derived from these.
+    return m_mode == x.m_mode
+        && m_sampleRate == x.m_sampleRate
+        && m_numOriginalFrequencies == x.m_numOriginalFrequencies
+        && m_originalFreqStart == x.m_originalFreqStart
+        && m_originalFreqEnd == x.m_originalFreqEnd;
+}
+
+float SpectrogramMatcher::match(const SpectrogramMatcher& source){
+    if (m_numSpectrumsNeeded == 0 || source.m_ringCount == 0){
+        return FLT_MAX;
+    }
+    if (!sameFilter(source)){
+        std::cout << "Error: SpectrogramMatcher::match() called with a matcher of a different filter." << std::endl;
+        return FLT_MAX;
+    }
+
+    // Overwrite the oldest slot with the spectrum already filtered by `source`.
+    const size_t slot = (m_ringHead + 1) % m_numSpectrumsNeeded;
+    memcpy(
+        ringSpectrum(slot), source.ringSpectrum(source.m_ringHead),
+        m_template.numFrequencies() * sizeof(float)
+    );
+    pushSpectrum(slot, source.m_ringStamps[source.m_ringHead], source.m_ringNormSqrs[source.m_ringHead]);
+
+    return matchStoredSpectrums();
+}
 
-    if (m_spectrums.size() < m_numSpectrumsNeeded){
+float SpectrogramMatcher::matchStoredSpectrums(){
+    if (m_ringCount < m_numSpectrumsNeeded){
         return FLT_MAX;
     }
 
     // Check whether the stored spectrums' timestamps are continuous:
-    size_t curStamp = m_spectrums.front().stamp;
-    size_t lastStamp = curStamp + 1;
-    for(const auto& s : m_spectrums){
-        if (s.stamp != lastStamp - 1){
+    size_t curStamp = m_ringStamps[m_ringHead];
+    for(size_t i = 0; i < m_ringCount; i++){
+        if (m_ringStamps[ringSlot(i)] != curStamp - i){
             std::cout << "Error: SpectrogramMatcher's spectrum timestamps are not continuous:" << std::endl;
 
-            for(const auto& sp : m_spectrums){
-                std::cout << sp.stamp << ", ";
+            for(size_t j = 0; j < m_ringCount; j++){
+                std::cout << m_ringStamps[ringSlot(j)] << ", ";
             }
             std::cout << std::endl;
             return FLT_MAX;
         }
-        lastStamp--;
     }
 
     if (m_lastStampTested != SIZE_MAX && curStamp <= m_lastStampTested){
@@ -387,8 +387,7 @@ bool SpectrogramMatcher::skip(const std::vector<AudioSpectrum>& newSpectrums){
 }
 
 void SpectrogramMatcher::clear(){
-    m_spectrums.clear();
-    m_spectrumNormSqrs.clear();
+    m_ringCount = 0;
     m_lastStampTested = SIZE_MAX;
 }
 
@@ -11,7 +11,7 @@
 #include <array>
 #include <memory>
 #include <vector>
-#include <list>
+#include "Common/Cpp/Containers/AlignedVector.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
 #include "CommonFramework/AudioPipeline/AudioTemplate.h"
 
@@ -54,6 +54,18 @@ public:
     // In invalid cases (internal error or not enough windows), return FLT_MAX
     float match(const std::vector<AudioSpectrum>& newSpectrums);
 
+    // Whether `x` filters the incoming spectrums the same way as this matcher.
+    // Matchers with the same filter can share the filtered spectrums. See `match(const SpectrogramMatcher&)`.
+    bool sameFilter(const SpectrogramMatcher& x) const;
+
+    // Match the newest spectrum stored in `source`, which has already been filtered by `source`,
+    // and return a match score.
+    // `source` must have the same filter as this matcher. See `sameFilter()`.
+    // Used when multiple matchers run on the same audio stream so that each spectrum is only
+    // filtered once.
+    // In invalid cases (internal error or not enough windows), return FLT_MAX
+    float match(const SpectrogramMatcher& source);
+
     // Pass some spectrums in but don't run match on them.
     // Used for skipping some spectrums to avoid unnecessary matching.
     // Newer (larger timestamp) spectrums at beginning of `newSpectrums` while older (smaller
@@ -87,12 +99,29 @@ private:
 
     // Update internal data for the next new spectrum. Called by `updateToNewSpectrums()`.
     // Return true if there is no error.
-    bool updateToNewSpectrum(AudioSpectrum newSpectrum);
+    bool updateToNewSpectrum(const AudioSpectrum& newSpectrum);
 
     // Update internal data for the new specttrums.
     // Return true if there is no error.
     bool updateToNewSpectrums(const std::vector<AudioSpectrum>& newSpectrums);
 
+    // Make the filtered spectrum in `slot` the newest stored spectrum.
+    void pushSpectrum(size_t slot, uint64_t stamp, float normSqr);
+
+    // Match the template against the stored spectrums.
+    float matchStoredSpectrums();
+
+    // Ring buffer slot of the i-th newest stored spectrum. i = 0 is the newest.
+    size_t ringSlot(size_t i) const{
+        return (m_ringHead + m_numSpectrumsNeeded - i) % m_numSpectrumsNeeded;
+    }
+    const float* ringSpectrum(size_t slot) const{
+        return m_ring.data() + slot * m_ringStride;
+    }
+    float* ringSpectrum(size_t slot){
+        return m_ring.data() + slot * m_ringStride;
+    }
+
 
 
 private:
@@ -116,13 +145,22 @@ private:
 
     std::vector<float> m_convKernel;
 
-    // Spectrums from audio feed. They will be matched against the template.
-    std::list<AudioSpectrum> m_spectrums;
-    // Norm squares of each spectrum in `m_spectrums`.
-    std::list<float> m_spectrumNormSqrs;
     // How many spectrums needed to store.
     size_t m_numSpectrumsNeeded = 0;
 
+    // Spectrums from audio feed, after filtering. They will be matched against the template.
+    // This is a ring buffer of `m_numSpectrumsNeeded` spectrums, each `m_ringStride` floats
+    // apart so that they have the same alignment as the template windows.
+    AlignedVector<float> m_ring;
+    size_t m_ringStride = 0;
+    // Slot of the newest spectrum.
+    size_t m_ringHead = 0;
+    // How many slots are filled.
+    size_t m_ringCount = 0;
+    // Timestamp and norm square (= sum squares) of the spectrum in each slot.
+    std::vector<uint64_t> m_ringStamps;
+    std::vector<float> m_ringNormSqrs;
+
     size_t m_lastStampTested = SIZE_MAX;
     float m_lastScale = 0.0f;
 };
@@ -13,7 +13,8 @@ namespace PokemonAutomation{
 
 
 bool VisualInferenceCallback::process_frame(const VideoSnapshot& frame){
-    return process_frame(*frame.frame, frame.timestamp);
+    //  Go through the snapshot's view so detectors get its summed-area table.
+    return process_frame((ImageViewRGB32)frame, frame.timestamp);
 }
 bool VisualInferenceCallback::process_frame(const ImageViewRGB32& frame, WallClock timestamp){
     throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "You must override one of the two process_frame() functions.");
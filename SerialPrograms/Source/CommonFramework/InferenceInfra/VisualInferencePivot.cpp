@@ -5,6 +5,7 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "VisualInferencePivot.h"
 
@@ -43,6 +44,7 @@ struct VisualInferencePivot::PeriodicCallback{
 VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher)
     : PeriodicRunner(dispatcher)
     , m_feed(feed)
+    , m_dispatcher(dispatcher)
 {
     attach(scope);
 }
@@ -90,10 +92,59 @@ void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
         //  Reuse the cached screenshot.
         if (!is_back_to_back || callback.last_seqnum == m_seqnum){
 //            cout << "back-to-back" << endl;
-            m_last = m_feed.snapshot();
+            m_last = m_feed.inference_snapshot();
             m_seqnum++;
         }
+    }catch (...){
+        callback.scope.cancel(std::current_exception());
+        return;
+    }
+    process_frame(callback);
+}
+bool VisualInferencePivot::batch_events() const{
+    return GlobalSettings::instance().PARALLEL_VIDEO_INFERENCE;
+}
+void VisualInferencePivot::run_batch(const std::vector<void*>& events, bool is_back_to_back) noexcept{
+    if (events.size() <= 1){
+        PeriodicRunner::run_batch(events, is_back_to_back);
+        return;
+    }
+
+    //  All the callbacks that are due share the same screenshot. Only grab a
+    //  new one if any of them has already seen the cached one.
+    try{
+        bool refresh = !is_back_to_back;
+        for (void* event : events){
+            refresh |= ((PeriodicCallback*)event)->last_seqnum == m_seqnum;
+        }
+        if (refresh){
+            m_last = m_feed.inference_snapshot();
+            m_seqnum++;
+        }
+    }catch (...){
+        for (void* event : events){
+            ((PeriodicCallback*)event)->scope.cancel(std::current_exception());
+        }
+        return;
+    }
 
+    //  Fan out the callbacks onto the dispatcher. "process_frame()" doesn't
+    //  throw so this only fails if we can't get the threads.
+    try{
+        m_dispatcher.run_in_parallel(
+            0, events.size(),
+            [&](size_t index){
+                process_frame(*(PeriodicCallback*)events[index]);
+            }
+        );
+    }catch (...){
+        for (void* event : events){
+            ((PeriodicCallback*)event)->scope.cancel(std::current_exception());
+        }
+    }
+}
+void VisualInferencePivot::process_frame(PeriodicCallback& callback) noexcept{
+    try{
         WallClock time0 = current_time();
         bool stop = callback.callback.process_frame(m_last);
         WallClock time1 = current_time();
@@ -111,7 +162,6 @@ void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     }
 }
 
-
 OverlayStatSnapshot VisualInferencePivot::get_current(){
     return m_printer.get_snapshot("Video Pivot Utilization:", this->current_utilization());
 }
@@ -40,13 +40,19 @@ public:
     StatAccumulatorI32 remove_callback(VisualInferenceCallback& callback);
 
 private:
+    struct PeriodicCallback;
+
     virtual void run(void* event, bool is_back_to_back) noexcept override;
+    virtual bool batch_events() const override;
+    virtual void run_batch(const std::vector<void*>& events, bool is_back_to_back) noexcept override;
     virtual OverlayStatSnapshot get_current() override;
 
-private:
-    struct PeriodicCallback;
+    //  Run the callback on "m_last".
+    void process_frame(PeriodicCallback& callback) noexcept;
 
+private:
     VideoFeed& m_feed;
+    AsyncDispatcher& m_dispatcher;
     SpinLock m_lock;
     std::map<VisualInferenceCallback*, PeriodicCallback> m_map;
     VideoSnapshot m_last;
@@ -4,8 +4,10 @@
  *
  */
 
+#include <algorithm>
 #include <QCoreApplication>
 #include <QMenuBar>
+#include "Common/Cpp/PrettyPrint.h"
 #include "CommonFramework/Windows/DpiScaler.h"
 #include "CommonFramework/Windows/WindowTracker.h"
 #include "FileWindowLogger.h"
@@ -17,10 +19,74 @@
 namespace PokemonAutomation{
 
 
-Logger& global_logger_raw(){
+FileWindowLogger& global_file_window_logger(){
     static FileWindowLogger logger((QCoreApplication::applicationName() + ".log").toStdString());
     return logger;
 }
+Logger& global_logger_raw(){
+    return global_file_window_logger();
+}
+
+
+
+struct FileWindowLogger::Record{
+    uint64_t seqnum;
+    std::string msg;
+    Color color;
+};
+
+
+//  Single-producer, single-consumer ring. The producer is the thread that
+//  owns it. The consumer is the writer thread.
+class FileWindowLogger::ThreadRing{
+public:
+    static const size_t CAPACITY = 1024;
+
+    //  Producer only.
+    bool try_push(Record&& record){
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= CAPACITY){
+            return false;
+        }
+        m_records[tail % CAPACITY] = std::move(record);
+        m_tail.store(tail + 1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    //  Consumer only.
+    bool empty() const{
+        return m_head.load(std::memory_order_relaxed) == m_tail.load(std::memory_order_seq_cst);
+    }
+    void pop_all(std::vector<Record>& batch){
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        for (; head != tail; head++){
+            batch.emplace_back(std::move(m_records[head % CAPACITY]));
+        }
+        m_head.store(head, std::memory_order_release);
+    }
+
+    //  Set when the owning thread exits. Nothing more will be pushed.
+    std::atomic<bool> abandoned{false};
+
+private:
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+    Record m_records[CAPACITY];
+};
+
+
+//  The rings of the current thread, one for each logger it has logged to.
+struct FileWindowLogger::ThreadRings{
+    std::vector<std::pair<uint64_t, std::shared_ptr<ThreadRing>>> rings;
+
+    ~ThreadRings(){
+        for (auto& item : rings){
+            item.second->abandoned.store(true, std::memory_order_release);
+        }
+    }
+};
+
 
 
 FileWindowLogger::~FileWindowLogger(){
@@ -32,10 +98,18 @@ FileWindowLogger::~FileWindowLogger(){
     m_thread.join();
 }
 FileWindowLogger::FileWindowLogger(const std::string& path)
-    : m_file(QString::fromStdString(path))
+    : m_id([]{
+        static std::atomic<uint64_t> instances(0);
+        return instances++;
+    }())
+    , m_file(QString::fromStdString(path))
     , m_max_queue_size(10000)
+    , m_seqnum(0)
+    , m_writer_sleeping(false)
+    , m_written(0)
+    , m_spilled(0)
+    , m_blocked(0)
     , m_stopping(false)
-    , m_thread(&FileWindowLogger::thread_loop, this)
 {
     bool exists = m_file.exists();
     m_file.open(QIODevice::WriteOnly | QIODevice::Append);
@@ -43,27 +117,76 @@ FileWindowLogger::FileWindowLogger(const std::string& path)
         std::string bom = "\xef\xbb\xbf";
         m_file.write(bom.c_str(), bom.size());
     }
+    m_thread = std::thread(&FileWindowLogger::thread_loop, this);
 }
 void FileWindowLogger::operator+=(FileWindowLoggerWindow& widget){
-    std::lock_guard<std::mutex> lg(m_lock);
+    std::lock_guard<std::mutex> lg(m_window_lock);
     m_windows.insert(&widget);
 }
 void FileWindowLogger::operator-=(FileWindowLoggerWindow& widget){
-    std::lock_guard<std::mutex> lg(m_lock);
+    std::lock_guard<std::mutex> lg(m_window_lock);
     m_windows.erase(&widget);
 }
 
 void FileWindowLogger::log(const std::string& msg, Color color){
-    std::unique_lock<std::mutex> lg(m_lock);
-    m_cv.wait(lg, [this]{ return m_queue.size() < m_max_queue_size; });
-    m_queue.emplace_back(msg, color);
-    m_cv.notify_all();
+    push(std::string(msg), color);
 }
 void FileWindowLogger::log(std::string&& msg, Color color){
+    push(std::move(msg), color);
+}
+FileWindowLogger::Stats FileWindowLogger::stats() const{
+    uint64_t written = m_written.load(std::memory_order_relaxed);
+    uint64_t logged = m_seqnum.load(std::memory_order_relaxed);
+    return Stats{
+        (size_t)(logged > written ? logged - written : 0),
+        m_spilled.load(std::memory_order_relaxed),
+        m_blocked.load(std::memory_order_relaxed),
+    };
+}
+
+FileWindowLogger::ThreadRing& FileWindowLogger::thread_ring(){
+    thread_local ThreadRings rings;
+    for (auto& item : rings.rings){
+        if (item.first == m_id){
+            return *item.second;
+        }
+    }
+
+    //  First time this thread logs here. Register a new ring.
+    std::shared_ptr<ThreadRing> ring = std::make_shared<ThreadRing>();
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_rings.emplace_back(ring);
+    }
+    rings.rings.emplace_back(m_id, ring);
+    return *ring;
+}
+void FileWindowLogger::push(std::string&& msg, Color color){
+    Record record{
+        m_seqnum.fetch_add(1, std::memory_order_relaxed),
+        std::move(msg),
+        color
+    };
+    if (!thread_ring().try_push(std::move(record))){
+        spill(std::move(record));
+    }
+
+    //  Only wake the writer if it's asleep. Otherwise it will pick this up
+    //  with the rest of its next batch.
+    if (m_writer_sleeping.load(std::memory_order_seq_cst)){
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_cv.notify_all();
+    }
+}
+void FileWindowLogger::spill(Record&& record){
+    m_spilled.fetch_add(1, std::memory_order_relaxed);
     std::unique_lock<std::mutex> lg(m_lock);
-    m_cv.wait(lg, [this]{ return m_queue.size() < m_max_queue_size; });
-    m_queue.emplace_back(std::move(msg), color);
-    m_cv.notify_all();
+    if (m_spill.size() >= m_max_queue_size){
+        m_blocked.fetch_add(1, std::memory_order_relaxed);
+        m_cv.notify_all();
+        m_cv.wait(lg, [this]{ return m_spill.size() < m_max_queue_size || m_stopping; });
+    }
+    m_spill.emplace_back(std::move(record));
 }
 
 
@@ -134,43 +257,118 @@ QString FileWindowLogger::to_window_str(const std::string& msg, Color color){
 
     return QString::fromStdString(str);
 }
-void FileWindowLogger::internal_log(const std::string& msg, Color color){
-    std::string line = normalize_newlines(msg);
-    {
-        if (!m_windows.empty()){
-            QString str = to_window_str(line, color);
-            for (FileWindowLoggerWindow* window : m_windows){
-                window->log(str);
-            }
+void FileWindowLogger::collect(std::vector<Record>& batch){
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    //  Drain the rings before the spill queue. A thread only spills when its
+    //  ring is full. So anything it pushed to its ring after spilling is newer
+    //  than what's already in the spill queue by the time we get there.
+    for (size_t c = 0; c < m_rings.size();){
+        ThreadRing& ring = *m_rings[c];
+        bool abandoned = ring.abandoned.load(std::memory_order_acquire);
+        ring.pop_all(batch);
+        if (abandoned){
+            m_rings[c] = std::move(m_rings.back());
+            m_rings.pop_back();
+        }else{
+            c++;
+        }
+    }
+
+    bool was_full = m_spill.size() >= m_max_queue_size;
+    for (Record& record : m_spill){
+        batch.emplace_back(std::move(record));
+    }
+    m_spill.clear();
+    if (was_full){
+        m_cv.notify_all();
+    }
+
+    std::sort(
+        batch.begin(), batch.end(),
+        [](const Record& x, const Record& y){ return x.seqnum < y.seqnum; }
+    );
+}
+bool FileWindowLogger::has_pending(){
+    if (!m_spill.empty()){
+        return true;
+    }
+    for (const std::shared_ptr<ThreadRing>& ring : m_rings){
+        if (!ring->empty()){
+            return true;
         }
     }
+    return false;
+}
+void FileWindowLogger::write_batch(std::vector<Record>& batch){
+    //  The file gets the batch in one write. The windows get one line per
+    //  record since they cap how many lines they keep.
+    std::string file_str;
+    std::vector<QString> window_lines;
+    window_lines.reserve(batch.size());
+    for (const Record& record : batch){
+        file_str += to_file_str(record.msg);
+        window_lines.emplace_back(to_window_str(normalize_newlines(record.msg), record.color));
+    }
+
     {
-        m_file.write(to_file_str(msg).c_str());
-        m_file.flush();
+        std::lock_guard<std::mutex> lg(m_window_lock);
+        for (FileWindowLoggerWindow* window : m_windows){
+            for (const QString& line : window_lines){
+                window->log(line);
+            }
+        }
     }
+
+    m_file.write(file_str.c_str(), file_str.size());
+    m_file.flush();
+
+    m_written.fetch_add(batch.size(), std::memory_order_relaxed);
+    batch.clear();
 }
 void FileWindowLogger::thread_loop(){
-    std::unique_lock<std::mutex> lg(m_lock);
+    std::vector<Record> batch;
     while (true){
-        m_cv.wait(lg, [&]{
-            return m_stopping || !m_queue.empty();
-        });
+        collect(batch);
+        if (!batch.empty()){
+            write_batch(batch);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lg(m_lock);
         if (m_stopping){
             break;
         }
-        auto& item = m_queue.front();
-        std::string msg = std::move(item.first);
-        Color color = item.second;
-        m_queue.pop_front();
-
-        lg.unlock();
-        internal_log(msg, color);
-        lg.lock();
 
-        if (m_queue.size() <= m_max_queue_size / 2){
-            m_cv.notify_all();
+        //  Announce that we're going to sleep, then check once more so we
+        //  don't miss a message that was pushed in between. The timeout is
+        //  just a safety net.
+        m_writer_sleeping.store(true, std::memory_order_seq_cst);
+        if (!has_pending()){
+            m_cv.wait_for(lg, std::chrono::milliseconds(100));
         }
+        m_writer_sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+
+
+LoggerBacklogStat::LoggerBacklogStat()
+    : m_last_spilled(global_file_window_logger().stats().spilled)
+{}
+OverlayStatSnapshot LoggerBacklogStat::get_current(){
+    FileWindowLogger::Stats stats = global_file_window_logger().stats();
+    bool spilling = stats.spilled != m_last_spilled;
+    m_last_spilled = stats.spilled;
+
+    //  Only show up when the writer is falling behind.
+    if (stats.backlog < 100 && !spilling){
+        return OverlayStatSnapshot();
     }
+    return OverlayStatSnapshot{
+        "Log Backlog: " + tostr_u_commas(stats.backlog),
+        spilling ? COLOR_RED : COLOR_ORANGE
+    };
 }
 
 
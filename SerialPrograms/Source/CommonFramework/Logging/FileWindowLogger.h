@@ -7,14 +7,19 @@
 #ifndef PokemonAutomation_Logging_FileWindowLogger_H
 #define PokemonAutomation_Logging_FileWindowLogger_H
 
+#include <stdint.h>
 #include <deque>
 #include <set>
+#include <vector>
+#include <memory>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
 #include <QFile>
 #include <QTextEdit>
 #include <QMainWindow>
+#include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
 #include "Logger.h"
 
 namespace PokemonAutomation{
@@ -22,6 +27,13 @@ namespace PokemonAutomation{
 class FileWindowLoggerWindow;
 
 
+//  Each thread that logs gets its own lock-free ring of messages. The writer
+//  thread drains all the rings in batches and does one file write and one
+//  window update per batch. So logging from a busy thread never waits on a
+//  lock or on disk.
+//
+//  If a thread's ring is full, its messages spill into a shared queue under
+//  a lock. Only if that is also full does the thread block.
 class FileWindowLogger : public Logger{
 public:
     ~FileWindowLogger();
@@ -33,26 +45,72 @@ public:
     virtual void log(const std::string& msg, Color color = Color()) override;
     virtual void log(std::string&& msg, Color color = Color()) override;
 
+    struct Stats{
+        //  Messages logged, but not yet written.
+        size_t backlog;
+        //  Messages that didn't fit in their thread's ring.
+        uint64_t spilled;
+        //  Messages that had to wait for the writer to catch up.
+        uint64_t blocked;
+    };
+    Stats stats() const;
+
 private:
+    struct Record;
+    class ThreadRing;
+    struct ThreadRings;
+
     static std::string normalize_newlines(const std::string& msg);
     static std::string to_file_str(const std::string& msg);
     static QString to_window_str(const std::string& msg, Color color);
 
-    void internal_log(const std::string& msg, Color color);
+    ThreadRing& thread_ring();
+    void push(std::string&& msg, Color color);
+    void spill(Record&& record);
+
+    //  Move everything that's been logged so far into "batch" in order.
+    void collect(std::vector<Record>& batch);
+    bool has_pending();
+    void write_batch(std::vector<Record>& batch);
     void thread_loop();
 
 private:
+    const uint64_t m_id;
     QFile m_file;
     size_t m_max_queue_size;
-    std::mutex m_lock;
+    std::atomic<uint64_t> m_seqnum;
+
+    std::atomic<bool> m_writer_sleeping;
+    std::atomic<uint64_t> m_written;
+    std::atomic<uint64_t> m_spilled;
+    std::atomic<uint64_t> m_blocked;
+
+    mutable std::mutex m_lock;
     std::condition_variable m_cv;
     bool m_stopping;
-    std::deque<std::pair<std::string, Color>> m_queue;
+    std::vector<std::shared_ptr<ThreadRing>> m_rings;
+    std::deque<Record> m_spill;
+
+    //  Separate from "m_lock" so that feeding the windows doesn't block the
+    //  threads that are logging.
+    std::mutex m_window_lock;
     std::set<FileWindowLoggerWindow*> m_windows;
     std::thread m_thread;
 };
 
 
+
+//  Overlay stat for how far behind the global log writer is.
+class LoggerBacklogStat : public OverlayStat{
+public:
+    LoggerBacklogStat();
+    virtual OverlayStatSnapshot get_current() override;
+
+private:
+    uint64_t m_last_spilled;
+};
+
+
 class FileWindowLoggerWindow : public QMainWindow{
     Q_OBJECT
 
@@ -7,6 +7,8 @@
 #include <QDir>
 #include <QFile>
 #include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/Tools/ImageEncoder.h"
 #include "MessageAttachment.h"
 
 namespace PokemonAutomation{
@@ -37,20 +39,32 @@ PendingFileSend::~PendingFileSend(){
         return;
     }
 
+    //  Don't block here on an encode that's still running. Let the encoder
+    //  delete the file when it's done.
+    if (m_encoding){
+        m_encoding->discard();
+        return;
+    }
+
     QFile file(QString::fromStdString(m_filepath));
     file.remove();
 }
-PendingFileSend::PendingFileSend(const std::string& file, bool keep_file)
+PendingFileSend::PendingFileSend(const std::string& file, bool keep_file, bool embed_image)
     : m_keep_file(keep_file)
+    , m_embed_image(embed_image)
     , m_extend_lifetime(false)
     , m_filepath(file)
 {
     QFileInfo info(QString::fromStdString(file));
     m_filename = info.fileName().toStdString();
+
+    //  The file may be an image that's still being encoded. (e.g. error dumps)
+    m_encoding = ImageEncoder::instance().find(m_filepath);
 }
 #if 0
 PendingFileSend::PendingFileSend(Logger& logger, const std::string& text_attachment)
     : m_keep_file(false)
+    , m_embed_image(false)
     , m_extend_lifetime(false)
     , m_filename(now_to_filestring() + ".txt")
     , m_filepath("TempFiles/" + m_filename)
@@ -60,6 +74,7 @@ PendingFileSend::PendingFileSend(Logger& logger, const std::string& text_attachm
 #endif
 PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
     : m_keep_file(image.keep_file)
+    , m_embed_image(true)
     , m_extend_lifetime(false)
 {
     if (image.mode == ImageAttachmentMode::NO_SCREENSHOT){
@@ -92,13 +107,19 @@ PendingFileSend::PendingFileSend(Logger& logger, const ImageAttachment& image)
         m_filepath = "TempFiles/" + m_filename;
     }
 
-    if (image.image.save(m_filepath)){
-        logger.log("Saved image to: " + m_filepath, COLOR_BLUE);
-    }else{
-        logger.log("Unable to save screenshot to: " + m_filepath, COLOR_RED);
-        m_filename.clear();
-        m_filepath.clear();
+    logger.log("Saving image to: " + m_filepath, COLOR_BLUE);
+    m_encoding = ImageEncoder::instance().save(image.image, m_filepath);
+}
+bool PendingFileSend::wait() const{
+    if (m_encoding){
+        return m_encoding->wait();
     }
+    return true;
+}
+void PendingFileSend::add_to_embed(JsonObject& embed) const{
+    JsonObject image;
+    image["url"] = "attachment://" + m_filename;
+    embed["image"] = std::move(image);
 }
 void PendingFileSend::extend_lifetime(){
     m_extend_lifetime.store(true, std::memory_order_release);
@@ -15,6 +15,9 @@
 
 namespace PokemonAutomation{
 
+class JsonObject;
+class ImageEncodeTask;
+
 
 struct ImageAttachment{
     ImageViewRGB32 image;
@@ -33,11 +36,15 @@ struct ImageAttachment{
 
 //  Represents a file that's in the process of being sent.
 //  If (keep_file = false), the file is automatically deleted after being sent.
+//
+//  Images are encoded in the background by ImageEncoder. filename() and
+//  filepath() are available immediately, but the file may not exist yet.
+//  Call wait() before reading the file or referring to it in a message.
 class PendingFileSend{
 public:
     ~PendingFileSend();
 
-    PendingFileSend(const std::string& file, bool keep_file);
+    PendingFileSend(const std::string& file, bool keep_file, bool embed_image = false);
 //    PendingFileSend(Logger& logger, const std::string& text_attachment);
     PendingFileSend(Logger& logger, const ImageAttachment& image);
 
@@ -45,15 +52,28 @@ public:
     const std::string& filepath() const{ return m_filepath; }
     bool keep_file() const{ return m_keep_file; }
 
+    //  If true, the file is an image that should be shown inside the embed
+    //  of the message it's sent with.
+    bool embed_image() const{ return m_embed_image; }
+
+    //  Wait for the file to be written. Returns false if it couldn't be saved.
+    bool wait() const;
+
+    //  Show this file as the image of "embed". Only call this after wait()
+    //  has succeeded.
+    void add_to_embed(JsonObject& embed) const;
+
     //  Work around bug in Sleepy that destroys file before it's not needed anymore.
     void extend_lifetime();
 
 private:
     bool m_keep_file;
+    bool m_embed_image;
     std::atomic<bool> m_extend_lifetime;
 //    QFile m_file;
     std::string m_filename;
     std::string m_filepath;
+    std::shared_ptr<ImageEncodeTask> m_encoding;
 };
 
 
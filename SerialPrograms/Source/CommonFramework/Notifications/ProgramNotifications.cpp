@@ -165,11 +165,8 @@ void send_raw_notification(
         fields.push_back(make_credits_field(info));
         embed["fields"] = std::move(fields);
 
-        if (hasFile){
-            JsonObject field;
-            field["url"] = "attachment://" + file->filename();
-            embed["image"] = std::move(field);
-        }
+        //  The screenshot is still being encoded. The senders add it to the
+        //  embed once it has been written.
         embeds.push_back(embed.clone());
         embed_sleepy = std::move(embed);
     }
@@ -497,7 +494,7 @@ void send_program_telemetry(
     bool hasFile = !file.empty();
     std::shared_ptr<PendingFileSend> pending = !hasFile
             ? nullptr
-            : std::shared_ptr<PendingFileSend>(new PendingFileSend(file, GlobalSettings::instance().SAVE_DEBUG_IMAGES));
+            : std::shared_ptr<PendingFileSend>(new PendingFileSend(file, GlobalSettings::instance().SAVE_DEBUG_IMAGES, true));
 
     JsonArray embeds;
     {
@@ -525,12 +522,6 @@ void send_program_telemetry(
             }
         }
         embed["fields"] = std::move(fields);
-
-        if (hasFile){
-            JsonObject image;
-            image["url"] = "attachment://" + pending->filename();
-            embed["image"] = std::move(image);
-        }
         embeds.push_back(std::move(embed));
     }
 
@@ -0,0 +1,82 @@
+/*  Dictionary Index
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "OCR_DictionaryIndex.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+uint64_t DictionaryIndex::trigram(const char32_t* str){
+    //  Unicode code points fit in 21 bits.
+    return ((uint64_t)(str[0] & 0x1fffff) << 42)
+         | ((uint64_t)(str[1] & 0x1fffff) << 21)
+         | ((uint64_t)(str[2] & 0x1fffff));
+}
+
+void DictionaryIndex::add(const Entry& entry){
+    if (m_entries.size() >= 0xffffffff){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Too many candidates.");
+    }
+    uint32_t index = (uint32_t)m_entries.size();
+    m_entries.emplace_back(&entry);
+
+    const std::u32string& str = entry.first;
+    m_length_buckets[str.size()].emplace_back(index);
+
+    if (str.size() < 3){
+        return;
+    }
+    std::map<uint64_t, uint32_t> counts;
+    for (size_t c = 0; c + 3 <= str.size(); c++){
+        counts[trigram(&str[c])]++;
+    }
+    for (const auto& item : counts){
+        m_postings[item.first].emplace_back(SharedCount{index, item.second});
+    }
+}
+
+std::vector<DictionaryIndex::SharedCount> DictionaryIndex::shared_trigrams(const std::u32string& text) const{
+    std::vector<uint64_t> grams;
+    for (size_t c = 0; c + 3 <= text.size(); c++){
+        grams.emplace_back(trigram(&text[c]));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+    std::vector<SharedCount> hits;
+    for (uint64_t gram : grams){
+        auto iter = m_postings.find(gram);
+        if (iter == m_postings.end()){
+            continue;
+        }
+        hits.insert(hits.end(), iter->second.begin(), iter->second.end());
+    }
+
+    //  Merge the hits for the same entry.
+    std::sort(
+        hits.begin(), hits.end(),
+        [](const SharedCount& a, const SharedCount& b){
+            return a.entry < b.entry;
+        }
+    );
+    std::vector<SharedCount> ret;
+    for (const SharedCount& hit : hits){
+        if (!ret.empty() && ret.back().entry == hit.entry){
+            ret.back().shared += hit.shared;
+        }else{
+            ret.emplace_back(hit);
+        }
+    }
+    return ret;
+}
+
+
+
+}
+}
@@ -0,0 +1,76 @@
+/*  Dictionary Index
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Trigram and length index over the candidates of an OCR dictionary.
+ *
+ *  For a candidate of length "m" to match a substring of the text with "k"
+ *  edits, at least (m - 2) - 3k of its trigrams must appear in the text.
+ *  Counting the shared trigrams gives an upper bound on how well each
+ *  candidate can match, and therefore a lower bound on its log10p. Those
+ *  bounds let "match_substring()" skip candidates that cannot make it into
+ *  the results.
+ *
+ *  Candidates that share no trigrams with the text are not visited one by one.
+ *  They are handled a whole length bucket at a time.
+ *
+ */
+
+#ifndef PokemonAutomation_OCR_DictionaryIndex_H
+#define PokemonAutomation_OCR_DictionaryIndex_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <unordered_map>
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+class DictionaryIndex{
+public:
+    using Database = std::map<std::u32string, std::set<std::string>>;
+    using Entry = Database::value_type;
+
+    struct SharedCount{
+        uint32_t entry;
+        uint32_t shared;
+    };
+
+public:
+    //  Add a candidate. The entry must not move for as long as the index is used.
+    //  (std::map nodes never move.)
+    void add(const Entry& entry);
+
+    size_t size() const{ return m_entries.size(); }
+    const Entry& entry(size_t index) const{ return *m_entries[index]; }
+
+    const std::map<size_t, std::vector<uint32_t>>& length_buckets() const{ return m_length_buckets; }
+
+    //  For every candidate that shares at least one trigram with "text",
+    //  return the # of trigram positions of the candidate that also appear in
+    //  "text". Sorted by entry.
+    std::vector<SharedCount> shared_trigrams(const std::u32string& text) const;
+
+
+private:
+    static uint64_t trigram(const char32_t* str);
+
+private:
+    std::vector<const Entry*> m_entries;
+
+    //  Trigram -> (entry, # of times it appears in the entry)
+    std::unordered_map<uint64_t, std::vector<SharedCount>> m_postings;
+
+    //  Candidate length -> entries
+    std::map<size_t, std::vector<uint32_t>> m_length_buckets;
+};
+
+
+
+}
+}
+#endif
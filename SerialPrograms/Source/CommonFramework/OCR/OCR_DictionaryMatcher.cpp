@@ -4,6 +4,8 @@
  *
  */
 
+#include <string.h>
+#include <limits>
 #include "Common/Cpp/Exceptions.h"
 #include "OCR_DictionaryMatcher.h"
 
@@ -44,11 +46,46 @@ OCR::StringMatchResult DictionaryMatcher::match_substring_from_image_multifilter
     double max_log10p, double log10p_spread,
     double min_text_ratio, double max_text_ratio
 ) const{
-    OCR::StringMatchResult ret = OCR::multifiltered_OCR(
-        language, *this, image,
-        text_color_ranges,
-        log10p_spread, min_text_ratio, max_text_ratio
-    );
+    //  Stop at the first filter whose match is far better than the threshold.
+    //  A non-negative threshold accepts everything. (used for training)
+    //  So always run every filter in that case.
+    double early_exit_log10p = max_log10p < 0
+        ? max_log10p * EARLY_EXIT_LOG10P_FACTOR
+        : -std::numeric_limits<double>::infinity();
+
+    ResultCache& cache = ResultCache::instance();
+    bool use_cache = cache.enabled();
+    uint64_t image_hash = 0;
+    uint64_t context = 0;
+    OCR::StringMatchResult ret;
+    bool cached = false;
+    if (use_cache){
+        image_hash = ResultCache::hash_image(image);
+        context = m_cache_id.load(std::memory_order_acquire);
+        context = ResultCache::hash_combine(context, (uint64_t)language);
+        for (const TextColorRange& range : text_color_ranges){
+            context = ResultCache::hash_combine(context, ((uint64_t)range.maxs << 32) | range.mins);
+        }
+        for (double x : {log10p_spread, min_text_ratio, max_text_ratio, early_exit_log10p}){
+            uint64_t bits;
+            memcpy(&bits, &x, sizeof(bits));
+            context = ResultCache::hash_combine(context, bits);
+        }
+        cached = cache.get_match(image_hash, context, ret);
+    }
+
+    if (!cached){
+        ret = OCR::multifiltered_OCR(
+            language, *this, image,
+            text_color_ranges,
+            log10p_spread, min_text_ratio, max_text_ratio,
+            early_exit_log10p
+        );
+        if (use_cache){
+            cache.add_match(image_hash, context, ret);
+        }
+    }
+
     if (logger){
         ret.log(*logger, max_log10p);
     }
@@ -58,6 +95,7 @@ OCR::StringMatchResult DictionaryMatcher::match_substring_from_image_multifilter
 
 void DictionaryMatcher::add_candidate(Language language, std::string token, const std::u32string& candidate){
     dictionary(language).add_candidate(std::move(token), candidate);
+    m_cache_id.store(ResultCache::new_dictionary_id(), std::memory_order_release);
 }
 
 
@@ -8,9 +8,11 @@
 #define PokemonAutomation_OCR_DictionaryMatcher_H
 
 #include <map>
+#include <atomic>
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "CommonFramework/Language.h"
 #include "OCR_Routines.h"
+#include "OCR_ResultCache.h"
 #include "OCR_DictionaryOCR.h"
 
 namespace PokemonAutomation{
@@ -20,6 +22,11 @@ namespace OCR{
 // Base class for an OCR matcher. It matches a sub-string from a dictionary.
 // The construction of the dictionary is left to the derived class.
 class DictionaryMatcher{
+public:
+    //  When matching from an image with multiple filters, stop once a filter
+    //  finds a match with log10p below (max_log10p * EARLY_EXIT_LOG10P_FACTOR).
+    static constexpr double EARLY_EXIT_LOG10P_FACTOR = 2.0;
+
 public:
     const LanguageSet& languages() const{ return m_languages; }
 
@@ -50,6 +57,9 @@ public:
     //   pixel count to background color pixel count must fall into before the matcher
     // even attempts to OCR. This is useful for pruning images with no appearant texts to
     //   reduce expensive OCR computation.
+    // The filters are OCR'ed in parallel. If one of them finds a match well below
+    //   `max_log10p` (see EARLY_EXIT_LOG10P_FACTOR), the rest are not waited on.
+    // Results are cached by image content. (see OCR::ResultCache)
     OCR::StringMatchResult match_substring_from_image_multifiltered(
         Logger* logger,
         Language language,
@@ -71,6 +81,10 @@ protected:
     LanguageSet m_languages;
     std::map<Language, DictionaryOCR> m_database;
     SpinLock m_lock;
+
+    //  Identifies the current contents of the dictionary in the OCR cache.
+    //  Changes whenever a candidate is added.
+    std::atomic<uint64_t> m_cache_id{ResultCache::new_dictionary_id()};
 };
 
 
@@ -4,10 +4,12 @@
  *
  */
 
+#include <algorithm>
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
 #include "Common/Qt/StringToolsQt.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
 #include "OCR_StringNormalization.h"
 #include "OCR_TextMatcher.h"
 #include "OCR_DictionaryOCR.h"
@@ -28,6 +30,7 @@ DictionaryOCR::DictionaryOCR(
     bool first_only
 )
     : m_random_match_chance(random_match_chance)
+    , m_verify_index(PreloadSettings::debug().OCR_DICTIONARY_INDEX)
 {
     for (const auto& item0 : json){
         const std::string& token = item0.first;
@@ -50,6 +53,9 @@ DictionaryOCR::DictionaryOCR(
             }
         }
     }
+    for (const auto& item : m_candidate_to_token){
+        m_index.add(item);
+    }
     global_logger_tagged().log(
         "DictionaryOCR - Tokens: " + std::to_string(m_database.size()) +
         ", Match Candidates: " + std::to_string(m_candidate_to_token.size())
@@ -91,10 +97,35 @@ StringMatchResult DictionaryOCR::match_substring(
     const std::string& text,
     double log10p_spread
 ) const{
-    return OCR::match_substring(
+    StringMatchResult results = OCR::match_substring(
+        m_candidate_to_token, m_index, m_random_match_chance,
+        text, log10p_spread
+    );
+    if (!m_verify_index.load(std::memory_order_relaxed)){
+        return results;
+    }
+
+    StringMatchResult exhaustive = OCR::match_substring(
         m_candidate_to_token, m_random_match_chance,
         text, log10p_spread
     );
+    bool same = results.exact_match == exhaustive.exact_match &&
+        results.results.size() == exhaustive.results.size() &&
+        std::equal(
+            results.results.begin(), results.results.end(),
+            exhaustive.results.begin(),
+            [](const auto& a, const auto& b){
+                return a.first == b.first &&
+                    a.second.target == b.second.target &&
+                    a.second.token == b.second.token;
+            }
+        );
+    if (!same){
+        global_logger_tagged().log("DictionaryOCR - Index mismatch on: " + text, COLOR_RED);
+        results.log(global_logger_tagged(), 0, "Indexed");
+        exhaustive.log(global_logger_tagged(), 0, "Exhaustive");
+    }
+    return exhaustive;
 }
 void DictionaryOCR::add_candidate(std::string token, const std::u32string& candidate){
     if (candidate.size() < 2){
@@ -107,7 +138,9 @@ void DictionaryOCR::add_candidate(std::string token, const std::u32string& candi
     if (iter == m_candidate_to_token.end()){
         //  New candidate. Add it to both maps.
         m_database[token].emplace_back(to_utf8(candidate));
-        m_candidate_to_token[candidate].insert(std::move(token));
+        auto inserted = m_candidate_to_token.emplace(candidate, std::set<std::string>()).first;
+        inserted->second.insert(std::move(token));
+        m_index.add(*inserted);
         return;
     }
 
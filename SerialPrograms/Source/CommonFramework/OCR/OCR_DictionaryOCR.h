@@ -8,10 +8,12 @@
 #define PokemonAutomation_OCR_DictionaryOCR_H
 
 #include <vector>
+#include <atomic>
 #include <set>
 #include <map>
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "OCR_StringMatchResult.h"
+#include "OCR_DictionaryIndex.h"
 
 namespace PokemonAutomation{
     class JsonObject;
@@ -38,6 +40,13 @@ public:
 
     StringMatchResult match_substring(const std::string& text, double log10p_spread = 0.50) const;
 
+    //  For regression testing the candidate index: If enabled, every
+    //  "match_substring()" also runs the exhaustive search, logs any
+    //  difference and returns the exhaustive result.
+    //  Defaults to the "OCR_DICTIONARY_INDEX" debug setting. Safe to call
+    //  while other threads are matching.
+    void set_verify_index(bool enabled){ m_verify_index.store(enabled, std::memory_order_relaxed); }
+
 
 public:
     //  This function is thread-safe with itself, but not with any other
@@ -51,6 +60,8 @@ private:
     double m_random_match_chance;
     std::map<std::string, std::vector<std::string>> m_database;
     std::map<std::u32string, std::set<std::string>> m_candidate_to_token;
+    DictionaryIndex m_index;
+    std::atomic<bool> m_verify_index;
 };
 
 
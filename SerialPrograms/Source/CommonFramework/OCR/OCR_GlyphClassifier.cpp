@@ -0,0 +1,262 @@
+/*  OCR Glyph Classifier
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include "Kernels/HammingDistance/Kernels_HammingDistance.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "OCR_GlyphClassifier.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+namespace{
+
+const size_t MAX_TEMPLATES = 512;
+
+//  A template is trusted once Tesseract agreed on this many different
+//  renderings of it.
+const uint8_t TRUSTED_VOTES = 5;
+
+//  Out of 1024 bits. A glyph this close to a template is the same glyph.
+const uint32_t MERGE_DISTANCE = 40;
+
+//  Out of 1024 bits. Max distance to the best template to classify a glyph.
+//  This is tighter than MERGE_DISTANCE so that only glyphs like the ones that
+//  were voted on are matched.
+const uint32_t MATCH_DISTANCE = 32;
+
+//  The closest template of any other character must be at least this much
+//  further away than the best template.
+const uint32_t MIN_MARGIN = 40;
+
+
+struct ClassifierRegistry{
+    std::mutex lock;
+    std::set<GlyphClassifier*> classifiers;
+
+    static ClassifierRegistry& instance(){
+        static ClassifierRegistry registry;
+        return registry;
+    }
+};
+
+bool glyphs_enabled(){
+    return PreloadSettings::debug().OCR_GLYPH_CLASSIFIER;
+}
+
+}
+
+const size_t GlyphClassifier::GRID_SIZE;
+const size_t GlyphClassifier::GLYPH_WORDS;
+std::atomic<uint64_t> GlyphClassifier::s_classified(0);
+
+
+
+GlyphClassifier::GlyphClassifier(){
+    ClassifierRegistry& registry = ClassifierRegistry::instance();
+    std::lock_guard<std::mutex> lg(registry.lock);
+    registry.classifiers.insert(this);
+}
+GlyphClassifier::~GlyphClassifier(){
+    ClassifierRegistry& registry = ClassifierRegistry::instance();
+    std::lock_guard<std::mutex> lg(registry.lock);
+    registry.classifiers.erase(this);
+}
+void GlyphClassifier::clear(){
+    SpinLockGuard lg(m_lock, "GlyphClassifier::clear()");
+    m_bits.clear();
+    m_info.clear();
+}
+void GlyphClassifier::clear_all(){
+    ClassifierRegistry& registry = ClassifierRegistry::instance();
+    std::lock_guard<std::mutex> lg(registry.lock);
+    for (GlyphClassifier* classifier : registry.classifiers){
+        classifier->clear();
+    }
+}
+uint64_t GlyphClassifier::total_classified(){
+    return s_classified.load(std::memory_order_relaxed);
+}
+
+
+
+GlyphClassifier::Glyph GlyphClassifier::make_glyph(const Kernels::PackedBinaryMatrix_IB& matrix){
+    Glyph glyph;
+    memset(glyph.bits, 0, sizeof(glyph.bits));
+
+    size_t width = matrix.width();
+    size_t height = matrix.height();
+    if (width == 0 || height == 0){
+        return glyph;
+    }
+
+    //  Fit the longer side to the grid and center the shorter side.
+    size_t longest = std::max(width, height);
+    size_t grid_width = std::max<size_t>(1, (width * GRID_SIZE + longest / 2) / longest);
+    size_t grid_height = std::max<size_t>(1, (height * GRID_SIZE + longest / 2) / longest);
+    size_t offset_x = (GRID_SIZE - grid_width) / 2;
+    size_t offset_y = (GRID_SIZE - grid_height) / 2;
+
+    for (size_t gy = 0; gy < grid_height; gy++){
+        size_t y = ((2 * gy + 1) * height) / (2 * grid_height);
+        size_t row = offset_y + gy;
+        for (size_t gx = 0; gx < grid_width; gx++){
+            size_t x = ((2 * gx + 1) * width) / (2 * grid_width);
+            if (matrix.get(x, y)){
+                size_t bit = row * GRID_SIZE + offset_x + gx;
+                glyph.bits[bit / 64] |= (uint64_t)1 << (bit % 64);
+            }
+        }
+    }
+    return glyph;
+}
+
+std::vector<GlyphClassifier::Glyph> GlyphClassifier::segment_dark_text(const ImageViewRGB32& image){
+    using namespace Kernels::Waterfill;
+
+    PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(image, 0xff000000, 0xff7f7f7f);
+
+    std::vector<WaterfillObject> objects;
+    {
+        std::unique_ptr<WaterfillSession> session = make_WaterfillSession(matrix);
+        auto iter = session->make_iterator(4);
+        WaterfillObject object;
+        while (objects.size() < 32 && iter->find_next(object, true)){
+            objects.emplace_back(std::move(object));
+        }
+    }
+
+    size_t max_height = 0;
+    for (const WaterfillObject& object : objects){
+        max_height = std::max(max_height, object.height());
+    }
+    objects.erase(
+        std::remove_if(
+            objects.begin(), objects.end(),
+            [=](const WaterfillObject& object){
+                return object.height() * 2 < max_height;
+            }
+        ),
+        objects.end()
+    );
+    std::sort(
+        objects.begin(), objects.end(),
+        [](const WaterfillObject& a, const WaterfillObject& b){
+            return a.min_x < b.min_x;
+        }
+    );
+
+    std::vector<Glyph> ret;
+    ret.reserve(objects.size());
+    for (const WaterfillObject& object : objects){
+        ret.emplace_back(make_glyph(*object.packed_matrix()));
+    }
+    return ret;
+}
+
+
+
+char GlyphClassifier::classify(const Glyph& glyph) const{
+    if (!glyphs_enabled()){
+        return 0;
+    }
+
+    SpinLockGuard lg(m_lock, "GlyphClassifier::classify()");
+
+    size_t count = m_info.size();
+    if (count == 0){
+        return 0;
+    }
+
+    std::vector<uint32_t> distances(count);
+    Kernels::hamming_distance(distances.data(), glyph.bits, m_bits.data(), GLYPH_WORDS, count);
+
+    //  Best trusted template.
+    size_t best = count;
+    for (size_t c = 0; c < count; c++){
+        const TemplateInfo& info = m_info[c];
+        if (info.conflicted || info.votes < TRUSTED_VOTES){
+            continue;
+        }
+        if (best == count || distances[c] < distances[best]){
+            best = c;
+        }
+    }
+    if (best == count || distances[best] > MATCH_DISTANCE){
+        return 0;
+    }
+
+    //  Closest template that says something else.
+    char ch = m_info[best].ch;
+    uint32_t other = (uint32_t)-1;
+    for (size_t c = 0; c < count; c++){
+        const TemplateInfo& info = m_info[c];
+        if (info.conflicted || info.ch != ch){
+            other = std::min(other, distances[c]);
+        }
+    }
+    //  Nothing to tell it apart from. The margin means nothing yet.
+    if (other == (uint32_t)-1){
+        return 0;
+    }
+    if (other < distances[best] + MIN_MARGIN){
+        return 0;
+    }
+
+    s_classified.fetch_add(1, std::memory_order_relaxed);
+    return ch;
+}
+
+void GlyphClassifier::learn(const Glyph& glyph, char ch){
+    if (!glyphs_enabled()){
+        return;
+    }
+
+    SpinLockGuard lg(m_lock, "GlyphClassifier::learn()");
+
+    size_t count = m_info.size();
+    if (count > 0){
+        std::vector<uint32_t> distances(count);
+        Kernels::hamming_distance(distances.data(), glyph.bits, m_bits.data(), GLYPH_WORDS, count);
+
+        size_t best = std::min_element(distances.begin(), distances.end()) - distances.begin();
+        if (distances[best] <= MERGE_DISTANCE){
+            TemplateInfo& info = m_info[best];
+            if (info.ch != ch){
+                //  The same glyph was read as 2 different things. Never
+                //  trust it again.
+                info.conflicted = true;
+            }else if (distances[best] != 0 && info.votes < 255){
+                //  Identical pixels would be read the same way again. Only
+                //  a different rendering is another vote.
+                info.votes++;
+            }
+            return;
+        }
+    }
+
+    if (count >= MAX_TEMPLATES){
+        return;
+    }
+    m_bits.insert(m_bits.end(), glyph.bits, glyph.bits + GLYPH_WORDS);
+    m_info.emplace_back(TemplateInfo{ch, 1, false});
+}
+
+
+
+}
+}
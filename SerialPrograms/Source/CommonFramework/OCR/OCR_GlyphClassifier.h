@@ -0,0 +1,101 @@
+/*  OCR Glyph Classifier
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A tiny nearest-neighbor classifier for single characters of a fixed font.
+ *
+ *  Each glyph is scaled to a 32 x 32 bitmap and compared against the glyphs
+ *  it has already seen by the number of bits that differ.
+ *
+ *  There are no template files. The templates are learned from Tesseract as
+ *  the program runs. A template is only trusted after Tesseract has read
+ *  several different renderings of it the same way and never differently.
+ *  Tesseract is deterministic, so reading the exact same pixels again doesn't
+ *  count. Anything that isn't a confident match goes back to Tesseract.
+ *
+ *  Since what is learned depends on what was read before, this is off unless
+ *  OCR_GLYPH_CLASSIFIER is set in the debug settings. When it's off,
+ *  classify() never matches and learn() does nothing.
+ *
+ *  Use a separate instance for each font.
+ *
+ */
+
+#ifndef PokemonAutomation_OCR_GlyphClassifier_H
+#define PokemonAutomation_OCR_GlyphClassifier_H
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+
+namespace PokemonAutomation{
+    class ImageViewRGB32;
+namespace Kernels{
+    class PackedBinaryMatrix_IB;
+}
+namespace OCR{
+
+
+class GlyphClassifier{
+public:
+    static const size_t GRID_SIZE = 32;
+    static const size_t GLYPH_WORDS = GRID_SIZE * GRID_SIZE / 64;
+
+    struct Glyph{
+        uint64_t bits[GLYPH_WORDS];
+    };
+
+    //  Scale the set bits of "matrix" to the grid. The aspect ratio is kept.
+    static Glyph make_glyph(const Kernels::PackedBinaryMatrix_IB& matrix);
+
+    //  Split dark text on a light background into glyphs from left to right.
+    //  Specks that are much shorter than the tallest glyph are dropped.
+    //  (punctuation, noise)
+    static std::vector<Glyph> segment_dark_text(const ImageViewRGB32& image);
+
+
+public:
+    GlyphClassifier();
+    ~GlyphClassifier();
+    GlyphClassifier(const GlyphClassifier&) = delete;
+    void operator=(const GlyphClassifier&) = delete;
+
+    //  Forget everything that was learned.
+    void clear();
+
+    //  Clear every classifier. For tests and benchmarks that must not depend
+    //  on what ran before them.
+    static void clear_all();
+
+    //  Total number of glyphs that classify() has matched in any classifier.
+    static uint64_t total_classified();
+
+
+public:
+    //  Returns the character if the match is confident. Otherwise returns zero.
+    char classify(const Glyph& glyph) const;
+
+    //  Tell the classifier that "glyph" is "ch". (usually as read by Tesseract)
+    void learn(const Glyph& glyph, char ch);
+
+
+private:
+    struct TemplateInfo{
+        char ch;
+        uint8_t votes;
+        bool conflicted;
+    };
+
+    static std::atomic<uint64_t> s_classified;
+
+    mutable SpinLock m_lock;
+    std::vector<uint64_t> m_bits;   //  GLYPH_WORDS per template
+    std::vector<TemplateInfo> m_info;
+};
+
+
+
+}
+}
+#endif
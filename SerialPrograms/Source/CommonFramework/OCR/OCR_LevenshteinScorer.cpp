@@ -0,0 +1,122 @@
+/*  Levenshtein Scorer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "OCR_LevenshteinScorer.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+
+LevenshteinScorer::LevenshteinScorer(std::u32string text)
+    : m_text(std::move(text))
+    , m_alphabet(m_text.begin(), m_text.end())
+{
+    std::sort(m_alphabet.begin(), m_alphabet.end());
+    m_alphabet.erase(std::unique(m_alphabet.begin(), m_alphabet.end()), m_alphabet.end());
+
+    m_text_index.reserve(m_text.size());
+    for (char32_t ch : m_text){
+        auto iter = std::lower_bound(m_alphabet.begin(), m_alphabet.end(), ch);
+        m_text_index.emplace_back((uint32_t)(iter - m_alphabet.begin()));
+    }
+}
+
+size_t LevenshteinScorer::build_masks(const std::u32string& str){
+    size_t blocks = (str.size() + 63) / 64;
+    m_masks.assign(m_alphabet.size() * blocks, 0);
+
+    //  Characters that aren't in the text can never match. So they don't
+    //  need a mask.
+    for (size_t c = 0; c < str.size(); c++){
+        auto iter = std::lower_bound(m_alphabet.begin(), m_alphabet.end(), str[c]);
+        if (iter == m_alphabet.end() || *iter != str[c]){
+            continue;
+        }
+        size_t index = iter - m_alphabet.begin();
+        m_masks[index * blocks + c / 64] |= (uint64_t)1 << (c % 64);
+    }
+
+    m_positive.assign(blocks, ~(uint64_t)0);
+    m_negative.assign(blocks, 0);
+    return blocks;
+}
+
+size_t LevenshteinScorer::run(const std::u32string& str, bool substring){
+    size_t length = str.size();
+    if (length == 0){
+        return substring ? 0 : m_text.size();
+    }
+
+    size_t blocks = build_masks(str);
+    uint64_t last_bit = (uint64_t)1 << ((length - 1) % 64);
+
+    //  "score" tracks the bottom row of the DP matrix. That is the distance
+    //  between all of "str" and the text so far.
+    size_t score = length;
+    size_t best = score;
+
+    for (uint32_t index : m_text_index){
+        const uint64_t* masks = &m_masks[index * blocks];
+
+        //  Horizontal delta coming into the top of the block.
+        //  The top row of the matrix is 0, 1, 2, ... for a full match and all
+        //  zeros for a substring match.
+        int carry = substring ? 0 : 1;
+
+        for (size_t b = 0; b < blocks; b++){
+            uint64_t pv = m_positive[b];
+            uint64_t mv = m_negative[b];
+            uint64_t eq = masks[b];
+
+            uint64_t xv = eq | mv;
+            if (carry < 0){
+                eq |= 1;
+            }
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+
+            uint64_t high_bit = b + 1 == blocks ? last_bit : (uint64_t)1 << 63;
+            int carry_out = 0;
+            if (ph & high_bit){
+                carry_out = 1;
+            }else if (mh & high_bit){
+                carry_out = -1;
+            }
+
+            ph <<= 1;
+            mh <<= 1;
+            if (carry < 0){
+                mh |= 1;
+            }else if (carry > 0){
+                ph |= 1;
+            }
+
+            m_positive[b] = mh | ~(xv | ph);
+            m_negative[b] = ph & xv;
+            carry = carry_out;
+        }
+
+        score += carry;
+        best = std::min(best, score);
+    }
+
+    return substring ? best : score;
+}
+
+size_t LevenshteinScorer::distance(const std::u32string& str){
+    return run(str, false);
+}
+size_t LevenshteinScorer::distance_substring(const std::u32string& substring){
+    return run(substring, true);
+}
+
+
+
+}
+}
@@ -0,0 +1,67 @@
+/*  Levenshtein Scorer
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Bit-parallel (Myers/Hyyrö) edit distances of many strings against one
+ *  fixed text. The text is preprocessed once. Each string is then scored in
+ *  O(ceil(length / 64) * text_length) word operations instead of
+ *  O(length * text_length).
+ *
+ *  Scratch space is kept between calls, so after the first few strings,
+ *  scoring does not allocate.
+ *
+ */
+
+#ifndef PokemonAutomation_OCR_LevenshteinScorer_H
+#define PokemonAutomation_OCR_LevenshteinScorer_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+class LevenshteinScorer{
+public:
+    LevenshteinScorer(std::u32string text);
+
+    const std::u32string& text() const{ return m_text; }
+
+    //  Same as "levenshtein_distance(str, text)".
+    size_t distance(const std::u32string& str);
+
+    //  Same as "levenshtein_distance_substring(substring, text)".
+    //  The smallest edit distance between "substring" and any substring of the text.
+    size_t distance_substring(const std::u32string& substring);
+
+
+private:
+    //  Build the per-character match masks of "str" over the text alphabet.
+    //  Returns the # of 64-bit blocks.
+    size_t build_masks(const std::u32string& str);
+
+    size_t run(const std::u32string& str, bool substring);
+
+
+private:
+    std::u32string m_text;
+
+    //  Distinct characters in the text. Sorted.
+    std::vector<char32_t> m_alphabet;
+
+    //  For each character of the text, its index in "m_alphabet".
+    std::vector<uint32_t> m_text_index;
+
+    //  Scratch: [alphabet index][block] match masks, and the vertical deltas.
+    std::vector<uint64_t> m_masks;
+    std::vector<uint64_t> m_positive;
+    std::vector<uint64_t> m_negative;
+};
+
+
+
+}
+}
+#endif
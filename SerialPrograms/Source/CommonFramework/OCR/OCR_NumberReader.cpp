@@ -6,6 +6,7 @@
 
 #include "CommonFramework/Language.h"
 #include "OCR_RawOCR.h"
+#include "OCR_GlyphClassifier.h"
 #include "OCR_NumberReader.h"
 
 // #include <iostream>
@@ -17,9 +18,10 @@ namespace OCR{
 
 
 
-int read_number(Logger& logger, const ImageViewRGB32& image){
+namespace{
+
+int read_number_tesseract(Logger& logger, const ImageViewRGB32& image, std::string& normalized){
     std::string ocr_text = OCR::ocr_read(Language::English, image);
-    std::string normalized;
     bool has_digit = false;
     for (char ch : ocr_text){
         //  4 is commonly misread as A.
@@ -50,6 +52,44 @@ int read_number(Logger& logger, const ImageViewRGB32& image){
     return number;
 }
 
+}
+
+
+int read_number(Logger& logger, const ImageViewRGB32& image){
+    std::string normalized;
+    return read_number_tesseract(logger, image, normalized);
+}
+
+int read_number(Logger& logger, const ImageViewRGB32& image, GlyphClassifier& glyphs){
+    std::vector<GlyphClassifier::Glyph> segmented = GlyphClassifier::segment_dark_text(image);
+
+    std::string digits;
+    for (const GlyphClassifier::Glyph& glyph : segmented){
+        char ch = glyphs.classify(glyph);
+        if (ch < '0' || ch > '9'){
+            break;
+        }
+        digits += ch;
+    }
+    if (!segmented.empty() && digits.size() == segmented.size()){
+        int number = std::atoi(digits.c_str());
+        logger.log("Glyph Text: \"" + digits + "\" -> " + std::to_string(number));
+        return number;
+    }
+
+    std::string normalized;
+    int number = read_number_tesseract(logger, image, normalized);
+
+    //  Only learn if every digit lines up with a glyph.
+    if (number >= 0 && normalized.size() == segmented.size()){
+        for (size_t c = 0; c < segmented.size(); c++){
+            glyphs.learn(segmented[c], normalized[c]);
+        }
+    }
+
+    return number;
+}
+
 
 
 }
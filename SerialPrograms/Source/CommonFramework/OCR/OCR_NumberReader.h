@@ -12,11 +12,20 @@
 namespace PokemonAutomation{
     class ImageViewRGB32;
 namespace OCR{
+    class GlyphClassifier;
 
 
 //  Returns -1 if no number is found.
 int read_number(Logger& logger, const ImageViewRGB32& image);
 
+//  Same as above, but try to read the digits with "glyphs" first. Tesseract
+//  is only used if any digit is not recognized. Whatever Tesseract reads is
+//  then used to teach "glyphs". If the glyph classifiers are turned off
+//  (the default, see OCR_GlyphClassifier.h) this is the same as above.
+//
+//  "image" must be dark text on a light background.
+int read_number(Logger& logger, const ImageViewRGB32& image, GlyphClassifier& glyphs);
+
 
 }
 }
@@ -14,6 +14,7 @@
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "OCR_ResultCache.h"
 #include "OCR_RawOCR.h"
 
 #include <iostream>
@@ -163,6 +164,17 @@ std::string ocr_read(Language language, const ImageViewRGB32& image){
 //    static size_t c = 0;
 //    image.save("test-" + QString::number(c++) + ".png");
 
+    ResultCache& cache = ResultCache::instance();
+    bool use_cache = cache.enabled();
+    uint64_t image_hash = 0;
+    if (use_cache){
+        image_hash = ResultCache::hash_image(image);
+        std::string text;
+        if (cache.get_text(image_hash, language, text)){
+            return text;
+        }
+    }
+
     std::map<Language, TesseractPool>::iterator iter;
     {
         SpinLockGuard lg(ocr_pool_lock, "ocr_read()");
@@ -171,7 +183,12 @@ std::string ocr_read(Language language, const ImageViewRGB32& image){
             iter = ocr_pool.emplace(language, language).first;
         }
     }
-    return iter->second.run(image);
+    std::string text = iter->second.run(image);
+
+    if (use_cache){
+        cache.add_text(image_hash, language, text);
+    }
+    return text;
 }
 void ensure_instances(Language language, size_t instances){
     std::map<Language, TesseractPool>::iterator iter;
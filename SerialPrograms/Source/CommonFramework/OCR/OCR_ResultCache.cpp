@@ -0,0 +1,203 @@
+/*  OCR Result Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "OCR_ResultCache.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+
+ResultCache& ResultCache::instance(){
+    static ResultCache cache;
+    return cache;
+}
+
+
+namespace{
+
+const uint64_t PRIME0 = 0x9e3779b97f4a7c15;
+const uint64_t PRIME1 = 0xc2b2ae3d27d4eb4f;
+
+inline uint64_t rotl(uint64_t x, int bits){
+    return (x << bits) | (x >> (64 - bits));
+}
+inline uint64_t mix(uint64_t h, uint64_t x){
+    return rotl(h ^ (x * PRIME1), 31) * PRIME0;
+}
+inline uint64_t finalize(uint64_t h){
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccd;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53;
+    h ^= h >> 33;
+    return h;
+}
+
+}
+
+uint64_t ResultCache::hash_combine(uint64_t seed, uint64_t x){
+    return finalize(mix(seed, x));
+}
+uint64_t ResultCache::hash_image(const ImageViewRGB32& image){
+    size_t width = image.width();
+    size_t height = image.height();
+    uint64_t h = mix(mix(0, width), height);
+
+    const char* row = (const char*)image.data();
+    size_t bytes = width * sizeof(uint32_t);
+    for (size_t r = 0; r < height; r++){
+        size_t c = 0;
+        for (; c + sizeof(uint64_t) <= bytes; c += sizeof(uint64_t)){
+            uint64_t x;
+            memcpy(&x, row + c, sizeof(uint64_t));
+            h = mix(h, x);
+        }
+        if (c < bytes){
+            uint64_t x = 0;
+            memcpy(&x, row + c, bytes - c);
+            h = mix(h, x);
+        }
+        row += image.bytes_per_row();
+    }
+    return finalize(h);
+}
+uint64_t ResultCache::new_dictionary_id(){
+    static std::atomic<uint64_t> counter(0);
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+
+bool ResultCache::enabled() const{
+    return !m_suspended.load(std::memory_order_relaxed) && GlobalSettings::instance().OCR_CACHE_SIZE != 0;
+}
+void ResultCache::set_suspended(bool suspended){
+    m_suspended.store(suspended, std::memory_order_relaxed);
+}
+void ResultCache::clear(){
+    SpinLockGuard lg(m_lock, "ResultCache::clear()");
+    m_map.clear();
+    m_lru.clear();
+}
+
+ResultCache::Entry* ResultCache::find(const Key& key){
+    auto iter = m_map.find(key);
+    if (iter == m_map.end()){
+        return nullptr;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, iter->second);
+    return &*iter->second;
+}
+ResultCache::Entry& ResultCache::insert(const Key& key, size_t capacity){
+    Entry* existing = find(key);
+    if (existing != nullptr){
+        return *existing;
+    }
+
+    //  Make room. The size limit may have been lowered since the last insert.
+    while (m_lru.size() >= capacity){
+        m_map.erase(m_lru.back().key);
+        m_lru.pop_back();
+    }
+
+    m_lru.emplace_front();
+    try{
+        m_map.emplace(key, m_lru.begin());
+    }catch (...){
+        m_lru.pop_front();
+        throw;
+    }
+    Entry& entry = m_lru.front();
+    entry.key = key;
+    return entry;
+}
+
+
+
+bool ResultCache::get_text(uint64_t image_hash, Language language, std::string& text){
+    if (!enabled()){
+        return false;
+    }
+    {
+        SpinLockGuard lg(m_lock, "ResultCache::get_text()");
+        Entry* entry = find(Key{Kind::TEXT, image_hash, (uint64_t)language});
+        if (entry != nullptr){
+            text = entry->text;
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+void ResultCache::add_text(uint64_t image_hash, Language language, std::string text){
+    size_t capacity = GlobalSettings::instance().OCR_CACHE_SIZE;
+    if (capacity == 0 || m_suspended.load(std::memory_order_relaxed)){
+        return;
+    }
+    SpinLockGuard lg(m_lock, "ResultCache::add_text()");
+    insert(Key{Kind::TEXT, image_hash, (uint64_t)language}, capacity).text = std::move(text);
+}
+
+bool ResultCache::get_match(uint64_t image_hash, uint64_t context, StringMatchResult& result){
+    if (!enabled()){
+        return false;
+    }
+    {
+        SpinLockGuard lg(m_lock, "ResultCache::get_match()");
+        Entry* entry = find(Key{Kind::MATCH, image_hash, context});
+        if (entry != nullptr){
+            result = entry->match;
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+void ResultCache::add_match(uint64_t image_hash, uint64_t context, StringMatchResult result){
+    size_t capacity = GlobalSettings::instance().OCR_CACHE_SIZE;
+    if (capacity == 0 || m_suspended.load(std::memory_order_relaxed)){
+        return;
+    }
+    SpinLockGuard lg(m_lock, "ResultCache::add_match()");
+    insert(Key{Kind::MATCH, image_hash, context}, capacity).match = std::move(result);
+}
+
+ResultCache::Stats ResultCache::stats() const{
+    Stats ret;
+    ret.hits = m_hits.load(std::memory_order_relaxed);
+    ret.misses = m_misses.load(std::memory_order_relaxed);
+    SpinLockGuard lg(m_lock, "ResultCache::stats()");
+    ret.entries = m_lru.size();
+    return ret;
+}
+
+
+
+OverlayStatSnapshot ResultCacheStat::get_current(){
+    ResultCache::Stats stats = ResultCache::instance().stats();
+    uint64_t lookups = stats.hits + stats.misses;
+
+    //  Don't show anything until something has used OCR.
+    if (lookups == 0){
+        return OverlayStatSnapshot();
+    }
+    return OverlayStatSnapshot{
+        "OCR Cache: " + tostr_fixed(100. * stats.hits / lookups, 1) + "% hits (" +
+        tostr_u_commas(stats.entries) + " entries)"
+    };
+}
+
+
+
+}
+}
@@ -0,0 +1,127 @@
+/*  OCR Result Cache
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A global LRU cache of OCR results keyed by the content of the image.
+ *
+ *  Many programs OCR the exact same crop over and over. (static menus, box
+ *  slots that are revisited, lobby names that are polled) Each of those goes
+ *  through Tesseract at tens of milliseconds. With this cache, re-reading an
+ *  unchanged image costs a hash of its pixels.
+ *
+ */
+
+#ifndef PokemonAutomation_OCR_ResultCache_H
+#define PokemonAutomation_OCR_ResultCache_H
+
+#include <stdint.h>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <atomic>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "CommonFramework/Language.h"
+#include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
+#include "OCR_StringMatchResult.h"
+
+namespace PokemonAutomation{
+    class ImageViewRGB32;
+namespace OCR{
+
+
+class ResultCache{
+public:
+    static ResultCache& instance();
+
+    //  Hash of the dimensions and pixels of the image.
+    static uint64_t hash_image(const ImageViewRGB32& image);
+    static uint64_t hash_combine(uint64_t seed, uint64_t x);
+
+    //  Returns a number that has never been returned before. Use it to
+    //  identify the contents of a dictionary.
+    static uint64_t new_dictionary_id();
+
+    //  The cache is disabled if the size limit in the global settings is zero
+    //  or if it was suspended.
+    bool enabled() const;
+
+    //  Suspend the cache regardless of the settings. This is for benchmarks
+    //  that need every read to go through OCR.
+    void set_suspended(bool suspended);
+
+    //  Drop all entries.
+    void clear();
+
+    //  Raw OCR text of an image.
+    bool get_text(uint64_t image_hash, Language language, std::string& text);
+    void add_text(uint64_t image_hash, Language language, std::string text);
+
+    //  Dictionary match of an image. "context" must identify the dictionary
+    //  and every parameter that affects the result.
+    bool get_match(uint64_t image_hash, uint64_t context, StringMatchResult& result);
+    void add_match(uint64_t image_hash, uint64_t context, StringMatchResult result);
+
+    struct Stats{
+        uint64_t hits;
+        uint64_t misses;
+        size_t entries;
+    };
+    Stats stats() const;
+
+
+private:
+    enum class Kind : uint8_t{
+        TEXT,
+        MATCH,
+    };
+    struct Key{
+        Kind kind;
+        uint64_t image_hash;
+        uint64_t context;
+
+        bool operator==(const Key& x) const{
+            return kind == x.kind && image_hash == x.image_hash && context == x.context;
+        }
+    };
+    struct KeyHash{
+        size_t operator()(const Key& key) const{
+            return (size_t)hash_combine(hash_combine(key.image_hash, key.context), (uint64_t)key.kind);
+        }
+    };
+    struct Entry{
+        Key key;
+        std::string text;
+        StringMatchResult match;
+    };
+
+    ResultCache() = default;
+
+    //  Must be called under m_lock. Move the entry to the front if it exists.
+    Entry* find(const Key& key);
+
+    //  Must be called under m_lock. Add or replace an entry.
+    Entry& insert(const Key& key, size_t capacity);
+
+private:
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<bool> m_suspended{false};
+
+    mutable SpinLock m_lock;
+    std::list<Entry> m_lru;     //  Most recently used at the front.
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_map;
+};
+
+
+
+//  Overlay stat for the hit rate of the OCR cache.
+class ResultCacheStat : public OverlayStat{
+public:
+    virtual OverlayStatSnapshot get_current() override;
+};
+
+
+
+}
+}
+#endif
@@ -4,6 +4,11 @@
  *
  */
 
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include "Common/Cpp/Concurrency/ParallelTaskRunner.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTools/ImageFilter.h"
 #include "OCR_RawOCR.h"
@@ -14,11 +19,49 @@ namespace PokemonAutomation{
 namespace OCR{
 
 
+namespace{
+
+ParallelTaskRunner& ocr_task_runner(){
+    static ParallelTaskRunner runner(
+        [](){ GlobalSettings::instance().COMPUTE_PRIORITY0.set_on_this_thread(); },
+        0, 0
+    );
+    return runner;
+}
+
+//  Shared between multifiltered_OCR() and the OCR tasks it dispatches.
+//  If the caller exits early, the tasks that are still running keep this
+//  alive until they finish.
+struct MultifilteredOcrState{
+    struct Finished{
+        size_t index;
+        std::string text;
+        std::exception_ptr exception;
+    };
+
+    Language language;
+    std::vector<ImageRGB32> images;
+    std::atomic<bool> cancelled;
+
+    std::mutex lock;
+    std::condition_variable cv;
+    std::deque<Finished> finished;
+
+    MultifilteredOcrState(Language p_language)
+        : language(p_language)
+        , cancelled(false)
+    {}
+};
+
+}
+
+
 StringMatchResult multifiltered_OCR(
     Language language, const DictionaryMatcher& dictionary, const ImageViewRGB32& image,
     const std::vector<TextColorRange>& text_color_ranges,
     double log10p_spread,
-    double min_text_ratio, double max_text_ratio
+    double min_text_ratio, double max_text_ratio,
+    double early_exit_log10p
 ){
     if (image.width() == 0 || image.height() == 0){
         return StringMatchResult();
@@ -32,24 +75,98 @@ StringMatchResult multifiltered_OCR(
 
     double pixels_inv = 1. / (image.width() * image.height());
 
-    //  Run all the filters.
-    StringMatchResult ret;
-//    int c = 0;
-    for (const auto& filtered : filtered_images){
-        std::string text = ocr_read(language, filtered.first);
-//        cout << text.toStdString() << endl;
-//        filtered.first.save("test" + QString::number(c++) + ".png");
-
-        //  Compute ratio of image that matches text color. Skip if it's out of range.
+    //  Compute ratio of image that matches text color. Skip the filters that
+    //  are out of range so we don't waste an OCR on them.
+    std::shared_ptr<MultifilteredOcrState> state = std::make_shared<MultifilteredOcrState>(language);
+    for (auto& filtered : filtered_images){
         double ratio = filtered.second * pixels_inv;
 //        cout << "ratio = " << ratio << endl;
         if (ratio < min_text_ratio || ratio > max_text_ratio){
             continue;
         }
+        state->images.emplace_back(std::move(filtered.first));
+    }
+
+    //  Run all the filters. Each filter is OCR'ed on its own Tesseract
+    //  instance in parallel. The matching is done here as the results come in.
+    //
+    //  The early exit is taken at the lowest-index filter that is good
+    //  enough, and only once every filter before it has finished. Only the
+    //  filters up to and including that one are merged. So the result never
+    //  depends on which thread finished first.
+    const size_t filters = state->images.size();
+    std::vector<StringMatchResult> results(filters);
+    std::vector<std::exception_ptr> exceptions(filters);
+    std::vector<bool> finished(filters, false);
+    size_t merge_end = filters;
+    if (filters == 1){
+        std::string text = ocr_read(language, state->images[0]);
+        results[0] = dictionary.match_substring(language, text, log10p_spread);
+        finished[0] = true;
+    }else if (filters > 1){
+        ParallelTaskRunner& runner = ocr_task_runner();
+        for (size_t c = 0; c < state->images.size(); c++){
+            runner.dispatch([state, c]{
+                MultifilteredOcrState::Finished item{c, std::string(), nullptr};
+                if (!state->cancelled.load(std::memory_order_acquire)){
+                    try{
+                        item.text = ocr_read(state->language, state->images[c]);
+                    }catch (...){
+                        item.exception = std::current_exception();
+                    }
+                }
+                std::lock_guard<std::mutex> lg(state->lock);
+                state->finished.emplace_back(std::move(item));
+                state->cv.notify_all();
+            });
+        }
 
-        StringMatchResult current = dictionary.match_substring(language, text, log10p_spread);
-        ret.exact_match |= current.exact_match;
-        ret.results.insert(current.results.begin(), current.results.end());
+        //  All filters before "next" have finished and none of them was
+        //  good enough to exit on.
+        size_t next = 0;
+        while (next < filters){
+            MultifilteredOcrState::Finished item;
+            {
+                std::unique_lock<std::mutex> lg(state->lock);
+                state->cv.wait(lg, [&]{ return !state->finished.empty(); });
+                item = std::move(state->finished.front());
+                state->finished.pop_front();
+            }
+            if (item.exception){
+                exceptions[item.index] = std::move(item.exception);
+            }else{
+//                cout << item.text << endl;
+                results[item.index] = dictionary.match_substring(language, item.text, log10p_spread);
+            }
+            finished[item.index] = true;
+
+            for (; next < filters && finished[next]; next++){
+                if (exceptions[next]){
+                    state->cancelled.store(true, std::memory_order_release);
+                    std::rethrow_exception(exceptions[next]);
+                }
+
+                //  This filter found a match good enough that the later
+                //  filters won't change the outcome. Don't wait for them.
+                const StringMatchResult& current = results[next];
+                if (!current.results.empty() && current.results.begin()->first <= early_exit_log10p){
+                    state->cancelled.store(true, std::memory_order_release);
+                    merge_end = next + 1;
+                    break;
+                }
+            }
+            if (merge_end != filters){
+                break;
+            }
+        }
+    }
+
+    //  Merge in filter order so the result doesn't depend on which filter
+    //  finished first.
+    StringMatchResult ret;
+    for (size_t c = 0; c < merge_end; c++){
+        ret.exact_match |= results[c].exact_match;
+        ret.results.insert(results[c].results.begin(), results[c].results.end());
     }
 
 //    ret.log(global_logger_tagged(), -1.5);
@@ -8,6 +8,7 @@
 #define PokemonAutomation_OCR_Routines_H
 
 #include <vector>
+#include <limits>
 #include "CommonFramework/Language.h"
 
 namespace PokemonAutomation{
@@ -30,11 +31,19 @@ struct TextColorRange{
 };
 
 
+//  Filters whose text ratio falls outside [min_text_ratio, max_text_ratio]
+//  are skipped. The rest are OCR'ed in parallel.
+//
+//  Once the first filter (in filter order) to produce a match with log10p at
+//  or below "early_exit_log10p" has finished, along with every filter before
+//  it, the later filters are dropped. The result is the same no matter which
+//  filters finish first.
 StringMatchResult multifiltered_OCR(
     Language language, const DictionaryMatcher& dictionary, const ImageViewRGB32& image,
     const std::vector<TextColorRange>& text_color_ranges,
     double log10p_spread,
-    double min_text_ratio = 0.01, double max_text_ratio = 0.50
+    double min_text_ratio = 0.01, double max_text_ratio = 0.50,
+    double early_exit_log10p = -std::numeric_limits<double>::infinity()
 );
 
 
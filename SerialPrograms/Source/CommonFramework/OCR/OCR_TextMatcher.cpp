@@ -6,10 +6,13 @@
 
 #include <cmath>
 #include <vector>
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Qt/StringToolsQt.h"
 #include "OCR_StringNormalization.h"
+#include "OCR_LevenshteinScorer.h"
+#include "OCR_DictionaryIndex.h"
 #include "OCR_TextMatcher.h"
 
 #include <iostream>
@@ -99,71 +102,17 @@ size_t levenshtein_distance_substring(const QString& substring, const QString& f
     return min;
 }
 
+//  The UTF-32 versions are on the OCR hot path. They use the bit-parallel
+//  scorer instead of the full DP table.
 template <typename StringType>
 size_t levenshtein_distance(const StringType& x, const StringType& y){
-    size_t xlen = x.size();
-    size_t ylen = y.size();
-
-    std::vector<size_t> v0(ylen + 1);
-    std::vector<size_t> v1(ylen + 1);
-
-    for (size_t i = 0; i <= ylen; i++){
-        v0[i] = i;
-    }
-
-    for (size_t i = 0; i < xlen; i++){
-        v1[0] = i + 1;
-
-        for (size_t j = 0; j < ylen; j++){
-            size_t delete_cost = v0[j + 1] + 1;
-            size_t insert_cost = v1[j] + 1;
-            size_t sub_cost = v0[j];
-            if (x[i] != y[j]){
-                sub_cost += 1;
-            }
-            v1[j + 1] = std::min({delete_cost, insert_cost, sub_cost});
-        }
-
-        std::swap(v0, v1);
-    }
-
-    return v0[ylen];
+    LevenshteinScorer scorer(y);
+    return scorer.distance(x);
 }
 template <typename StringType>
 size_t levenshtein_distance_substring(const StringType& substring, const StringType& fullstring){
-    size_t xlen = fullstring.size();
-    size_t ylen = substring.size();
-
-    std::vector<size_t> v0(ylen + 1);
-    std::vector<size_t> v1(ylen + 1);
-
-    for (size_t i = 0; i <= ylen; i++){
-        v0[i] = i;
-    }
-//    print(v0);
-
-    size_t min = ylen;
-
-    for (size_t i = 0; i < xlen; i++){
-        v1[0] = 0;
-
-        for (size_t j = 0; j < ylen; j++){
-            size_t delete_cost = v0[j + 1] + 1;
-            size_t insert_cost = v1[j] + 1;
-            size_t sub_cost = v0[j];
-            if (fullstring[i] != substring[j]){
-                sub_cost += 1;
-            }
-            v1[j + 1] = std::min({delete_cost, insert_cost, sub_cost});
-        }
-
-        std::swap(v0, v1);
-
-        min = std::min(min, v0[ylen]);
-//        print(v0);
-    }
-
-    return min;
+    LevenshteinScorer scorer(fullstring);
+    return scorer.distance_substring(substring);
 }
 template size_t levenshtein_distance<std::u32string>(const std::u32string& x, const std::u32string& y);
 template size_t levenshtein_distance_substring<std::u32string>(const std::u32string& x, const std::u32string& y);
@@ -248,6 +197,29 @@ double random_match_probability(size_t total, size_t matched, double random_matc
 
 
 
+//  If "normalized" is exactly one of the candidates, fill in "results" and
+//  return true.
+bool match_exact(
+    StringMatchResult& results,
+    const std::map<std::u32string, std::set<std::string>>& database, double random_match_chance,
+    const std::string& text, const std::u32string& normalized
+){
+    auto iter = database.find(normalized);
+    if (iter == database.end()){
+        return false;
+    }
+    results.exact_match = true;
+    double probability = random_match_probability(normalized.size(), normalized.size(), random_match_chance);
+    double log10p = std::log10(probability);
+    for (const auto& target : iter->second){
+        results.add(
+            log10p,
+            StringMatchData{text, normalized, normalized, target}
+        );
+    }
+    return true;
+}
+
 StringMatchResult match_substring(
     const std::map<std::u32string, std::set<std::string>>& database, double random_match_chance,
     const std::string& text, double log10p_spread
@@ -259,25 +231,17 @@ StringMatchResult match_substring(
     std::u32string normalized = normalize_utf32(text);
 
     //  Search for exact match of candidate.
-    auto iter = database.find(normalized);
-    if (iter != database.end()){
-        results.exact_match = true;
-        double probability = random_match_probability(normalized.size(), normalized.size(), random_match_chance);
-        double log10p = std::log10(probability);
-        for (const auto& target : iter->second){
-            results.add(
-                log10p,
-                StringMatchData{text, normalized, normalized, target}
-            );
-        }
+    if (match_exact(results, database, random_match_chance, text, normalized)){
         return results;
     }
 
 
+    //  Preprocess the text once and score every token against it.
+    LevenshteinScorer scorer(normalized);
     for (const auto& item : database){
         double token_length = item.first.size();
 
-        size_t distance = levenshtein_distance_substring(item.first, normalized);
+        size_t distance = scorer.distance_substring(item.first);
         size_t matched = token_length - distance;
         if (matched == 0){
             continue;
@@ -302,6 +266,164 @@ StringMatchResult match_substring(
 
 
 
+StringMatchResult match_substring(
+    const std::map<std::u32string, std::set<std::string>>& database, const DictionaryIndex& index,
+    double random_match_chance,
+    const std::string& text, double log10p_spread
+){
+    StringMatchResult results;
+
+    std::u32string normalized = normalize_utf32(text);
+
+    //  Search for exact match of candidate.
+    if (match_exact(results, database, random_match_chance, text, normalized)){
+        return results;
+    }
+
+    //  Either a single entry or a whole length bucket of entries that share
+    //  no trigrams with the text.
+    struct Candidate{
+        double min_log10p;
+        uint32_t entry;
+        const std::vector<uint32_t>* bucket;
+    };
+    std::vector<Candidate> must_score;
+    std::vector<Candidate> maybe_score;
+
+    //  The best log10p a candidate of "length" can get if "shared" of its
+    //  trigram positions also appear in the text. Returns false if it can't
+    //  match at all.
+    //  "must" is set for candidates that are always scored: those that could
+    //  match exactly (they set "exact_match" even if they don't make it into
+    //  the results) and those the bound doesn't cover.
+    auto bound = [&](double& min_log10p, bool& must, size_t length, size_t shared){
+        must = length < 3 || length > 62 || shared >= length - 2;
+        if (must){
+            min_log10p = 0;
+            return true;
+        }
+        size_t min_distance = (length - 2 - shared + 2) / 3;
+        if (length > normalized.size()){
+            min_distance = std::max(min_distance, length - normalized.size());
+        }
+        if (min_distance >= length){
+            return false;
+        }
+        double probability = random_match_probability(length, length - min_distance, random_match_chance);
+        min_log10p = std::log10(probability);
+        return true;
+    };
+
+    std::vector<DictionaryIndex::SharedCount> shared = index.shared_trigrams(normalized);
+    for (const DictionaryIndex::SharedCount& item : shared){
+        double min_log10p;
+        bool must;
+        if (bound(min_log10p, must, index.entry(item.entry).first.size(), item.shared)){
+            (must ? must_score : maybe_score).emplace_back(Candidate{min_log10p, item.entry, nullptr});
+        }
+    }
+
+    //  Everything that shares no trigrams. These all have the same bound for
+    //  the same length. So handle entire lengths at a time.
+    for (const auto& bucket : index.length_buckets()){
+        double min_log10p;
+        bool must;
+        if (bound(min_log10p, must, bucket.first, 0)){
+            (must ? must_score : maybe_score).emplace_back(Candidate{min_log10p, 0, &bucket.second});
+        }
+    }
+
+    std::sort(
+        maybe_score.begin(), maybe_score.end(),
+        [](const Candidate& a, const Candidate& b){
+            return a.min_log10p < b.min_log10p;
+        }
+    );
+
+    struct Scored{
+        const DictionaryIndex::Entry* entry;
+        double log10p;
+        bool exact;
+    };
+    std::vector<Scored> scored;
+
+    LevenshteinScorer scorer(normalized);
+    double best = 0;
+    bool have_best = false;
+    auto score = [&](uint32_t entry){
+        const DictionaryIndex::Entry& item = index.entry(entry);
+        double token_length = item.first.size();
+
+        size_t distance = scorer.distance_substring(item.first);
+        size_t matched = token_length - distance;
+        if (matched == 0){
+            return;
+        }
+
+        double probability = random_match_probability(token_length, matched, random_match_chance);
+        double log10p = std::log10(probability);
+        scored.emplace_back(Scored{&item, log10p, distance == 0});
+
+        if (!have_best || best > log10p){
+            best = log10p;
+            have_best = true;
+        }
+    };
+
+    auto process = [&](const Candidate& candidate){
+        if (candidate.bucket == nullptr){
+            score(candidate.entry);
+            return;
+        }
+        for (uint32_t entry : *candidate.bucket){
+            //  Skip the ones that were already handled individually.
+            auto iter = std::lower_bound(
+                shared.begin(), shared.end(), entry,
+                [](const DictionaryIndex::SharedCount& a, uint32_t b){
+                    return a.entry < b;
+                }
+            );
+            if (iter != shared.end() && iter->entry == entry){
+                continue;
+            }
+            score(entry);
+        }
+    };
+
+    for (const Candidate& candidate : must_score){
+        process(candidate);
+    }
+    for (const Candidate& candidate : maybe_score){
+        //  Everything from here on is worse than the best + spread.
+        if (have_best && candidate.min_log10p > best + log10p_spread){
+            break;
+        }
+        process(candidate);
+    }
+
+    //  Add in dictionary order so ties come out the same as the exhaustive search.
+    std::sort(
+        scored.begin(), scored.end(),
+        [](const Scored& a, const Scored& b){
+            return a.entry->first < b.entry->first;
+        }
+    );
+    for (const Scored& item : scored){
+        if (item.exact){
+            results.exact_match = true;
+        }
+        for (const auto& slug : item.entry->second){
+            results.add(item.log10p, StringMatchData{text, normalized, item.entry->first, slug});
+            results.clear_beyond_spread(log10p_spread);
+        }
+    }
+
+    return results;
+}
+
+
+
+
 
 
 
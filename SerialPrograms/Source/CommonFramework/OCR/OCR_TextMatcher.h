@@ -18,6 +18,8 @@
 namespace PokemonAutomation{
 namespace OCR{
 
+class DictionaryIndex;
+
 
 size_t levenshtein_distance(const QString& x, const QString& y);
 size_t levenshtein_distance_substring(const QString& substring, const QString& fullstring);
@@ -38,6 +40,14 @@ StringMatchResult match_substring(
     const std::string& text, double log10p_spread
 );
 
+//  Same result as above. But "index" is used to skip candidates that cannot
+//  make it into the results. "index" must contain every entry of "database".
+StringMatchResult match_substring(
+    const std::map<std::u32string, std::set<std::string>>& database, const DictionaryIndex& index,
+    double random_match_chance,
+    const std::string& text, double log10p_spread
+);
+
 
 
 
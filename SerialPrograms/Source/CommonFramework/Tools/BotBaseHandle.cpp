@@ -17,6 +17,7 @@
 #include "ClientSource/Connection/SerialConnection.h"
 #include "ClientSource/Connection/PABotBase.h"
 #include "CommonFramework/Globals.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Options/Environment/ThemeSelectorOption.h"
 #include "NintendoSwitch/Commands/NintendoSwitch_Commands_Device.h"
 #include "BotBaseHandle.h"
@@ -243,6 +244,17 @@ void BotBaseHandle::verify_protocol(){
             "Please install the .hex that came with this version of the program."
         );
     }
+
+    //  Newer devices can take more commands at once. This is still
+    //  experimental and is off unless enabled in the debug settings.
+    if (PreloadSettings::debug().SERIAL_PIPELINING &&
+        version_lo >= PABB_PROTOCOL_VERSION_PIPELINE % 100
+    ){
+        size_t queue_size;
+        size_t max_batch_size;
+        Microcontroller::pipeline_info(*m_botbase, queue_size, max_batch_size);
+        m_botbase->enable_pipelining(queue_size, max_batch_size);
+    }
 }
 uint8_t BotBaseHandle::verify_pabotbase(){
     using namespace PokemonAutomation;
@@ -9,6 +9,7 @@
 #include "Common/Cpp/PrettyPrint.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/Logging/Logger.h"
+#include "ImageEncoder.h"
 
 namespace PokemonAutomation{
 
@@ -33,7 +34,7 @@ std::string dump_debug_image(
     std::string full_path = debug_dump_folder_name;
     full_path += "/" + path + "/" + now_to_filestring() + "-" + label + ".jpg";
     logger.log("Saving debug image to: " + full_path, COLOR_YELLOW);
-    image.save(full_path);
+    ImageEncoder::instance().save(image, full_path);
     return full_path;
 }
 
@@ -15,7 +15,7 @@ class ImageViewRGB32;
 class Logger;
 
 // Dump debug image to ./DebugDumps/`path`/<timestamp>-`label`.jpg
-// Return image path.
+// The image is saved in the background. Return image path.
 std::string dump_debug_image(
     Logger& logger,
     const std::string& path,
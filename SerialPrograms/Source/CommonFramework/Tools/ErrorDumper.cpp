@@ -16,6 +16,7 @@
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "ConsoleHandle.h"
+#include "ImageEncoder.h"
 #include "ErrorDumper.h"
 #include "ProgramEnvironment.h"
 namespace PokemonAutomation{
@@ -37,7 +38,7 @@ std::string dump_image(
     name += label;
     name += ".png";
     logger.log("Saving failed inference image to: " + name, COLOR_RED);
-    image.save(name);
+    ImageEncoder::instance().save(image, name, ImageEncodeCompression::FAST);
     send_program_telemetry(
         logger, true, COLOR_RED,
         program_info,
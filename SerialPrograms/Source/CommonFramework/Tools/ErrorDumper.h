@@ -20,7 +20,7 @@ class ProgramEnvironment;
 struct ProgramInfo;
 
 // Dump error image to ./ErrorDumps/ folder. Also send image as telemetry if user allows.
-// Return image path.
+// The image is saved in the background. Return image path.
 std::string dump_image(
     Logger& logger,
     const ProgramInfo& program_info, const std::string& label,
@@ -0,0 +1,168 @@
+/*  Image Encoder
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <QFile>
+#include <QImage>
+#include "Common/Cpp/PanicDump.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "ImageEncoder.h"
+
+namespace PokemonAutomation{
+
+
+//  QImage maps PNG quality to zlib level as: (100 - quality) * 9 / 91
+//  So this is level 1.
+const int FAST_PNG_QUALITY = 80;
+
+
+
+bool ImageEncodeTask::wait(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_cv.wait(lg, [this]{ return m_finished; });
+    return m_saved;
+}
+void ImageEncodeTask::discard(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_discarded = true;
+    if (m_finished && m_saved){
+        QFile file(QString::fromStdString(m_filepath));
+        file.remove();
+        m_saved = false;
+    }
+}
+
+
+
+ImageEncoder& ImageEncoder::instance(){
+    static ImageEncoder encoder;
+    return encoder;
+}
+ImageEncoder::ImageEncoder()
+    : m_stopping(false)
+{}
+ImageEncoder::~ImageEncoder(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_thread_cv.notify_all();
+        m_dispatch_cv.notify_all();
+    }
+    //  The threads drain the queue before they exit. Anything that was
+    //  queued is still written.
+    for (std::thread& thread : m_threads){
+        thread.join();
+    }
+    for (const std::shared_ptr<ImageEncodeTask>& task : m_queue){
+        finish(*task, encode(*task));
+    }
+}
+
+std::shared_ptr<ImageEncodeTask> ImageEncoder::save(
+    const ImageViewRGB32& image, std::string filepath,
+    ImageEncodeCompression compression
+){
+    //  Copy the image before queuing it since the caller's buffer may not
+    //  outlive the encode.
+    std::shared_ptr<ImageEncodeTask> task(
+        new ImageEncodeTask(std::move(filepath), image.copy(), compression)
+    );
+
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_dispatch_cv.wait(lg, [this]{
+        return m_queue.size() < MAX_QUEUE_SIZE || m_stopping;
+    });
+    if (m_stopping){
+        lg.unlock();
+        finish(*task, false);
+        return task;
+    }
+
+    m_queue.emplace_back(task);
+    m_in_flight[task->filepath()] = task;
+
+    //  Lazy create threads.
+    if (m_threads.size() < THREADS && m_threads.size() < m_queue.size()){
+        m_threads.emplace_back(run_with_catch, "ImageEncoder::thread_loop()", [this]{ thread_loop(); });
+    }
+
+    m_thread_cv.notify_one();
+    return task;
+}
+std::shared_ptr<ImageEncodeTask> ImageEncoder::find(const std::string& filepath){
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto iter = m_in_flight.find(filepath);
+    if (iter == m_in_flight.end()){
+        return nullptr;
+    }
+    return iter->second.lock();
+}
+
+bool ImageEncoder::encode(ImageEncodeTask& task){
+    {
+        std::lock_guard<std::mutex> lg(task.m_lock);
+        if (task.m_discarded){
+            return false;
+        }
+    }
+
+    const std::string& path = task.m_filepath;
+    int quality = -1;
+    if (task.m_compression == ImageEncodeCompression::FAST &&
+        path.size() >= 4 && path.compare(path.size() - 4, 4, ".png") == 0
+    ){
+        quality = FAST_PNG_QUALITY;
+    }
+
+    bool saved = task.m_image.to_QImage_ref().save(QString::fromStdString(path), nullptr, quality);
+    if (!saved){
+        global_logger_tagged().log("Unable to save image to: " + path, COLOR_RED);
+    }
+    return saved;
+}
+void ImageEncoder::finish(ImageEncodeTask& task, bool saved){
+    std::lock_guard<std::mutex> lg(task.m_lock);
+    task.m_image = ImageRGB32();
+    if (saved && task.m_discarded){
+        QFile file(QString::fromStdString(task.m_filepath));
+        file.remove();
+        saved = false;
+    }
+    task.m_saved = saved;
+    task.m_finished = true;
+    task.m_cv.notify_all();
+}
+
+void ImageEncoder::thread_loop(){
+    while (true){
+        std::shared_ptr<ImageEncodeTask> task;
+        {
+            std::unique_lock<std::mutex> lg(m_lock);
+            if (m_queue.empty()){
+                if (m_stopping){
+                    return;
+                }
+                m_thread_cv.wait(lg);
+                continue;
+            }
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_dispatch_cv.notify_one();
+        }
+
+        finish(*task, encode(*task));
+
+        std::lock_guard<std::mutex> lg(m_lock);
+        auto iter = m_in_flight.find(task->filepath());
+        if (iter != m_in_flight.end() && iter->second.lock() == task){
+            m_in_flight.erase(iter);
+        }
+    }
+}
+
+
+
+
+}
@@ -0,0 +1,118 @@
+/*  Image Encoder
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Encode and save images to disk on background threads.
+ *
+ *  Encoding a 1080p frame to PNG takes long enough to visibly stall a program
+ *  thread. And it tends to happen at exactly the moments where timing matters
+ *  (shiny found, error recovery). So screenshots for notifications and error
+ *  dumps are handed off to this service instead of being saved inline.
+ *
+ */
+
+#ifndef PokemonAutomation_ImageEncoder_H
+#define PokemonAutomation_ImageEncoder_H
+
+#include <string>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+
+namespace PokemonAutomation{
+
+
+enum class ImageEncodeCompression{
+    //  The normal compression of the format. Use this for anything that gets uploaded.
+    NORMAL,
+    //  Low-compression PNG. Much faster to encode than NORMAL, but the file
+    //  is larger. Use this for local archiving. (no effect on JPG)
+    FAST,
+};
+
+
+
+//  Handle to an image that's being encoded.
+class ImageEncodeTask{
+public:
+    const std::string& filepath() const{ return m_filepath; }
+
+    //  Wait for the image to be written. Returns true if it was saved successfully.
+    bool wait();
+
+    //  The file is no longer wanted. If it hasn't been encoded yet, skip it.
+    //  If it's being encoded, delete it as soon as it's done.
+    void discard();
+
+private:
+    friend class ImageEncoder;
+
+    ImageEncodeTask(std::string filepath, ImageRGB32 image, ImageEncodeCompression compression)
+        : m_filepath(std::move(filepath))
+        , m_image(std::move(image))
+        , m_compression(compression)
+    {}
+
+private:
+    const std::string m_filepath;
+    ImageRGB32 m_image;
+    const ImageEncodeCompression m_compression;
+
+    bool m_finished = false;
+    bool m_saved = false;
+    bool m_discarded = false;
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+};
+
+
+
+class ImageEncoder{
+public:
+    //  Max # of images waiting to be encoded. If the queue is full, save()
+    //  blocks until there is room.
+    static const size_t MAX_QUEUE_SIZE = 8;
+    static const size_t THREADS = 2;
+
+    static ImageEncoder& instance();
+
+    //  Copy "image" and save it to "filepath" on a background thread.
+    //  The format is determined by the extension of "filepath".
+    std::shared_ptr<ImageEncodeTask> save(
+        const ImageViewRGB32& image, std::string filepath,
+        ImageEncodeCompression compression = ImageEncodeCompression::NORMAL
+    );
+
+    //  If an image is currently being encoded to "filepath", return its task.
+    //  Otherwise return null.
+    std::shared_ptr<ImageEncodeTask> find(const std::string& filepath);
+
+
+private:
+    ImageEncoder();
+    ~ImageEncoder();
+
+    void thread_loop();
+    static bool encode(ImageEncodeTask& task);
+    void finish(ImageEncodeTask& task, bool saved);
+
+private:
+    std::deque<std::shared_ptr<ImageEncodeTask>> m_queue;
+    std::map<std::string, std::weak_ptr<ImageEncodeTask>> m_in_flight;
+    std::vector<std::thread> m_threads;
+    bool m_stopping;
+    std::mutex m_lock;
+    std::condition_variable m_thread_cv;
+    std::condition_variable m_dispatch_cv;
+};
+
+
+
+
+}
+#endif
@@ -15,6 +15,7 @@
 #elif QT_VERSION_MAJOR == 6
 #include "CameraWidgetQt6.h"
 #endif
+#include "CameraWidgetReplay.h"
 
 
 namespace PokemonAutomation{
@@ -56,6 +57,10 @@ struct CameraBackends{
             std::make_unique<CameraQt6QVideoSink::CameraBackend>()
         );
 #endif
+        m_backends.emplace_back(
+            "file-Replay", "File: Recorded Session Replay",
+            std::make_unique<CameraFileReplay::CameraBackend>()
+        );
 
         size_t items = 0;
         for (const auto& item : m_backends){
@@ -82,7 +82,6 @@ CameraSession::CameraSession(Logger& logger, Resolution default_resolution)
     , m_default_resolution(default_resolution)
     , m_resolution(default_resolution)
     , m_last_frame_seqnum(0)
-    , m_last_image_timestamp(WallClock::min())
     , m_stats_conversion("ConvertFrame", "ms", 1000, std::chrono::seconds(10))
 {}
 
@@ -178,34 +177,35 @@ VideoSnapshot CameraSession::snapshot(){
     {
         SpinLockGuard lg0(m_frame_lock);
         frame_seqnum = m_last_frame_seqnum;
-        if (!m_last_image.isNull() && m_last_image_seqnum == frame_seqnum){
-            return VideoSnapshot(m_last_image, m_last_image_timestamp);
+        if (m_last_image && m_last_image_seqnum == frame_seqnum){
+            return m_last_image;
         }
         frame = m_last_frame;
         frame_timestamp = m_last_frame_timestamp;
     }
 
     if (!frame.isValid()){
-        global_logger_tagged().log("QVideoFrame is null.", COLOR_RED);
+        m_logger.log("QVideoFrame is null.", COLOR_RED);
         return VideoSnapshot();
     }
 
     WallClock time0 = current_time();
 
-    QImage image = frame.toImage();
-    QImage::Format format = image.format();
-    if (format != QImage::Format_ARGB32 && format != QImage::Format_RGB32){
-        image = image.convertToFormat(QImage::Format_ARGB32);
+    std::shared_ptr<const ImageRGB32> image = m_converter.convert(m_logger, std::move(frame));
+    if (!image){
+        m_logger.log("Unable to convert QVideoFrame.", COLOR_RED);
+        return VideoSnapshot();
     }
 
-    m_last_image = std::move(image);
-    m_last_image_timestamp = frame_timestamp;
+    //  Keep the whole snapshot so every caller of this frame shares its
+    //  summed-area table.
+    m_last_image = VideoSnapshot(std::move(image), frame_timestamp);
     m_last_image_seqnum = frame_seqnum;
 
     WallClock time1 = current_time();
     m_stats_conversion.report_data(m_logger, std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count());
 
-    return VideoSnapshot(m_last_image, m_last_image_timestamp);
+    return m_last_image;
 }
 double CameraSession::fps_source(){
     SpinLockGuard lg(m_frame_lock);
@@ -239,8 +239,7 @@ void CameraSession::shutdown(){
     m_last_frame_timestamp = current_time();
     m_last_frame_seqnum++;
 
-    m_last_image = QImage();
-    m_last_image_timestamp = m_last_frame_timestamp;
+    m_last_image.clear();
     m_last_image_seqnum = m_last_frame_seqnum;
 
 }
@@ -23,6 +23,7 @@
 #include "CommonFramework/VideoPipeline/CameraSession.h"
 #include "CommonFramework/VideoPipeline/UI/VideoWidget.h"
 #include "CameraImplementations.h"
+#include "VideoToolsQt6.h"
 
 class QCamera;
 class QVideoSink;
@@ -114,9 +115,9 @@ private:
     uint64_t m_last_frame_seqnum = 0;
 
     //  Last Cached Image
-    QImage m_last_image;
-    WallClock m_last_image_timestamp;
+    VideoSnapshot m_last_image;
     uint64_t m_last_image_seqnum = 0;
+    QVideoFrameConverter m_converter;
     PeriodicStatsReporterI32 m_stats_conversion;
 
     std::set<Listener*> m_ui_listeners;
@@ -0,0 +1,270 @@
+/*  Video Widget (Replay)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <QDir>
+#include <QTimer>
+#include <QPainter>
+#include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/VideoPipeline/CameraOption.h"
+#include "CameraWidgetReplay.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace CameraFileReplay{
+
+
+
+const std::string CameraBackend::RECORDINGS_FOLDER = "Recordings";
+
+std::vector<CameraInfo> CameraBackend::get_all_cameras() const{
+    std::vector<CameraInfo> ret;
+    for (std::string& folder : VideoReplaySource::find_recordings(RECORDINGS_FOLDER)){
+        ret.emplace_back(std::move(folder));
+    }
+    return ret;
+}
+std::string CameraBackend::get_camera_name(const CameraInfo& info) const{
+    return "Replay: " + QDir(QString::fromStdString(info.device_name())).dirName().toStdString();
+}
+std::unique_ptr<PokemonAutomation::CameraSession> CameraBackend::make_camera(Logger& logger, Resolution) const{
+    return std::make_unique<CameraSession>(logger);
+}
+
+
+
+
+void CameraSession::add_listener(Listener& listener){
+    m_sanitizer.check_usage();
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_listeners.insert(&listener);
+}
+void CameraSession::remove_listener(Listener& listener){
+    m_sanitizer.check_usage();
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_listeners.erase(&listener);
+}
+
+CameraSession::~CameraSession(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    shutdown();
+}
+CameraSession::CameraSession(Logger& logger)
+    : m_logger(logger)
+    , m_last_served(WallClock::min())
+{}
+
+void CameraSession::get(CameraOption& option){
+    std::lock_guard<std::mutex> lg(m_lock);
+    option.info = m_device;
+    option.current_resolution = m_source ? m_source->resolution() : Resolution();
+}
+void CameraSession::set(const CameraOption& option){
+    std::lock_guard<std::mutex> lg(m_lock);
+    shutdown();
+    m_device = option.info;
+    startup();
+}
+void CameraSession::reset(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    shutdown();
+    startup();
+}
+void CameraSession::set_source(CameraInfo device){
+    std::lock_guard<std::mutex> lg(m_lock);
+    shutdown();
+    m_device = std::move(device);
+    startup();
+}
+void CameraSession::set_resolution(Resolution){
+    //  A recording only has the resolution it was recorded at.
+}
+CameraInfo CameraSession::current_device() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_device;
+}
+Resolution CameraSession::current_resolution() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_source ? m_source->resolution() : Resolution();
+}
+std::vector<Resolution> CameraSession::supported_resolutions() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    std::vector<Resolution> ret;
+    if (m_source){
+        ret.emplace_back(m_source->resolution());
+    }
+    return ret;
+}
+
+VideoSnapshot CameraSession::snapshot(){
+    return serve(false);
+}
+VideoSnapshot CameraSession::inference_snapshot(){
+    return serve(true);
+}
+VideoSnapshot CameraSession::serve(bool advance){
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (!m_source){
+        return VideoSnapshot();
+    }
+
+    VideoSnapshot ret;
+    try{
+        ret = advance ? m_source->next_frame() : m_source->snapshot();
+    }catch (FileException& e){
+        m_logger.log("Unable to read recording: " + e.message(), COLOR_RED);
+        return VideoSnapshot();
+    }
+
+    //  Only count new frames.
+    SpinLockGuard lg0(m_stats_lock);
+    if (ret.timestamp != m_last_served){
+        m_last_served = ret.timestamp;
+        m_fps_tracker_source.push_event();
+    }
+    return ret;
+}
+double CameraSession::fps_source(){
+    SpinLockGuard lg(m_stats_lock);
+    return m_fps_tracker_source.events_per_second();
+}
+double CameraSession::fps_display(){
+    SpinLockGuard lg(m_stats_lock);
+    return m_fps_tracker_display.events_per_second();
+}
+
+VideoSnapshot CameraSession::display_frame(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (!m_source){
+            return VideoSnapshot();
+        }
+        if (m_source->pacing() == VideoReplaySource::Pacing::AS_FAST_AS_POSSIBLE){
+            return m_source->current_frame();
+        }
+    }
+    return snapshot();
+}
+double CameraSession::replay_fps() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_source ? m_source->fps() : 0;
+}
+void CameraSession::report_rendered_frame(WallClock timestamp){
+    SpinLockGuard lg(m_stats_lock);
+    m_fps_tracker_display.push_event(timestamp);
+}
+
+
+void CameraSession::shutdown(){
+    if (!m_source){
+        return;
+    }
+    m_logger.log("Stopping Replay...");
+    for (Listener* listener : m_listeners){
+        listener->shutdown();
+    }
+    m_source.reset();
+
+    SpinLockGuard lg(m_stats_lock);
+    m_last_served = WallClock::min();
+}
+void CameraSession::startup(){
+    if (!m_device){
+        return;
+    }
+    const std::string& folder = m_device.device_name();
+    m_logger.log("Starting Replay: " + folder);
+
+    try{
+        m_source.reset(new VideoReplaySource(folder, VideoReplaySource::recorded_pacing(folder)));
+    }catch (FileException& e){
+        m_logger.log("Unable to open recording: " + e.message(), COLOR_RED);
+        return;
+    }
+
+    m_logger.log(
+        "Replay: " + std::to_string(m_source->frame_count()) + " frames at " +
+        m_source->resolution().to_string() + ", " + std::to_string(m_source->fps()) + " FPS"
+    );
+
+    for (Listener* listener : m_listeners){
+        listener->new_source(m_device, m_source->resolution());
+    }
+
+    std::string audio = VideoReplaySource::recorded_audio(folder);
+    if (audio.empty()){
+        return;
+    }
+    if (m_source->pacing() != VideoReplaySource::Pacing::REAL_TIME){
+        m_logger.log("Recorded audio is only replayed in real-time pacing.", COLOR_ORANGE);
+        return;
+    }
+    for (Listener* listener : m_listeners){
+        listener->recorded_audio(audio);
+    }
+
+    //  Start the video clock again now that the audio is starting.
+    m_source->restart();
+}
+
+PokemonAutomation::VideoWidget* CameraSession::make_QtWidget(QWidget* parent){
+    return new VideoWidget(parent, *this);
+}
+
+
+
+
+VideoWidget::VideoWidget(QWidget* parent, CameraSession& session)
+    : PokemonAutomation::VideoWidget(parent)
+    , m_session(session)
+    , m_timer(new QTimer(this))
+    , m_last_timestamp(WallClock::min())
+{
+    this->setMinimumSize(80, 45);
+
+    //  Nothing pushes frames to us. So poll at the replay frame rate.
+    update_interval();
+    connect(m_timer, &QTimer::timeout, this, [this]{ this->update(); });
+    m_timer->start();
+
+    session.add_listener(*this);
+}
+VideoWidget::~VideoWidget(){
+    m_session.remove_listener(*this);
+}
+void VideoWidget::new_source(const CameraInfo&, Resolution){
+    //  This is called with the session locked. Read the new frame rate later.
+    QMetaObject::invokeMethod(this, [this]{ update_interval(); }, Qt::QueuedConnection);
+}
+void VideoWidget::update_interval(){
+    double fps = m_session.replay_fps();
+    m_timer->setInterval(fps > 0 ? (int)(1000 / fps) : 33);
+}
+void VideoWidget::paintEvent(QPaintEvent* event){
+    QWidget::paintEvent(event);
+
+    VideoSnapshot frame = m_session.display_frame();
+    if (!frame){
+        return;
+    }
+
+    QRect rect(0, 0, this->width(), this->height());
+    QPainter painter(this);
+    painter.drawImage(rect, frame.frame->to_QImage_ref());
+
+    if (m_last_timestamp != frame.timestamp){
+        m_last_timestamp = frame.timestamp;
+        m_session.report_rendered_frame(current_time());
+    }
+}
+
+
+
+
+}
+}
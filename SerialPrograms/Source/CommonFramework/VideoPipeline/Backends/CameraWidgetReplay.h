@@ -0,0 +1,138 @@
+/*  Video Widget (Replay)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A camera backend that plays back recorded sessions instead of a
+ *  capture card. (see VideoReplaySource)
+ *
+ *  Each recording in the "Recordings" folder shows up as a camera.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_ReplayVideoWidget_H
+#define PokemonAutomation_VideoPipeline_ReplayVideoWidget_H
+
+#include <set>
+#include <mutex>
+#include "Common/Cpp/EventRateTracker.h"
+#include "Common/Cpp/LifetimeSanitizer.h"
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "CommonFramework/VideoPipeline/CameraInfo.h"
+#include "CommonFramework/VideoPipeline/CameraSession.h"
+#include "CommonFramework/VideoPipeline/UI/VideoWidget.h"
+#include "CameraImplementations.h"
+#include "VideoReplaySource.h"
+
+class QTimer;
+
+namespace PokemonAutomation{
+namespace CameraFileReplay{
+
+
+class CameraBackend : public PokemonAutomation::CameraBackend{
+public:
+    static const std::string RECORDINGS_FOLDER;
+
+    virtual std::vector<CameraInfo> get_all_cameras() const override;
+    virtual std::string get_camera_name(const CameraInfo& info) const override;
+
+    virtual std::unique_ptr<PokemonAutomation::CameraSession> make_camera(Logger& logger, Resolution default_resolution) const override;
+};
+
+
+
+class CameraSession : public PokemonAutomation::CameraSession{
+public:
+    virtual void add_listener(Listener& listener) override;
+    virtual void remove_listener(Listener& listener) override;
+
+
+public:
+    virtual ~CameraSession();
+    CameraSession(Logger& logger);
+
+    virtual void get(CameraOption& option) override;
+    virtual void set(const CameraOption& option) override;
+
+    virtual void reset() override;
+    virtual void set_source(CameraInfo device) override;
+    virtual void set_resolution(Resolution resolution) override;
+
+    virtual CameraInfo current_device() const override;
+    virtual Resolution current_resolution() const override;
+    virtual std::vector<Resolution> supported_resolutions() const override;
+
+    virtual VideoSnapshot snapshot() override;
+    virtual VideoSnapshot inference_snapshot() override;
+    virtual double fps_source() override;
+    virtual double fps_display() override;
+
+    //  The frame to show on the display. In real-time mode, this is the frame
+    //  that is due now. Otherwise, it is the last frame that was served and
+    //  does not advance the replay.
+    VideoSnapshot display_frame();
+    double replay_fps() const;
+    void report_rendered_frame(WallClock timestamp);
+
+    virtual VideoWidget* make_QtWidget(QWidget* parent) override;
+
+
+private:
+    VideoSnapshot serve(bool advance);
+
+    //  These must be called under "m_lock".
+    void shutdown();
+    void startup();
+
+
+private:
+    Logger& m_logger;
+
+    //  If you need both locks, acquire "m_lock" first.
+    mutable std::mutex m_lock;
+    mutable SpinLock m_stats_lock;
+
+    CameraInfo m_device;
+    std::unique_ptr<VideoReplaySource> m_source;
+    WallClock m_last_served;
+
+    EventRateTracker m_fps_tracker_source;
+    EventRateTracker m_fps_tracker_display;
+
+    std::set<Listener*> m_listeners;
+
+    LifetimeSanitizer m_sanitizer;
+};
+
+
+
+class VideoWidget : public PokemonAutomation::VideoWidget, private CameraSession::Listener{
+public:
+    VideoWidget(QWidget* parent, CameraSession& session);
+    virtual ~VideoWidget();
+
+    virtual PokemonAutomation::CameraSession& camera() override{ return m_session; }
+
+private:
+    virtual void shutdown() override{}
+    virtual void new_source(const CameraInfo& device, Resolution resolution) override;
+    virtual void resolution_change(Resolution resolution) override{}
+
+    //  Poll at the frame rate of the current recording.
+    void update_interval();
+
+    virtual void paintEvent(QPaintEvent* event) override;
+
+
+private:
+    CameraSession& m_session;
+    QTimer* m_timer;
+    WallClock m_last_timestamp;
+};
+
+
+
+
+}
+}
+#endif
@@ -0,0 +1,219 @@
+/*  Video Replay Source
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <QDir>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "VideoReplaySource.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+const std::string VideoReplaySource::JSON_FPS = "FPS";
+const std::string VideoReplaySource::JSON_WIDTH = "Width";
+const std::string VideoReplaySource::JSON_HEIGHT = "Height";
+const std::string VideoReplaySource::JSON_AS_FAST_AS_POSSIBLE = "AsFastAsPossible";
+
+namespace{
+
+const char* RAW_FILE = "frames.rgb32";
+const char* CONFIG_FILE = "replay.json";
+const char* AUDIO_FILE = "audio.wav";
+
+QStringList image_filters(){
+    return {"*.png", "*.jpg", "*.jpeg", "*.bmp"};
+}
+
+std::vector<std::string> list_images(const std::string& folder){
+    std::vector<std::string> ret;
+    QDir dir(QString::fromStdString(folder));
+    for (const QString& name : dir.entryList(image_filters(), QDir::Files, QDir::Name)){
+        ret.emplace_back(dir.filePath(name).toStdString());
+    }
+    return ret;
+}
+
+//  Returns an empty object if there is no config.
+JsonValue load_config(const std::string& folder){
+    std::string path = folder + "/" + CONFIG_FILE;
+    if (!QFile::exists(QString::fromStdString(path))){
+        return JsonObject();
+    }
+    return load_json_file(path);
+}
+
+}
+
+
+
+std::vector<std::string> VideoReplaySource::find_recordings(const std::string& root){
+    std::vector<std::string> ret;
+    QDir dir(QString::fromStdString(root));
+    for (const QString& name : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name)){
+        QDir folder(dir.filePath(name));
+        if (folder.exists(RAW_FILE) || !folder.entryList(image_filters(), QDir::Files).empty()){
+            ret.emplace_back(folder.path().toStdString());
+        }
+    }
+    return ret;
+}
+VideoReplaySource::Pacing VideoReplaySource::recorded_pacing(const std::string& folder){
+    JsonValue json = load_config(folder);
+    const JsonObject* obj = json.get_object();
+    bool fast = false;
+    if (obj != nullptr){
+        obj->read_boolean(fast, JSON_AS_FAST_AS_POSSIBLE);
+    }
+    return fast ? Pacing::AS_FAST_AS_POSSIBLE : Pacing::REAL_TIME;
+}
+std::string VideoReplaySource::recorded_audio(const std::string& folder){
+    std::string path = folder + "/" + AUDIO_FILE;
+    return QFile::exists(QString::fromStdString(path)) ? path : std::string();
+}
+
+
+
+VideoReplaySource::VideoReplaySource(std::string folder, Pacing pacing)
+    : m_folder(std::move(folder))
+    , m_pacing(pacing)
+    , m_fps(30)
+    , m_frame_count(0)
+    , m_start(current_time())
+    , m_next_index(0)
+    , m_current_index((size_t)-1)
+{
+    JsonValue json = load_config(m_folder);
+    const JsonObject& config = json.get_object_throw(m_folder + "/" + CONFIG_FILE);
+    config.read_float(m_fps, JSON_FPS);
+    if (!(m_fps > 0)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid FPS: " + std::to_string(m_fps), m_folder);
+    }
+
+    std::string raw_path = m_folder + "/" + RAW_FILE;
+    if (QFile::exists(QString::fromStdString(raw_path))){
+        size_t width = (size_t)config.get_integer_throw(JSON_WIDTH, CONFIG_FILE);
+        size_t height = (size_t)config.get_integer_throw(JSON_HEIGHT, CONFIG_FILE);
+        size_t frame_bytes = width * height * sizeof(uint32_t);
+        if (frame_bytes == 0){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid frame dimensions.", raw_path);
+        }
+        m_raw.open(raw_path, std::ios::binary);
+        if (!m_raw){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open frame dump.", raw_path);
+        }
+        m_raw.seekg(0, std::ios::end);
+        m_frame_count = (size_t)m_raw.tellg() / frame_bytes;
+        m_resolution = Resolution(width, height);
+    }else{
+        m_files = list_images(m_folder);
+        m_frame_count = m_files.size();
+        if (m_frame_count > 0){
+            ImageRGB32 first(m_files[0]);
+            m_resolution = Resolution(first.width(), first.height());
+        }
+    }
+
+    if (m_frame_count == 0){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Recording has no frames.", m_folder);
+    }
+}
+
+void VideoReplaySource::restart(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_start = current_time();
+    m_next_index = 0;
+    m_current.clear();
+    m_current_index = (size_t)-1;
+}
+bool VideoReplaySource::finished() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    switch (m_pacing){
+    case Pacing::REAL_TIME:
+        return current_time() - m_start >= std::chrono::microseconds((int64_t)(m_frame_count * 1000000 / m_fps));
+    case Pacing::AS_FAST_AS_POSSIBLE:
+        return m_next_index >= m_frame_count;
+    }
+    return true;
+}
+
+VideoSnapshot VideoReplaySource::snapshot(){
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    size_t index;
+    switch (m_pacing){
+    case Pacing::REAL_TIME:{
+        double elapsed = std::chrono::duration<double>(current_time() - m_start).count();
+        index = (size_t)(elapsed * m_fps);
+        break;
+    }
+    case Pacing::AS_FAST_AS_POSSIBLE:
+    default:
+        //  Nothing served yet. Show the first frame.
+        index = m_current_index == (size_t)-1 ? 0 : m_current_index;
+        break;
+    }
+
+    index = std::min(index, m_frame_count - 1);
+    return serve_frame(index);
+}
+VideoSnapshot VideoReplaySource::next_frame(){
+    if (m_pacing == Pacing::REAL_TIME){
+        return snapshot();
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    size_t index = std::min(m_next_index, m_frame_count - 1);
+    if (m_next_index < m_frame_count){
+        m_next_index++;
+    }
+    return serve_frame(index);
+}
+VideoSnapshot VideoReplaySource::current_frame() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_current;
+}
+
+VideoSnapshot VideoReplaySource::serve_frame(size_t index){
+    //  Still on the same frame.
+    if (index == m_current_index){
+        return m_current;
+    }
+
+    WallClock timestamp = m_start + std::chrono::microseconds((int64_t)(index * 1000000 / m_fps));
+    m_current = VideoSnapshot(load_frame(index), timestamp);
+    m_current_index = index;
+    return m_current;
+}
+ImageRGB32 VideoReplaySource::load_frame(size_t index){
+    if (!m_files.empty()){
+        return ImageRGB32(m_files[index]);
+    }
+
+    size_t width = m_resolution.width;
+    size_t height = m_resolution.height;
+    ImageRGB32 image(width, height);
+    size_t row_bytes = width * sizeof(uint32_t);
+    m_raw.clear();
+    m_raw.seekg((std::streamoff)(index * row_bytes * height));
+    char* row = (char*)image.data();
+    for (size_t r = 0; r < height; r++){
+        m_raw.read(row, row_bytes);
+        row += image.bytes_per_row();
+    }
+    if (!m_raw){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to read frame " + std::to_string(index) + ".", m_folder);
+    }
+    return image;
+}
+
+
+
+}
@@ -0,0 +1,124 @@
+/*  Video Replay Source
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Serve the frames of a recorded session as if they were coming from a
+ *  live camera. This lets detectors run without a capture card.
+ *
+ *  A recording is a folder holding one of:
+ *      -   An image sequence: "*.png", "*.jpg" or "*.bmp" sorted by file name.
+ *      -   A raw frame dump: "frames.rgb32". These are back-to-back 32-bit
+ *          ARGB frames. "replay.json" must then give "Width" and "Height".
+ *
+ *  "replay.json" is optional otherwise. "FPS" sets the frame rate. (default 30)
+ *
+ *  Recorded audio goes in "audio.wav". This class doesn't decode it. The
+ *  camera session hands the file to the audio session when the replay starts
+ *  and then restarts the replay clock so that both start together. Audio can
+ *  only follow the video in real-time pacing.
+ *
+ *  The timestamp of each frame is the time replay started plus the frame
+ *  index divided by the frame rate. So it does not depend on how fast the
+ *  frames are consumed.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_VideoReplaySource_H
+#define PokemonAutomation_VideoPipeline_VideoReplaySource_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <fstream>
+#include "Common/Cpp/ImageResolution.h"
+#include "CommonFramework/VideoPipeline/VideoFeed.h"
+
+namespace PokemonAutomation{
+
+
+class VideoReplaySource{
+public:
+    static const std::string JSON_FPS;
+    static const std::string JSON_WIDTH;
+    static const std::string JSON_HEIGHT;
+    static const std::string JSON_AS_FAST_AS_POSSIBLE;
+
+    enum class Pacing{
+        //  Show each frame for 1/FPS seconds of wall time.
+        REAL_TIME,
+
+        //  Every call to "next_frame()" returns the next frame.
+        AS_FAST_AS_POSSIBLE,
+    };
+
+    //  Returns the subfolders of "root" that look like recordings.
+    static std::vector<std::string> find_recordings(const std::string& root);
+
+    //  Read the pacing requested by "replay.json". REAL_TIME if not set.
+    static Pacing recorded_pacing(const std::string& folder);
+
+    //  Returns the path of the recorded audio. Empty if there is none.
+    static std::string recorded_audio(const std::string& folder);
+
+
+public:
+    //  Throws FileException if "folder" isn't a usable recording.
+    VideoReplaySource(std::string folder, Pacing pacing);
+
+    const std::string& folder() const{ return m_folder; }
+    Pacing pacing() const{ return m_pacing; }
+    size_t frame_count() const{ return m_frame_count; }
+    double fps() const{ return m_fps; }
+    Resolution resolution() const{ return m_resolution; }
+
+    //  Go back to the first frame. Timestamps are relative to this call.
+    void restart();
+
+    //  Returns true once every frame has been served. The last frame is
+    //  then repeated.
+    bool finished() const;
+
+    //  Returns the frame due now. In AS_FAST_AS_POSSIBLE mode, this is the
+    //  last frame that "next_frame()" served and it doesn't advance. So any
+    //  number of callers can look at the screen without making the consumer
+    //  of "next_frame()" skip frames.
+    VideoSnapshot snapshot();
+
+    //  Same as "snapshot()" in REAL_TIME mode. In AS_FAST_AS_POSSIBLE mode,
+    //  advance to the next frame and return it. Only the inference loop
+    //  should call this.
+    VideoSnapshot next_frame();
+
+    //  Returns the last frame that was served without advancing.
+    VideoSnapshot current_frame() const;
+
+
+private:
+    ImageRGB32 load_frame(size_t index);
+    VideoSnapshot serve_frame(size_t index);
+
+
+private:
+    const std::string m_folder;
+    const Pacing m_pacing;
+    double m_fps;
+    Resolution m_resolution;
+    size_t m_frame_count;
+
+    //  Image sequence. Empty if this is a raw dump.
+    std::vector<std::string> m_files;
+
+    //  Raw dump.
+    std::ifstream m_raw;
+
+    mutable std::mutex m_lock;
+    WallClock m_start;
+    size_t m_next_index;
+    VideoSnapshot m_current;
+    size_t m_current_index;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,175 @@
+/*  Video Tools (QT6)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <QtGlobal>
+#if QT_VERSION_MAJOR == 6
+
+#include <string.h>
+#include <atomic>
+#include <QImage>
+#include "Kernels/VideoFrameConversion/Kernels_VideoFrameConversion.h"
+#include "VideoToolsQt6.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+QVideoFrameConverter::QVideoFrameConverter(size_t pool_size)
+    : m_pool_size(pool_size)
+{}
+
+
+std::shared_ptr<ImageRGB32> QVideoFrameConverter::get_buffer(size_t width, size_t height){
+    for (std::shared_ptr<ImageRGB32>& buffer : m_pool){
+        //  Nobody else holds a reference. Since new references can only be
+        //  made through here, it's safe to reuse.
+        if (buffer.use_count() != 1){
+            continue;
+        }
+        //  The last snapshot may have just dropped it on another thread.
+        //  Order its reads of the pixels before we write the next frame.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (buffer->width() != width || buffer->height() != height){
+            buffer = std::make_shared<ImageRGB32>(width, height);
+        }
+        return buffer;
+    }
+
+    std::shared_ptr<ImageRGB32> buffer = std::make_shared<ImageRGB32>(width, height);
+    if (m_pool.size() < m_pool_size){
+        m_pool.emplace_back(buffer);
+    }
+    return buffer;
+}
+
+
+Kernels::YuvToRgbCoefficients yuv_coefficients(const QVideoFrameFormat& format){
+    //  If the device doesn't tell us, follow the usual convention of BT.709
+    //  for HD and BT.601 for SD.
+    bool bt709 = format.frameHeight() >= 720;
+    bool full_range = false;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 4, 0)
+    switch (format.colorSpace()){
+    case QVideoFrameFormat::ColorSpace_BT601:
+        bt709 = false;
+        break;
+    case QVideoFrameFormat::ColorSpace_BT709:
+        bt709 = true;
+        break;
+    default:;
+    }
+    full_range = format.colorRange() == QVideoFrameFormat::ColorRange_Full;
+#else
+    switch (format.yCbCrColorSpace()){
+    case QVideoFrameFormat::YCbCr_BT601:
+    case QVideoFrameFormat::YCbCr_xvYCC601:
+        bt709 = false;
+        break;
+    case QVideoFrameFormat::YCbCr_BT709:
+    case QVideoFrameFormat::YCbCr_xvYCC709:
+        bt709 = true;
+        break;
+    case QVideoFrameFormat::YCbCr_JPEG:
+        bt709 = false;
+        full_range = true;
+        break;
+    default:;
+    }
+#endif
+    return Kernels::YuvToRgbCoefficients::make(bt709, full_range);
+}
+
+
+bool QVideoFrameConverter::convert_mapped(ImageRGB32& image, const QVideoFrame& frame){
+    size_t width = image.width();
+    size_t height = image.height();
+    switch (frame.pixelFormat()){
+    case QVideoFrameFormat::Format_NV12:
+        Kernels::convert_NV12_to_rgb32(
+            frame.bits(0), frame.bytesPerLine(0),
+            frame.bits(1), frame.bytesPerLine(1),
+            width, height,
+            image.data(), image.bytes_per_row(),
+            yuv_coefficients(frame.surfaceFormat())
+        );
+        return true;
+    case QVideoFrameFormat::Format_YUYV:
+        Kernels::convert_YUYV_to_rgb32(
+            frame.bits(0), frame.bytesPerLine(0),
+            width, height,
+            image.data(), image.bytes_per_row(),
+            yuv_coefficients(frame.surfaceFormat())
+        );
+        return true;
+    case QVideoFrameFormat::Format_BGRA8888:
+    case QVideoFrameFormat::Format_BGRX8888:{
+        //  Same memory layout as QImage::Format_ARGB32. Just force the alpha.
+        const uchar* in = frame.bits(0);
+        size_t in_bytes_per_row = frame.bytesPerLine(0);
+        uint32_t* out = image.data();
+        for (size_t r = 0; r < height; r++){
+            memcpy(out, in, width * sizeof(uint32_t));
+            for (size_t c = 0; c < width; c++){
+                out[c] |= 0xff000000;
+            }
+            in += in_bytes_per_row;
+            out = (uint32_t*)((char*)out + image.bytes_per_row());
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+
+std::shared_ptr<const ImageRGB32> QVideoFrameConverter::convert(Logger& logger, QVideoFrame frame){
+    if (!frame.isValid()){
+        return nullptr;
+    }
+
+    int width = frame.width();
+    int height = frame.height();
+    if (width > 0 && height > 0){
+        if (!frame.map(QVideoFrame::ReadOnly)){
+            logger.log("Unable to map QVideoFrame.", COLOR_RED);
+            return nullptr;
+        }
+        std::shared_ptr<ImageRGB32> image;
+        try{
+            image = get_buffer(width, height);
+            if (!convert_mapped(*image, frame)){
+                image.reset();
+            }
+        }catch (...){
+            frame.unmap();
+            throw;
+        }
+        frame.unmap();
+        if (image){
+            return image;
+        }
+    }
+
+    //  Unknown format. Let Qt handle it.
+    QImage image = frame.toImage();
+    if (image.isNull()){
+        return nullptr;
+    }
+    QImage::Format format = image.format();
+    if (format != QImage::Format_ARGB32 && format != QImage::Format_RGB32){
+        image = image.convertToFormat(QImage::Format_ARGB32);
+    }
+    return std::make_shared<const ImageRGB32>(std::move(image));
+}
+
+
+
+}
+#endif
@@ -0,0 +1,54 @@
+/*  Video Tools (QT6)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_VideoToolsQt6_H
+#define PokemonAutomation_VideoPipeline_VideoToolsQt6_H
+
+#include <QtGlobal>
+#if QT_VERSION_MAJOR == 6
+
+#include <memory>
+#include <vector>
+#include <QVideoFrame>
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+
+namespace PokemonAutomation{
+
+
+//  Convert QVideoFrames into ImageRGB32.
+//
+//  Common capture formats (NV12, YUYV, BGRA/BGRX) are converted directly from
+//  the mapped frame into a recycled buffer. Everything else falls back to
+//  QVideoFrame::toImage().
+//
+//  This class is not thread-safe.
+//
+class QVideoFrameConverter{
+public:
+    QVideoFrameConverter(size_t pool_size = 4);
+
+    //  Returns null if the frame could not be converted.
+    std::shared_ptr<const ImageRGB32> convert(Logger& logger, QVideoFrame frame);
+
+private:
+    //  Returns false if the pixel format isn't natively supported.
+    bool convert_mapped(ImageRGB32& image, const QVideoFrame& frame);
+
+    //  Get a buffer that nobody else is using anymore. If all of them are in
+    //  use and the pool is full, allocate a new one outside the pool.
+    std::shared_ptr<ImageRGB32> get_buffer(size_t width, size_t height);
+
+private:
+    const size_t m_pool_size;
+    std::vector<std::shared_ptr<ImageRGB32>> m_pool;
+};
+
+
+
+}
+#endif
+#endif
@@ -0,0 +1,30 @@
+/*  Buffer Pool Stats
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Containers/AlignedBufferPool.h"
+#include "BufferPoolStats.h"
+
+namespace PokemonAutomation{
+
+
+OverlayStatSnapshot BufferPoolStat::get_current(){
+    AlignedBufferPool::Stats stats = AlignedBufferPool::instance().stats();
+    uint64_t requests = stats.hits + stats.misses;
+
+    //  Don't show anything until a pooled buffer has been requested.
+    if (requests == 0){
+        return OverlayStatSnapshot();
+    }
+    return OverlayStatSnapshot{
+        "Buffer Pool: " + tostr_fixed(100. * stats.hits / requests, 1) + "% hits (" +
+        tostr_fixed(stats.cached_bytes / 1048576., 1) + " MB cached)"
+    };
+}
+
+
+
+}
@@ -0,0 +1,24 @@
+/*  Buffer Pool Stats
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_BufferPoolStats_H
+#define PokemonAutomation_BufferPoolStats_H
+
+#include "VideoOverlayTypes.h"
+
+namespace PokemonAutomation{
+
+
+//  Overlay stat for the hit rate of the global AlignedBufferPool.
+class BufferPoolStat : public OverlayStat{
+public:
+    virtual OverlayStatSnapshot get_current() override;
+};
+
+
+
+}
+#endif
@@ -38,6 +38,10 @@ public:
 
         virtual void new_source(const CameraInfo& device, Resolution resolution) = 0;  //  Send after a new camera goes up.
         virtual void resolution_change(Resolution resolution) = 0;
+
+        //  Sent by sources that come with recorded audio, right before their
+        //  first frame. The listener should start playing "file" now.
+        virtual void recorded_audio(const std::string& file){}
     };
     virtual void add_listener(Listener& listener) = 0;
     virtual void remove_listener(Listener& listener) = 0;
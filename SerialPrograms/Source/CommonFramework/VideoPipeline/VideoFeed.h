@@ -10,6 +10,7 @@
 #include <memory>
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageIntegralCache.h"
 
 namespace PokemonAutomation{
 
@@ -22,6 +23,10 @@ struct VideoSnapshot{
     //  This will be as close as possible to when the frame was taken.
     WallClock timestamp = WallClock::min();
 
+    //  Summed-area table of the frame. Built lazily by "image_stats()" and
+    //  friends when they are called on views from "operator ImageViewRGB32()".
+    std::shared_ptr<ImageIntegralCache> integral;
+
     VideoSnapshot()
          : frame(std::make_shared<const ImageRGB32>())
          , timestamp(WallClock::min())
@@ -29,6 +34,12 @@ struct VideoSnapshot{
     VideoSnapshot(ImageRGB32 p_frame, WallClock p_timestamp)
          : frame(std::make_shared<const ImageRGB32>(std::move(p_frame)))
          , timestamp(p_timestamp)
+         , integral(ImageIntegralCache::make(frame))
+    {}
+    VideoSnapshot(std::shared_ptr<const ImageRGB32> p_frame, WallClock p_timestamp)
+         : frame(std::move(p_frame))
+         , timestamp(p_timestamp)
+         , integral(ImageIntegralCache::make(frame))
     {}
 
     //  Returns true if the snapshot is valid.
@@ -37,9 +48,11 @@ struct VideoSnapshot{
     const ImageRGB32* operator->() const{ return frame.get(); }
 
 //    operator std::shared_ptr<const ImageRGB32>() &&{ return std::move(frame); }
-    operator ImageViewRGB32() const{ return *frame; }
+    //  The view carries the summed-area table of the frame.
+    operator ImageViewRGB32() const{ return frame->with_integral_cache(integral); }
 
     void clear(){
+        integral.reset();
         frame.reset();
         timestamp = WallClock::min();
     }
@@ -58,6 +71,12 @@ public:
     //  Do not call this on the main thread or it may deadlock.
     virtual VideoSnapshot snapshot() = 0;
 
+    //  Called by the inference loop once every callback has seen the last
+    //  frame it got. A live feed returns the same as "snapshot()". A recorded
+    //  feed that isn't paced in real time only moves to its next frame here.
+    //  So other callers of "snapshot()" don't make inference skip frames.
+    virtual VideoSnapshot inference_snapshot(){ return snapshot(); }
+
     //  Returns the currently measured frames/second for the video source + display.
     //  Use this for diagnostic purposes.
     virtual double fps_source() = 0;
@@ -58,16 +58,33 @@ void DiscordWebhookSender::send_json(
     std::shared_ptr<PendingFileSend> file
 ){
     cleanup_stuck_requests();
+
+    //  The screenshot may still be encoding. Prepare the message both with and
+    //  without it in the embed. Which one is sent is decided once it's done.
+    QByteArray data = QByteArray::fromStdString(obj.dump());
+    QByteArray data_with_image = data;
+    if (file && file->embed_image() && !file->filepath().empty()){
+        JsonObject with_image = obj.clone();
+        JsonArray* embeds = with_image.get_array("embeds");
+        JsonObject* embed = embeds == nullptr || embeds->empty() ? nullptr : (*embeds)[0].get_object();
+        if (embed != nullptr){
+            file->add_to_embed(*embed);
+            data_with_image = QByteArray::fromStdString(with_image.dump());
+        }
+    }
+
     m_queue.add_event(
         delay,
-        [this, url, data = QByteArray::fromStdString(obj.dump()), file = std::move(file)]{
+        [this, url, data = std::move(data), data_with_image = std::move(data_with_image), file = std::move(file)]{
             throttle();
-            if (!file && !data.isEmpty()){
-                internal_send_json(url, data);
-            }else if (file && !data.isEmpty()){
-                internal_send_image_embed(url, data, file->filepath(), file->filename());
-            }else{
+            //  If the file failed to save, send the message without it.
+            bool has_file = file && !file->filepath().empty() && file->wait();
+            if (has_file && !data.isEmpty()){
+                internal_send_image_embed(url, data_with_image, file->filepath(), file->filename());
+            }else if (has_file){
                 internal_send_file(url, file->filepath());
+            }else if (!data.isEmpty()){
+                internal_send_json(url, data);
             }
         }
     );
@@ -85,7 +102,9 @@ void DiscordWebhookSender::send_file(
         delay,
         [this, url, file = std::move(file)]{
             throttle();
-            internal_send_file(url, file->filepath());
+            if (file && !file->filepath().empty() && file->wait()){
+                internal_send_file(url, file->filepath());
+            }
         }
     );
     logger.log("Scheduling Webhook Message... (queue = " + tostr_u_commas(m_queue.size()) + ")", COLOR_PURPLE);
@@ -140,8 +140,10 @@ public:
         return sender;
     }
 
+    //  "embed_with_image" is sent instead of "embed" if the file is written.
     void send(
         std::string embed,
+        std::string embed_with_image,
         std::string channels,
         std::chrono::milliseconds delay,
         std::string messages,
@@ -150,12 +152,13 @@ public:
 //        std::lock_guard<std::mutex> lg(m_lock);
         m_queue.add_event(
             delay > std::chrono::milliseconds(10000) ? std::chrono::milliseconds(0) : delay,
-            [embed = std::move(embed), channels = std::move(channels), messages = std::move(messages), file = std::move(file)]() mutable {
-                if (file == nullptr || file->filepath().empty()){
+            [embed = std::move(embed), embed_with_image = std::move(embed_with_image), channels = std::move(channels), messages = std::move(messages), file = std::move(file)]() mutable {
+                //  The screenshot may still be encoding.
+                if (file == nullptr || file->filepath().empty() || !file->wait()){
                     sendMessage(&channels[0], &messages[0], &embed[0], nullptr);
                 }else{
                     std::string filepath = file->filepath();
-                    sendMessage(&channels[0], &messages[0], &embed[0], &filepath[0]);
+                    sendMessage(&channels[0], &messages[0], &embed_with_image[0], &filepath[0]);
                 }
             }
         );
@@ -229,6 +232,7 @@ public:
 public:
     void send(
         std::string embed,
+        std::string embed_with_image,
         std::string channels,
         std::chrono::milliseconds delay,
         std::string messages,
@@ -239,7 +243,7 @@ public:
 //                cout << "Sending: " << file->filepath().toStdString() << endl;
                 m_active_list.emplace(file->filepath(), file);
             }
-            SleepyDiscordSender::instance().send(embed, channels, delay, messages, std::move(file));
+            SleepyDiscordSender::instance().send(embed, embed_with_image, channels, delay, messages, std::move(file));
         }else{
             sleepy_logger().log("SleepyDiscordClient::send(): Not connected.", COLOR_RED);
         }
@@ -346,7 +350,7 @@ private:
         if ((int)request <= 11) {
             program_response(request, channel, &message[0], &filename[0]);
         }else{
-            send("", channel, std::chrono::milliseconds(0), &message[0], std::move(file));
+            send("", "", channel, std::chrono::milliseconds(0), &message[0], std::move(file));
         }
     }
 
@@ -596,9 +600,16 @@ void send_message_sleepy(
             message_vector.emplace_back(str);
 
             std::string json = embed.dump();
+            std::string json_with_image = json;
+            if (file != nullptr && file->embed_image() && !file->filepath().empty()){
+                JsonObject with_image = embed.clone();
+                file->add_to_embed(with_image);
+                json_with_image = with_image.dump();
+            }
             sleepy_logger().log("send_message_sleepy(): Sending...", COLOR_PURPLE);
             m_sleepy_client->send(
                 json,
+                json_with_image,
                 channel.channel_id,
                 std::chrono::seconds(channel.delay),
                 str,
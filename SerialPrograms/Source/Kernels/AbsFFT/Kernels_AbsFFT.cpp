@@ -17,32 +17,87 @@ namespace AbsFFT{
 void fft_abs_Default(int k, float* abs, float* real);
 void fft_abs_x86_SSE41(int k, float* abs, float* real);
 void fft_abs_x86_AVX2(int k, float* abs, float* real);
+void fft_abs_x86_AVX512(int k, float* abs, float* real);
 
+void fft_abs_Default(int k, size_t count, float* const* abs, float* const* real);
+void fft_abs_x86_SSE41(int k, size_t count, float* const* abs, float* const* real);
+void fft_abs_x86_AVX2(int k, size_t count, float* const* abs, float* const* real);
+void fft_abs_x86_AVX512(int k, size_t count, float* const* abs, float* const* real);
 
-void fft_abs(int k, float* abs, float* real){
-    if (k <= 0){
-        throw "FFT length must be at least 2^1.";
+
+using FftAbsFunction = void (*)(int k, float* abs, float* real);
+
+FftAbsFunction get_fft_abs(){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        return fft_abs_x86_AVX512;
     }
-    if ((size_t)abs & 63){
-        throw "abs must be aligned to 64 bytes.";
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return fft_abs_x86_AVX2;
     }
-    if ((size_t)real & 63){
-        throw "real must be aligned to 64 bytes.";
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        return fft_abs_x86_SSE41;
     }
+#endif
+    return fft_abs_Default;
+}
+
+
+using FftAbsBatchFunction = void (*)(int k, size_t count, float* const* abs, float* const* real);
 
+FftAbsBatchFunction get_fft_abs_batch(){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        return fft_abs_x86_AVX512;
+    }
+#endif
 #ifdef PA_AutoDispatch_x64_13_Haswell
     if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
-        fft_abs_x86_AVX2(k, abs, real);
-        return;
+        return fft_abs_x86_AVX2;
     }
 #endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
-        fft_abs_x86_SSE41(k, abs, real);
-        return;
+        return fft_abs_x86_SSE41;
     }
 #endif
-    fft_abs_Default(k, abs, real);
+    return fft_abs_Default;
+}
+
+
+void check_fft_abs(int k, const float* abs, const float* real){
+    if (k <= 0){
+        throw "FFT length must be at least 2^1.";
+    }
+    if ((size_t)abs & 63){
+        throw "abs must be aligned to 64 bytes.";
+    }
+    if ((size_t)real & 63){
+        throw "real must be aligned to 64 bytes.";
+    }
+}
+
+
+//  The implementation is picked on the first call. So the processor level
+//  must be set before the first transform.
+
+void fft_abs(int k, float* abs, float* real){
+    static const FftAbsFunction function = get_fft_abs();
+    check_fft_abs(k, abs, real);
+    function(k, abs, real);
+}
+void fft_abs(int k, size_t count, float* const* abs, float* const* real){
+    static const FftAbsBatchFunction function = get_fft_abs_batch();
+    for (size_t c = 0; c < count; c++){
+        check_fft_abs(k, abs[c], real[c]);
+    }
+    if (count > 0){
+        function(k, count, abs, real);
+    }
 }
 
 
@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_Kernels_AbsFFT_H
 #define PokemonAutomation_Kernels_AbsFFT_H
 
+#include <stddef.h>
 
 namespace PokemonAutomation{
 namespace Kernels{
@@ -25,6 +26,17 @@ namespace AbsFFT{
 //
 void fft_abs(int k, float* abs, float* real);
 
+//
+//  Same as above, but for "count" transforms of length 2^k. Transform "i"
+//  reads "real[i]" and writes "abs[i]". The requirements are the same as
+//  above.
+//
+//  The checks, the dispatch and the twiddle table lookup are done once for
+//  the whole batch. The transforms run back-to-back on the same twiddle
+//  table, so it stays in cache from one window to the next.
+//
+void fft_abs(int k, size_t count, float* const* abs, float* const* real);
+
 
 
 }
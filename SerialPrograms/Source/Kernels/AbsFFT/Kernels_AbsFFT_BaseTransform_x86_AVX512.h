@@ -0,0 +1,291 @@
+/*  ABS FFT Base Transform (x86 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_AbsFFT_BaseTransform_x86_AVX512_H
+#define PokemonAutomation_Kernels_AbsFFT_BaseTransform_x86_AVX512_H
+
+#include "Kernels/Kernels_x64_AVX512.h"
+#include "Kernels_AbsFFT_Arch_x86_AVX512.h"
+#include "Kernels_AbsFFT_Butterflies.h"
+#include "Kernels_AbsFFT_ComplexVector.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace AbsFFT{
+
+const float TW16_1 = 0.92387953251128675613f;
+const float TW16_3 = 0.38268343236508977173f;
+
+PA_FORCE_INLINE void vtranspose(__m512 r[16]){
+    __m512 a[16];
+    __m512 b[16];
+
+    a[ 0] = _mm512_unpacklo_ps(r[ 0], r[ 1]);
+    a[ 1] = _mm512_unpackhi_ps(r[ 0], r[ 1]);
+    a[ 2] = _mm512_unpacklo_ps(r[ 2], r[ 3]);
+    a[ 3] = _mm512_unpackhi_ps(r[ 2], r[ 3]);
+    a[ 4] = _mm512_unpacklo_ps(r[ 4], r[ 5]);
+    a[ 5] = _mm512_unpackhi_ps(r[ 4], r[ 5]);
+    a[ 6] = _mm512_unpacklo_ps(r[ 6], r[ 7]);
+    a[ 7] = _mm512_unpackhi_ps(r[ 6], r[ 7]);
+    a[ 8] = _mm512_unpacklo_ps(r[ 8], r[ 9]);
+    a[ 9] = _mm512_unpackhi_ps(r[ 8], r[ 9]);
+    a[10] = _mm512_unpacklo_ps(r[10], r[11]);
+    a[11] = _mm512_unpackhi_ps(r[10], r[11]);
+    a[12] = _mm512_unpacklo_ps(r[12], r[13]);
+    a[13] = _mm512_unpackhi_ps(r[12], r[13]);
+    a[14] = _mm512_unpacklo_ps(r[14], r[15]);
+    a[15] = _mm512_unpackhi_ps(r[14], r[15]);
+
+    b[ 0] = _mm512_shuffle_ps(a[ 0], a[ 2], 68);
+    b[ 1] = _mm512_shuffle_ps(a[ 0], a[ 2], 238);
+    b[ 2] = _mm512_shuffle_ps(a[ 1], a[ 3], 68);
+    b[ 3] = _mm512_shuffle_ps(a[ 1], a[ 3], 238);
+    b[ 4] = _mm512_shuffle_ps(a[ 4], a[ 6], 68);
+    b[ 5] = _mm512_shuffle_ps(a[ 4], a[ 6], 238);
+    b[ 6] = _mm512_shuffle_ps(a[ 5], a[ 7], 68);
+    b[ 7] = _mm512_shuffle_ps(a[ 5], a[ 7], 238);
+    b[ 8] = _mm512_shuffle_ps(a[ 8], a[10], 68);
+    b[ 9] = _mm512_shuffle_ps(a[ 8], a[10], 238);
+    b[10] = _mm512_shuffle_ps(a[ 9], a[11], 68);
+    b[11] = _mm512_shuffle_ps(a[ 9], a[11], 238);
+    b[12] = _mm512_shuffle_ps(a[12], a[14], 68);
+    b[13] = _mm512_shuffle_ps(a[12], a[14], 238);
+    b[14] = _mm512_shuffle_ps(a[13], a[15], 68);
+    b[15] = _mm512_shuffle_ps(a[13], a[15], 238);
+
+    a[ 0] = _mm512_shuffle_f32x4(b[ 0], b[ 4], 68);
+    a[ 1] = _mm512_shuffle_f32x4(b[ 0], b[ 4], 238);
+    a[ 2] = _mm512_shuffle_f32x4(b[ 1], b[ 5], 68);
+    a[ 3] = _mm512_shuffle_f32x4(b[ 1], b[ 5], 238);
+    a[ 4] = _mm512_shuffle_f32x4(b[ 2], b[ 6], 68);
+    a[ 5] = _mm512_shuffle_f32x4(b[ 2], b[ 6], 238);
+    a[ 6] = _mm512_shuffle_f32x4(b[ 3], b[ 7], 68);
+    a[ 7] = _mm512_shuffle_f32x4(b[ 3], b[ 7], 238);
+    a[ 8] = _mm512_shuffle_f32x4(b[ 8], b[12], 68);
+    a[ 9] = _mm512_shuffle_f32x4(b[ 8], b[12], 238);
+    a[10] = _mm512_shuffle_f32x4(b[ 9], b[13], 68);
+    a[11] = _mm512_shuffle_f32x4(b[ 9], b[13], 238);
+    a[12] = _mm512_shuffle_f32x4(b[10], b[14], 68);
+    a[13] = _mm512_shuffle_f32x4(b[10], b[14], 238);
+    a[14] = _mm512_shuffle_f32x4(b[11], b[15], 68);
+    a[15] = _mm512_shuffle_f32x4(b[11], b[15], 238);
+
+    r[ 0] = _mm512_shuffle_f32x4(a[ 0], a[ 8], 136);
+    r[ 4] = _mm512_shuffle_f32x4(a[ 0], a[ 8], 221);
+    r[ 8] = _mm512_shuffle_f32x4(a[ 1], a[ 9], 136);
+    r[12] = _mm512_shuffle_f32x4(a[ 1], a[ 9], 221);
+    r[ 1] = _mm512_shuffle_f32x4(a[ 2], a[10], 136);
+    r[ 5] = _mm512_shuffle_f32x4(a[ 2], a[10], 221);
+    r[ 9] = _mm512_shuffle_f32x4(a[ 3], a[11], 136);
+    r[13] = _mm512_shuffle_f32x4(a[ 3], a[11], 221);
+    r[ 2] = _mm512_shuffle_f32x4(a[ 4], a[12], 136);
+    r[ 6] = _mm512_shuffle_f32x4(a[ 4], a[12], 221);
+    r[10] = _mm512_shuffle_f32x4(a[ 5], a[13], 136);
+    r[14] = _mm512_shuffle_f32x4(a[ 5], a[13], 221);
+    r[ 3] = _mm512_shuffle_f32x4(a[ 6], a[14], 136);
+    r[ 7] = _mm512_shuffle_f32x4(a[ 6], a[14], 221);
+    r[11] = _mm512_shuffle_f32x4(a[ 7], a[15], 136);
+    r[15] = _mm512_shuffle_f32x4(a[ 7], a[15], 221);
+}
+
+template <>
+void base_transform<Context_x86_AVX512>(const TwiddleTable<Context_x86_AVX512>& table, Context_x86_AVX512::vtype* T){
+    using Context = Context_x86_AVX512;
+
+    __m512 r[16];
+    __m512 i[16];
+
+    r[ 0] = T[ 0];
+    i[ 0] = T[ 1];
+    r[ 1] = T[ 2];
+    i[ 1] = T[ 3];
+    r[ 2] = T[ 4];
+    i[ 2] = T[ 5];
+    r[ 3] = T[ 6];
+    i[ 3] = T[ 7];
+    r[ 4] = T[ 8];
+    i[ 4] = T[ 9];
+    r[ 5] = T[10];
+    i[ 5] = T[11];
+    r[ 6] = T[12];
+    i[ 6] = T[13];
+    r[ 7] = T[14];
+    i[ 7] = T[15];
+    r[ 8] = T[16];
+    i[ 8] = T[17];
+    r[ 9] = T[18];
+    i[ 9] = T[19];
+    r[10] = T[20];
+    i[10] = T[21];
+    r[11] = T[22];
+    i[11] = T[23];
+    r[12] = T[24];
+    i[12] = T[25];
+    r[13] = T[26];
+    i[13] = T[27];
+    r[14] = T[28];
+    i[14] = T[29];
+    r[15] = T[30];
+    i[15] = T[31];
+
+    //  Radix-4 over the whole 256 points.
+    {
+        const vcomplex<Context>* w1 = table[7].w1.data();
+        const vcomplex<Context>* w2 = table[8].w1.data();
+        const vcomplex<Context>* w3 = table[8].w3.data();
+        Butterflies<Context>::butterfly4(
+            r[ 0], i[ 0],
+            r[ 4], i[ 4], w1[0].r, w1[0].i,
+            r[ 8], i[ 8], w2[0].r, w2[0].i,
+            r[12], i[12], w3[0].r, w3[0].i
+        );
+        Butterflies<Context>::butterfly4(
+            r[ 1], i[ 1],
+            r[ 5], i[ 5], w1[1].r, w1[1].i,
+            r[ 9], i[ 9], w2[1].r, w2[1].i,
+            r[13], i[13], w3[1].r, w3[1].i
+        );
+        Butterflies<Context>::butterfly4(
+            r[ 2], i[ 2],
+            r[ 6], i[ 6], w1[2].r, w1[2].i,
+            r[10], i[10], w2[2].r, w2[2].i,
+            r[14], i[14], w3[2].r, w3[2].i
+        );
+        Butterflies<Context>::butterfly4(
+            r[ 3], i[ 3],
+            r[ 7], i[ 7], w1[3].r, w1[3].i,
+            r[11], i[11], w2[3].r, w2[3].i,
+            r[15], i[15], w3[3].r, w3[3].i
+        );
+    }
+
+    //  Radix-4 over each quarter of 64 points.
+    {
+        const vcomplex<Context>* w1 = table[5].w1.data();
+        const vcomplex<Context>* w2 = table[6].w1.data();
+        const vcomplex<Context>* w3 = table[6].w3.data();
+        Butterflies<Context>::butterfly4(
+            r[ 0], i[ 0],
+            r[ 1], i[ 1], w1[0].r, w1[0].i,
+            r[ 2], i[ 2], w2[0].r, w2[0].i,
+            r[ 3], i[ 3], w3[0].r, w3[0].i
+        );
+        Butterflies<Context>::butterfly4(
+            r[ 4], i[ 4],
+            r[ 5], i[ 5], w1[0].r, w1[0].i,
+            r[ 6], i[ 6], w2[0].r, w2[0].i,
+            r[ 7], i[ 7], w3[0].r, w3[0].i
+        );
+        Butterflies<Context>::butterfly4(
+            r[ 8], i[ 8],
+            r[ 9], i[ 9], w1[0].r, w1[0].i,
+            r[10], i[10], w2[0].r, w2[0].i,
+            r[11], i[11], w3[0].r, w3[0].i
+        );
+        Butterflies<Context>::butterfly4(
+            r[12], i[12],
+            r[13], i[13], w1[0].r, w1[0].i,
+            r[14], i[14], w2[0].r, w2[0].i,
+            r[15], i[15], w3[0].r, w3[0].i
+        );
+    }
+
+    //  The rest is a 16-point transform within each vector.
+    vtranspose(r);
+    vtranspose(i);
+
+    Butterflies<Context>::butterfly4(
+        r[ 0], i[ 0],
+        r[ 4], i[ 4],
+        r[ 8], i[ 8],
+        r[12], i[12]
+    );
+    Butterflies<Context>::butterfly4(
+        r[ 1], i[ 1],
+        r[ 5], i[ 5], Context::vset1(TW8_1), Context::vset1(TW8_1),
+        r[ 9], i[ 9], Context::vset1(TW16_1), Context::vset1(TW16_3),
+        r[13], i[13], Context::vset1(TW16_3), Context::vset1(TW16_1)
+    );
+    Butterflies<Context>::butterfly4(
+        r[ 2], i[ 2],
+        r[ 6], i[ 6], Context::vset1(0), Context::vset1(1),
+        r[10], i[10], Context::vset1(TW8_1), Context::vset1(TW8_1),
+        r[14], i[14], Context::vset1(-TW8_1), Context::vset1(TW8_1)
+    );
+    Butterflies<Context>::butterfly4(
+        r[ 3], i[ 3],
+        r[ 7], i[ 7], Context::vset1(-TW8_1), Context::vset1(TW8_1),
+        r[11], i[11], Context::vset1(TW16_3), Context::vset1(TW16_1),
+        r[15], i[15], Context::vset1(-TW16_1), Context::vset1(-TW16_3)
+    );
+    Butterflies<Context>::butterfly4(
+        r[ 0], i[ 0],
+        r[ 1], i[ 1],
+        r[ 2], i[ 2],
+        r[ 3], i[ 3]
+    );
+    Butterflies<Context>::butterfly4(
+        r[ 4], i[ 4],
+        r[ 5], i[ 5],
+        r[ 6], i[ 6],
+        r[ 7], i[ 7]
+    );
+    Butterflies<Context>::butterfly4(
+        r[ 8], i[ 8],
+        r[ 9], i[ 9],
+        r[10], i[10],
+        r[11], i[11]
+    );
+    Butterflies<Context>::butterfly4(
+        r[12], i[12],
+        r[13], i[13],
+        r[14], i[14],
+        r[15], i[15]
+    );
+
+    vtranspose(r);
+    vtranspose(i);
+    T[ 0] = r[ 0];
+    T[ 1] = i[ 0];
+    T[ 2] = r[ 1];
+    T[ 3] = i[ 1];
+    T[ 4] = r[ 2];
+    T[ 5] = i[ 2];
+    T[ 6] = r[ 3];
+    T[ 7] = i[ 3];
+    T[ 8] = r[ 4];
+    T[ 9] = i[ 4];
+    T[10] = r[ 5];
+    T[11] = i[ 5];
+    T[12] = r[ 6];
+    T[13] = i[ 6];
+    T[14] = r[ 7];
+    T[15] = i[ 7];
+    T[16] = r[ 8];
+    T[17] = i[ 8];
+    T[18] = r[ 9];
+    T[19] = i[ 9];
+    T[20] = r[10];
+    T[21] = i[10];
+    T[22] = r[11];
+    T[23] = i[11];
+    T[24] = r[12];
+    T[25] = i[12];
+    T[26] = r[13];
+    T[27] = i[13];
+    T[28] = r[14];
+    T[29] = i[14];
+    T[30] = r[15];
+    T[31] = i[15];
+}
+
+
+
+}
+}
+}
+#endif
@@ -30,6 +30,11 @@ void fft_abs_Default(int k, float* abs, float* real){
     table.ensure(k);
     fft_abs(table, k, abs, real);
 }
+void fft_abs_Default(int k, size_t count, float* const* abs, float* const* real){
+    TwiddleTable<Context_Default>& table = global_table_Default();
+    table.ensure(k);
+    fft_abs(table, k, count, abs, real);
+}
 
 
 
@@ -26,6 +26,11 @@ void fft_abs_x86_SSE41(int k, float* abs, float* real){
     table.ensure(k);
     fft_abs(table, k, abs, real);
 }
+void fft_abs_x86_SSE41(int k, size_t count, float* const* abs, float* const* real){
+    TwiddleTable<Context_x86_SSE41>& table = global_table_x86_SSE41();
+    table.ensure(k);
+    fft_abs(table, k, count, abs, real);
+}
 
 
 
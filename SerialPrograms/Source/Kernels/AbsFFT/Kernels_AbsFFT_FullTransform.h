@@ -20,6 +20,20 @@ void fft_abs_scalar(const TwiddleTable<Context>& table, int k, float* abs, float
 template <typename Context>
 void fft_abs(const TwiddleTable<Context>& table, int k, float* abs, float* real);
 
+template <typename Context>
+void fft_abs(const TwiddleTable<Context>& table, int k, size_t count, float* const* abs, float* const* real);
+
+
+//  Transforms that are too small for the vector path of "Context".
+//  By default they go to the scalar path. Contexts with wide vectors can
+//  specialize this to hand them to a narrower context instead.
+template <typename Context>
+struct SmallTransform{
+    static void fft_abs(const TwiddleTable<Context>& table, int k, float* abs, float* real){
+        fft_abs_scalar<Context>(table, k, abs, real);
+    }
+};
+
 
 
 }
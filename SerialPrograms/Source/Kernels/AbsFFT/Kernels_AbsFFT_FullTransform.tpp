@@ -102,7 +102,7 @@ void fft_abs(const TwiddleTable<Context>& table, int k, float* abs, float* real)
     using vtype = typename Context::vtype;
 
     if (k - 2 < Context::BASE_COMPLEX_TRANSFORM_K){
-        fft_abs_scalar<Context>(table, k, abs, real);
+        SmallTransform<Context>::fft_abs(table, k, abs, real);
         return;
     }
 
@@ -131,6 +131,14 @@ void fft_abs(const TwiddleTable<Context>& table, int k, float* abs, float* real)
 }
 
 
+template <typename Context>
+void fft_abs(const TwiddleTable<Context>& table, int k, size_t count, float* const* abs, float* const* real){
+    for (size_t c = 0; c < count; c++){
+        fft_abs(table, k, abs[c], real[c]);
+    }
+}
+
+
 
 
 
@@ -300,12 +300,14 @@ PackedBinaryMatrixCore<Tile> PackedBinaryMatrixCore<Tile>::submatrix(
     }
 
 #if 1
+    //  If the dimensions are a multiple of the tile size, the last tile is
+    //  full and there's no padding to clear.
     size_t wbits = width % TILE_WIDTH;
-    for (size_t r = 0; r < tile_height; r++){
+    for (size_t r = 0; wbits != 0 && r < tile_height; r++){
         ret.tile(tile_width - 1, r).clear_padding(wbits, TILE_HEIGHT);
     }
     size_t hbits = height % TILE_HEIGHT;
-    for (size_t c = 0; c < tile_width; c++){
+    for (size_t c = 0; hbits != 0 && c < tile_width; c++){
         ret.tile(c, tile_height - 1).clear_padding(TILE_WIDTH, hbits);
     }
 #endif
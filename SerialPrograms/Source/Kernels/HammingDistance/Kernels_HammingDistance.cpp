@@ -0,0 +1,55 @@
+/*  Hamming Distance
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_HammingDistance.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void hamming_distance_Default(
+    uint32_t* distances,
+    const uint64_t* query,
+    const uint64_t* targets, size_t words, size_t count
+);
+void hamming_distance_x64_SSE42(
+    uint32_t* distances,
+    const uint64_t* query,
+    const uint64_t* targets, size_t words, size_t count
+);
+void hamming_distance_x64_AVX2(
+    uint32_t* distances,
+    const uint64_t* query,
+    const uint64_t* targets, size_t words, size_t count
+);
+
+
+
+void hamming_distance(
+    uint32_t* distances,
+    const uint64_t* query,
+    const uint64_t* targets, size_t words, size_t count
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        hamming_distance_x64_AVX2(distances, query, targets, words, count);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        hamming_distance_x64_SSE42(distances, query, targets, words, count);
+        return;
+    }
+#endif
+    hamming_distance_Default(distances, query, targets, words, count);
+}
+
+
+
+}
+}
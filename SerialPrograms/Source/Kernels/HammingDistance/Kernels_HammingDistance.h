@@ -0,0 +1,30 @@
+/*  Hamming Distance
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_HammingDistance_H
+#define PokemonAutomation_Kernels_HammingDistance_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Compare "query" against "count" bit strings that are stored back-to-back
+//  in "targets". Each bit string is "words" 64-bit words long.
+//
+//  distances[i] = # of bits that differ between "query" and the i'th target.
+void hamming_distance(
+    uint32_t* distances,
+    const uint64_t* query,
+    const uint64_t* targets, size_t words, size_t count
+);
+
+
+}
+}
+#endif
@@ -0,0 +1,40 @@
+/*  Hamming Distance (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Compiler.h"
+#include "Kernels_HammingDistance.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE uint64_t popcount_Default(uint64_t x){
+    x = x - ((x >> 1) & 0x5555555555555555);
+    x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0f;
+    return (x * 0x0101010101010101) >> 56;
+}
+
+
+void hamming_distance_Default(
+    uint32_t* distances,
+    const uint64_t* query,
+    const uint64_t* targets, size_t words, size_t count
+){
+    for (size_t i = 0; i < count; i++){
+        uint64_t sum = 0;
+        for (size_t c = 0; c < words; c++){
+            sum += popcount_Default(query[c] ^ targets[c]);
+        }
+        distances[i] = (uint32_t)sum;
+        targets += words;
+    }
+}
+
+
+
+}
+}
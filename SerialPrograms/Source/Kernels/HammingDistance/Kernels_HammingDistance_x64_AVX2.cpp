@@ -0,0 +1,67 @@
+/*  Hamming Distance (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_HammingDistance.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Per-byte popcount using a nibble lookup table. Then sum the bytes into
+//  the 4 x 64-bit lanes.
+PA_FORCE_INLINE __m256i popcount_u64x4(__m256i x){
+    const __m256i LUT = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+    );
+    const __m256i MASK = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(x, MASK);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), MASK);
+    __m256i bytes = _mm256_add_epi8(
+        _mm256_shuffle_epi8(LUT, lo),
+        _mm256_shuffle_epi8(LUT, hi)
+    );
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+PA_FORCE_INLINE uint64_t reduce_add_u64x4(__m256i x){
+    __m128i v = _mm_add_epi64(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+    return _mm_cvtsi128_si64(v) + _mm_extract_epi64(v, 1);
+}
+
+
+void hamming_distance_x64_AVX2(
+    uint32_t* distances,
+    const uint64_t* query,
+    const uint64_t* targets, size_t words, size_t count
+){
+    for (size_t i = 0; i < count; i++){
+        __m256i sum = _mm256_setzero_si256();
+        size_t c = 0;
+        for (; c + 4 <= words; c += 4){
+            __m256i x = _mm256_xor_si256(
+                _mm256_loadu_si256((const __m256i*)(query + c)),
+                _mm256_loadu_si256((const __m256i*)(targets + c))
+            );
+            sum = _mm256_add_epi64(sum, popcount_u64x4(x));
+        }
+        uint64_t total = reduce_add_u64x4(sum);
+        for (; c < words; c++){
+            total += _mm_popcnt_u64(query[c] ^ targets[c]);
+        }
+        distances[i] = (uint32_t)total;
+        targets += words;
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,35 @@
+/*  Hamming Distance (x64 SSE4.2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <nmmintrin.h>
+#include "Kernels_HammingDistance.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void hamming_distance_x64_SSE42(
+    uint32_t* distances,
+    const uint64_t* query,
+    const uint64_t* targets, size_t words, size_t count
+){
+    for (size_t i = 0; i < count; i++){
+        uint64_t sum = 0;
+        for (size_t c = 0; c < words; c++){
+            sum += _mm_popcnt_u64(query[c] ^ targets[c]);
+        }
+        distances[i] = (uint32_t)sum;
+        targets += words;
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,41 @@
+/*  RGB32 to HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Convert an RGB32 image to HSV32. Each HSV32 pixel keeps the alpha of the
+ *  RGB32 pixel in the top byte. The other three bytes are:
+ *
+ *      H: Bits 16-23. The standard hue [0, 360) mapped to [0, 256).
+ *      S: Bits  8-15. [0, 255]
+ *      V: Bits  0- 7. [0, 255]
+ *
+ *  So an HSV32 pixel can be passed to anything that filters RGB32 pixels by
+ *  channel range with (H, S, V) in place of (R, G, B).
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageHSV_H
+#define PokemonAutomation_Kernels_ImageHSV_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Convert a single pixel. All the vectorized versions match this exactly.
+uint32_t rgb32_to_hsv32(uint32_t pixel);
+
+
+//  Convert an image. "in" and "out" may be the same buffer.
+void convert_rgb32_to_hsv32(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+);
+
+
+}
+}
+#endif
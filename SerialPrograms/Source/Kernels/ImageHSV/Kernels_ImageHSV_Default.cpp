@@ -0,0 +1,72 @@
+/*  RGB32 to HSV32 (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "Kernels_ImageHSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+uint32_t rgb32_to_hsv32(uint32_t p){
+    int r = (uint32_t(0xff) & (p >> 16));
+    int g = (uint32_t(0xff) & (p >> 8));
+    int b = (uint32_t(0xff) & p);
+
+    int M = std::max(std::max(r, g), b);
+    int m = std::min(std::min(r, g), b);
+
+    int delta = M - m;
+
+    int S = 0;
+    if (M > 0){
+        S = std::min(std::max(255 - (m*255 + M/2)/M, 0), 255);
+    }
+
+    int V = M;
+
+    double Hf = 0;
+    if (delta > 0){
+        if (M == r){
+            Hf = fmod((g - b)/(double)delta, 6.0);
+        } else if (M == g){
+            Hf = (b - r)/(double)delta + 2.0;
+        } else{
+            Hf = (r - g)/(double)delta + 4.0;
+        }
+    }
+    //  This Hf * 60.0 is the standard H value, which ranges in [0, 360).
+    //  To hold it in a uint8, need to convert its range to [0, 255].
+    //  (Negative hues from the red sector end up as 0. The vectorized
+    //  versions replicate this.)
+    int H = std::max(int(Hf * 256.0 / 6.0 + 0.5) % 256, 0);
+
+    return (p & 0xff000000) |
+           ((uint32_t)(uint8_t)H << 16) |
+           ((uint32_t)(uint8_t)S << 8) |
+           (uint8_t)V;
+}
+
+
+void convert_rgb32_to_hsv32_Default(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            out[c] = rgb32_to_hsv32(in[c]);
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
@@ -0,0 +1,90 @@
+/*  RGB32 to HSV32 (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  See the x64 SSE4.1 version for how the hue is computed.
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <arm_neon.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE uint32x4_t rgb32_to_hsv32_arm64_NEON(uint32x4_t pixel){
+    const uint32x4_t mask8 = vmovq_n_u32(0xff);
+    int32x4_t r = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixel, 16), mask8));
+    int32x4_t g = vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(pixel, 8), mask8));
+    int32x4_t b = vreinterpretq_s32_u32(vandq_u32(pixel, mask8));
+
+    int32x4_t M = vmaxq_s32(vmaxq_s32(r, g), b);
+    int32x4_t m = vminq_s32(vminq_s32(r, g), b);
+    int32x4_t D = vmaxq_s32(vsubq_s32(M, m), vmovq_n_s32(1));
+    int32x4_t D2 = vaddq_s32(D, D);
+    int32x4_t D3 = vaddq_s32(D2, D);
+
+    //  Sector selection. Red takes priority over green over blue.
+    uint32x4_t is_r = vceqq_s32(M, r);
+    uint32x4_t is_g = vceqq_s32(M, g);
+    int32x4_t t = vbslq_s32(is_g, vsubq_s32(b, r), vsubq_s32(r, g));
+    int32x4_t k = vbslq_s32(is_g, D2, vaddq_s32(D2, D2));
+    t = vbslq_s32(is_r, vsubq_s32(g, b), t);
+    k = vbslq_s32(is_r, vmovq_n_s32(0), k);
+
+    //  Hue
+    int32x4_t num = vaddq_s32(vshlq_n_s32(vaddq_s32(t, k), 8), D3);
+    float32x4_t Hf = vdivq_f32(vcvtq_f32_s32(num), vcvtq_f32_s32(vaddq_s32(D3, D3)));
+    int32x4_t H = vmaxq_s32(vcvtq_s32_f32(Hf), vmovq_n_s32(0));
+
+    //  Saturation
+    num = vaddq_s32(vsubq_s32(vshlq_n_s32(m, 8), m), vshrq_n_s32(M, 1));
+    float32x4_t Sf = vdivq_f32(vcvtq_f32_s32(num), vcvtq_f32_s32(vmaxq_s32(M, vmovq_n_s32(1))));
+    int32x4_t S = vsubq_s32(vmovq_n_s32(255), vcvtq_s32_f32(Sf));
+    S = vbslq_s32(vceqq_s32(M, vmovq_n_s32(0)), vmovq_n_s32(0), S);
+
+    uint32x4_t out = vandq_u32(pixel, vmovq_n_u32(0xff000000));
+    out = vorrq_u32(out, vshlq_n_u32(vreinterpretq_u32_s32(H), 16));
+    out = vorrq_u32(out, vshlq_n_u32(vreinterpretq_u32_s32(S), 8));
+    out = vorrq_u32(out, vreinterpretq_u32_s32(M));
+    return out;
+}
+
+
+void convert_rgb32_to_hsv32_arm64_NEON(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* in_row = in;
+        uint32_t* out_row = out;
+        size_t lc = width / 4;
+        while (lc--){
+            vst1q_u32(out_row, rgb32_to_hsv32_arm64_NEON(vld1q_u32(in_row)));
+            in_row += 4;
+            out_row += 4;
+        }
+        size_t left = width % 4;
+        if (left){
+            uint32_t buffer[4] = {};
+            memcpy(buffer, in_row, left * sizeof(uint32_t));
+            vst1q_u32(buffer, rgb32_to_hsv32_arm64_NEON(vld1q_u32(buffer)));
+            memcpy(out_row, buffer, left * sizeof(uint32_t));
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,91 @@
+/*  RGB32 to HSV32 (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  See the SSE4.1 version for how the hue is computed.
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <stdint.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE __m256i rgb32_to_hsv32_x64_AVX2(__m256i pixel){
+    const __m256i mask8 = _mm256_set1_epi32(0xff);
+    __m256i r = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), mask8);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), mask8);
+    __m256i b = _mm256_and_si256(pixel, mask8);
+
+    __m256i M = _mm256_max_epi32(_mm256_max_epi32(r, g), b);
+    __m256i m = _mm256_min_epi32(_mm256_min_epi32(r, g), b);
+    __m256i D = _mm256_max_epi32(_mm256_sub_epi32(M, m), _mm256_set1_epi32(1));
+    __m256i D2 = _mm256_add_epi32(D, D);
+    __m256i D3 = _mm256_add_epi32(D2, D);
+
+    //  Sector selection. Red takes priority over green over blue.
+    __m256i is_r = _mm256_cmpeq_epi32(M, r);
+    __m256i is_g = _mm256_cmpeq_epi32(M, g);
+    __m256i t = _mm256_blendv_epi8(_mm256_sub_epi32(r, g), _mm256_sub_epi32(b, r), is_g);
+    __m256i k = _mm256_blendv_epi8(_mm256_add_epi32(D2, D2), D2, is_g);
+    t = _mm256_blendv_epi8(t, _mm256_sub_epi32(g, b), is_r);
+    k = _mm256_andnot_si256(is_r, k);
+
+    //  Hue
+    __m256i num = _mm256_add_epi32(_mm256_slli_epi32(_mm256_add_epi32(t, k), 8), D3);
+    __m256 Hf = _mm256_div_ps(_mm256_cvtepi32_ps(num), _mm256_cvtepi32_ps(_mm256_add_epi32(D3, D3)));
+    __m256i H = _mm256_max_epi32(_mm256_cvttps_epi32(Hf), _mm256_setzero_si256());
+
+    //  Saturation
+    num = _mm256_add_epi32(_mm256_sub_epi32(_mm256_slli_epi32(m, 8), m), _mm256_srli_epi32(M, 1));
+    __m256 Sf = _mm256_div_ps(_mm256_cvtepi32_ps(num), _mm256_cvtepi32_ps(_mm256_max_epi32(M, _mm256_set1_epi32(1))));
+    __m256i S = _mm256_sub_epi32(_mm256_set1_epi32(255), _mm256_cvttps_epi32(Sf));
+    S = _mm256_andnot_si256(_mm256_cmpeq_epi32(M, _mm256_setzero_si256()), S);
+
+    __m256i out = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+    out = _mm256_or_si256(out, _mm256_slli_epi32(H, 16));
+    out = _mm256_or_si256(out, _mm256_slli_epi32(S, 8));
+    out = _mm256_or_si256(out, M);
+    return out;
+}
+
+
+void convert_rgb32_to_hsv32_x64_AVX2(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    size_t left = width % 8;
+    __m256i mask = _mm256_cmpgt_epi32(
+        _mm256_set1_epi32((int)left),
+        _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+    );
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* in_row = in;
+        uint32_t* out_row = out;
+        size_t lc = width / 8;
+        while (lc--){
+            __m256i pixel = _mm256_loadu_si256((const __m256i*)in_row);
+            _mm256_storeu_si256((__m256i*)out_row, rgb32_to_hsv32_x64_AVX2(pixel));
+            in_row += 8;
+            out_row += 8;
+        }
+        if (left){
+            __m256i pixel = _mm256_maskload_epi32((const int*)in_row, mask);
+            _mm256_maskstore_epi32((int*)out_row, mask, rgb32_to_hsv32_x64_AVX2(pixel));
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,90 @@
+/*  RGB32 to HSV32 (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  See the SSE4.1 version for how the hue is computed.
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <stdint.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE __m512i rgb32_to_hsv32_x64_AVX512(__m512i pixel){
+    const __m512i mask8 = _mm512_set1_epi32(0xff);
+    __m512i r = _mm512_and_si512(_mm512_srli_epi32(pixel, 16), mask8);
+    __m512i g = _mm512_and_si512(_mm512_srli_epi32(pixel, 8), mask8);
+    __m512i b = _mm512_and_si512(pixel, mask8);
+
+    __m512i M = _mm512_max_epi32(_mm512_max_epi32(r, g), b);
+    __m512i m = _mm512_min_epi32(_mm512_min_epi32(r, g), b);
+    __m512i D = _mm512_max_epi32(_mm512_sub_epi32(M, m), _mm512_set1_epi32(1));
+    __m512i D2 = _mm512_add_epi32(D, D);
+    __m512i D3 = _mm512_add_epi32(D2, D);
+
+    //  Sector selection. Red takes priority over green over blue.
+    __mmask16 is_r = _mm512_cmpeq_epi32_mask(M, r);
+    __mmask16 is_g = _mm512_cmpeq_epi32_mask(M, g);
+    __m512i t = _mm512_mask_sub_epi32(_mm512_sub_epi32(r, g), is_g, b, r);
+    __m512i k = _mm512_mask_mov_epi32(_mm512_add_epi32(D2, D2), is_g, D2);
+    t = _mm512_mask_sub_epi32(t, is_r, g, b);
+    k = _mm512_mask_mov_epi32(k, is_r, _mm512_setzero_si512());
+
+    //  Hue
+    __m512i num = _mm512_add_epi32(_mm512_slli_epi32(_mm512_add_epi32(t, k), 8), D3);
+    __m512 Hf = _mm512_div_ps(_mm512_cvtepi32_ps(num), _mm512_cvtepi32_ps(_mm512_add_epi32(D3, D3)));
+    __m512i H = _mm512_max_epi32(_mm512_cvttps_epi32(Hf), _mm512_setzero_si512());
+
+    //  Saturation
+    num = _mm512_add_epi32(_mm512_sub_epi32(_mm512_slli_epi32(m, 8), m), _mm512_srli_epi32(M, 1));
+    __m512 Sf = _mm512_div_ps(_mm512_cvtepi32_ps(num), _mm512_cvtepi32_ps(_mm512_max_epi32(M, _mm512_set1_epi32(1))));
+    __m512i S = _mm512_maskz_sub_epi32(
+        _mm512_cmpneq_epi32_mask(M, _mm512_setzero_si512()),
+        _mm512_set1_epi32(255), _mm512_cvttps_epi32(Sf)
+    );
+
+    __m512i out = _mm512_and_si512(pixel, _mm512_set1_epi32(0xff000000));
+    out = _mm512_or_si512(out, _mm512_slli_epi32(H, 16));
+    out = _mm512_or_si512(out, _mm512_slli_epi32(S, 8));
+    out = _mm512_or_si512(out, M);
+    return out;
+}
+
+
+void convert_rgb32_to_hsv32_x64_AVX512(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    size_t left = width % 16;
+    __mmask16 mask = (__mmask16)(((uint32_t)1 << left) - 1);
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* in_row = in;
+        uint32_t* out_row = out;
+        size_t lc = width / 16;
+        while (lc--){
+            __m512i pixel = _mm512_loadu_si512(in_row);
+            _mm512_storeu_si512(out_row, rgb32_to_hsv32_x64_AVX512(pixel));
+            in_row += 16;
+            out_row += 16;
+        }
+        if (left){
+            __m512i pixel = _mm512_maskz_loadu_epi32(mask, in_row);
+            _mm512_mask_storeu_epi32(out_row, mask, rgb32_to_hsv32_x64_AVX512(pixel));
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
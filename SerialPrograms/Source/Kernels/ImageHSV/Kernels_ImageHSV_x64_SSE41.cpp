@@ -0,0 +1,99 @@
+/*  RGB32 to HSV32 (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  The scalar version computes the hue in double precision. Here it is
+ *  rewritten as a single division of two small integers:
+ *
+ *      H = floor(((t + k*D) * 256 + 3*D) / (6*D))
+ *
+ *  where D = max(M - m, 1) and (t, k) are the sector offset and index.
+ *  Both sides are exact in single precision and the quotient is never close
+ *  enough to an integer to round across it, so this matches the scalar
+ *  version bit-for-bit. (verified over all 2^24 colors)
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <string.h>
+#include <stdint.h>
+#include <smmintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE __m128i rgb32_to_hsv32_x64_SSE41(__m128i pixel){
+    const __m128i mask8 = _mm_set1_epi32(0xff);
+    __m128i r = _mm_and_si128(_mm_srli_epi32(pixel, 16), mask8);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(pixel, 8), mask8);
+    __m128i b = _mm_and_si128(pixel, mask8);
+
+    __m128i M = _mm_max_epi32(_mm_max_epi32(r, g), b);
+    __m128i m = _mm_min_epi32(_mm_min_epi32(r, g), b);
+    __m128i D = _mm_max_epi32(_mm_sub_epi32(M, m), _mm_set1_epi32(1));
+    __m128i D2 = _mm_add_epi32(D, D);
+    __m128i D3 = _mm_add_epi32(D2, D);
+
+    //  Sector selection. Red takes priority over green over blue.
+    __m128i is_r = _mm_cmpeq_epi32(M, r);
+    __m128i is_g = _mm_cmpeq_epi32(M, g);
+    __m128i t = _mm_blendv_epi8(_mm_sub_epi32(r, g), _mm_sub_epi32(b, r), is_g);
+    __m128i k = _mm_blendv_epi8(_mm_add_epi32(D2, D2), D2, is_g);
+    t = _mm_blendv_epi8(t, _mm_sub_epi32(g, b), is_r);
+    k = _mm_andnot_si128(is_r, k);
+
+    //  Hue
+    __m128i num = _mm_add_epi32(_mm_slli_epi32(_mm_add_epi32(t, k), 8), D3);
+    __m128 Hf = _mm_div_ps(_mm_cvtepi32_ps(num), _mm_cvtepi32_ps(_mm_add_epi32(D3, D3)));
+    __m128i H = _mm_max_epi32(_mm_cvttps_epi32(Hf), _mm_setzero_si128());
+
+    //  Saturation
+    num = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(m, 8), m), _mm_srli_epi32(M, 1));
+    __m128 Sf = _mm_div_ps(_mm_cvtepi32_ps(num), _mm_cvtepi32_ps(_mm_max_epi32(M, _mm_set1_epi32(1))));
+    __m128i S = _mm_sub_epi32(_mm_set1_epi32(255), _mm_cvttps_epi32(Sf));
+    S = _mm_andnot_si128(_mm_cmpeq_epi32(M, _mm_setzero_si128()), S);
+
+    __m128i out = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+    out = _mm_or_si128(out, _mm_slli_epi32(H, 16));
+    out = _mm_or_si128(out, _mm_slli_epi32(S, 8));
+    out = _mm_or_si128(out, M);
+    return out;
+}
+
+
+void convert_rgb32_to_hsv32_x64_SSE41(
+    size_t width, size_t height,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* in_row = in;
+        uint32_t* out_row = out;
+        size_t lc = width / 4;
+        while (lc--){
+            __m128i pixel = _mm_loadu_si128((const __m128i*)in_row);
+            _mm_storeu_si128((__m128i*)out_row, rgb32_to_hsv32_x64_SSE41(pixel));
+            in_row += 4;
+            out_row += 4;
+        }
+        size_t left = width % 4;
+        if (left){
+            uint32_t buffer[4] = {};
+            memcpy(buffer, in_row, left * sizeof(uint32_t));
+            __m128i pixel = _mm_loadu_si128((const __m128i*)buffer);
+            _mm_storeu_si128((__m128i*)buffer, rgb32_to_hsv32_x64_SSE41(pixel));
+            memcpy(out_row, buffer, left * sizeof(uint32_t));
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,204 @@
+/*  Image Scale
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageScale_Routines.h"
+#include "Kernels_ImageScale.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+ImageScaleAxis::ImageScaleAxis(size_t in_length, size_t out_length, ImageScaleMode mode){
+    first.reserve(out_length);
+    count.reserve(out_length);
+    offset.reserve(out_length);
+
+    auto add_tap = [&](size_t index, float weight){
+        weights.emplace_back(weight);
+        if (count.back()++ == 0){
+            first.back() = (uint32_t)index;
+        }
+    };
+
+    double ratio = (double)in_length / out_length;
+    for (size_t i = 0; i < out_length; i++){
+        first.emplace_back(0);
+        count.emplace_back(0);
+        offset.emplace_back((uint32_t)weights.size());
+
+        switch (mode){
+        case ImageScaleMode::NEAREST:
+            add_tap((2*i + 1) * in_length / (2 * out_length), 1);
+            break;
+
+        case ImageScaleMode::BILINEAR:{
+            double src = (i + 0.5) * ratio - 0.5;
+            if (src <= 0){
+                add_tap(0, 1);
+                break;
+            }
+            if (src >= (double)(in_length - 1)){
+                add_tap(in_length - 1, 1);
+                break;
+            }
+            size_t index = (size_t)src;
+            float frac = (float)(src - (double)index);
+            add_tap(index, 1 - frac);
+            if (frac != 0){
+                add_tap(index + 1, frac);
+            }
+            break;
+        }
+
+        case ImageScaleMode::AREA_AVERAGE:{
+            double lo = (double)(i * in_length) / out_length;
+            double hi = (double)((i + 1) * in_length) / out_length;
+            size_t start = (size_t)lo;
+            size_t end = std::min((size_t)std::ceil(hi), in_length);
+            double total = 0;
+            for (size_t j = start; j < end; j++){
+                total += std::min(hi, j + 1.0) - std::max(lo, (double)j);
+            }
+            for (size_t j = start; j < end; j++){
+                double overlap = std::min(hi, j + 1.0) - std::max(lo, (double)j);
+                if (overlap < 1e-9){
+                    continue;
+                }
+                add_tap(j, (float)(overlap / total));
+            }
+            break;
+        }
+
+        default:
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid ImageScaleMode.");
+        }
+
+        max_taps = std::max<size_t>(max_taps, count.back());
+    }
+}
+
+
+
+ImageScalePlan::ImageScalePlan(
+    size_t in_width, size_t in_height,
+    size_t out_width, size_t out_height,
+    ImageScaleMode mode
+)
+    : m_in_width(in_width)
+    , m_in_height(in_height)
+    , m_out_width(out_width)
+    , m_out_height(out_height)
+    , m_mode(mode)
+{
+    if (in_width == 0 || in_height == 0 || out_width == 0 || out_height == 0){
+        return;
+    }
+    m_x = ImageScaleAxis(in_width, out_width, mode);
+    m_y = ImageScaleAxis(in_height, out_height, mode);
+}
+
+
+
+void scale_image_filtered_Default(
+    const ImageScalePlan& plan,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    ImageScaleScratch& scratch
+);
+void scale_image_filtered_x64_SSE41(
+    const ImageScalePlan& plan,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    ImageScaleScratch& scratch
+);
+void scale_image_filtered_x64_AVX2(
+    const ImageScalePlan& plan,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    ImageScaleScratch& scratch
+);
+void scale_image_filtered_arm64_NEON(
+    const ImageScalePlan& plan,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    ImageScaleScratch& scratch
+);
+
+
+void scale_image_nearest(
+    const ImageScalePlan& plan,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    const uint32_t* x_index = plan.x_axis().first.data();
+    const uint32_t* y_index = plan.y_axis().first.data();
+    size_t width = plan.out_width();
+    size_t height = plan.out_height();
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* row = (const uint32_t*)((const char*)in + y_index[r] * in_bytes_per_row);
+        for (size_t c = 0; c < width; c++){
+            out[c] = row[x_index[c]];
+        }
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+void ImageScalePlan::scale(
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row
+) const{
+    if (m_in_width == 0 || m_in_height == 0 || m_out_width == 0 || m_out_height == 0){
+        return;
+    }
+    if (m_mode == ImageScaleMode::NEAREST){
+        scale_image_nearest(*this, in, in_bytes_per_row, out, out_bytes_per_row);
+        return;
+    }
+
+    //  Row buffers are reused across calls on the same thread.
+    thread_local ImageScaleScratch scratch;
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        scale_image_filtered_x64_AVX2(*this, in, in_bytes_per_row, out, out_bytes_per_row, scratch);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        scale_image_filtered_x64_SSE41(*this, in, in_bytes_per_row, out, out_bytes_per_row, scratch);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        scale_image_filtered_arm64_NEON(*this, in, in_bytes_per_row, out, out_bytes_per_row, scratch);
+        return;
+    }
+#endif
+    scale_image_filtered_Default(*this, in, in_bytes_per_row, out, out_bytes_per_row, scratch);
+}
+
+
+void scale_image(
+    const uint32_t* in, size_t in_bytes_per_row, size_t in_width, size_t in_height,
+    uint32_t* out, size_t out_bytes_per_row, size_t out_width, size_t out_height,
+    ImageScaleMode mode
+){
+    ImageScalePlan plan(in_width, in_height, out_width, out_height, mode);
+    plan.scale(in, in_bytes_per_row, out, out_bytes_per_row);
+}
+
+
+
+}
+}
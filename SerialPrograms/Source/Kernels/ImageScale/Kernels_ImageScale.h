@@ -0,0 +1,104 @@
+/*  Image Scale
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Resample an RGB32 image to a different size.
+ *
+ *  Scaling is separable. Each axis is described by a list of taps (source
+ *  index + weight) per output coordinate. These are computed once into an
+ *  "ImageScalePlan" which can then be reused for any number of images of the
+ *  same input and output dimensions.
+ *
+ *  Example Usage:
+ *
+ *      ImageScalePlan plan(in_width, in_height, 50, 50, ImageScaleMode::AREA_AVERAGE);
+ *      for (...){
+ *          plan.scale(in, in_bytes_per_row, out, out_bytes_per_row);
+ *      }
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageScale_H
+#define PokemonAutomation_Kernels_ImageScale_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+enum class ImageScaleMode{
+    //  Center sampling. Output pixel "i" is source pixel floor((i + 0.5) * in / out).
+    //  QImage::scaled() with Qt::FastTransformation aims at the same points, but
+    //  in fixed point. So it may pick a neighboring source pixel instead.
+    NEAREST,
+    BILINEAR,
+    AREA_AVERAGE,   //  Each output pixel is the average of the source area it covers.
+};
+
+
+//  Resampling coefficients along one axis.
+//  Output coordinate "i" is:
+//      sum(weights[offset[i] + t] * in[first[i] + t]) for t in [0, count[i])
+struct ImageScaleAxis{
+    std::vector<uint32_t> first;
+    std::vector<uint32_t> count;
+    std::vector<uint32_t> offset;
+    std::vector<float> weights;
+    size_t max_taps = 0;
+
+    ImageScaleAxis() = default;
+    ImageScaleAxis(size_t in_length, size_t out_length, ImageScaleMode mode);
+};
+
+
+class ImageScalePlan{
+public:
+    ImageScalePlan(
+        size_t in_width, size_t in_height,
+        size_t out_width, size_t out_height,
+        ImageScaleMode mode
+    );
+
+    size_t in_width() const{ return m_in_width; }
+    size_t in_height() const{ return m_in_height; }
+    size_t out_width() const{ return m_out_width; }
+    size_t out_height() const{ return m_out_height; }
+    ImageScaleMode mode() const{ return m_mode; }
+
+    const ImageScaleAxis& x_axis() const{ return m_x; }
+    const ImageScaleAxis& y_axis() const{ return m_y; }
+
+    //  "in" must be (in_width x in_height). "out" must be (out_width x out_height).
+    //  "in" can be a sub-image of a larger image. The buffers may not overlap.
+    //  The plan is not modified, so it can be shared by multiple threads.
+    void scale(
+        const uint32_t* in, size_t in_bytes_per_row,
+        uint32_t* out, size_t out_bytes_per_row
+    ) const;
+
+private:
+    size_t m_in_width;
+    size_t m_in_height;
+    size_t m_out_width;
+    size_t m_out_height;
+    ImageScaleMode m_mode;
+    ImageScaleAxis m_x;
+    ImageScaleAxis m_y;
+};
+
+
+//  One-shot version of the above.
+void scale_image(
+    const uint32_t* in, size_t in_bytes_per_row, size_t in_width, size_t in_height,
+    uint32_t* out, size_t out_bytes_per_row, size_t out_width, size_t out_height,
+    ImageScaleMode mode
+);
+
+
+
+}
+}
+#endif
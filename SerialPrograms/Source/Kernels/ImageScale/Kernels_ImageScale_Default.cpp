@@ -0,0 +1,76 @@
+/*  Image Scale (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include "Kernels_ImageScale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct ImageScaler_Default{
+    void horizontal(float* out, const uint32_t* in, const ImageScaleAxis& axis) const{
+        size_t width = axis.first.size();
+        for (size_t c = 0; c < width; c++){
+            const uint32_t* src = in + axis.first[c];
+            const float* weight = axis.weights.data() + axis.offset[c];
+            size_t taps = axis.count[c];
+            float sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+            for (size_t t = 0; t < taps; t++){
+                uint32_t pixel = src[t];
+                float w = weight[t];
+                sum0 += (float)((pixel >>  0) & 0xff) * w;
+                sum1 += (float)((pixel >>  8) & 0xff) * w;
+                sum2 += (float)((pixel >> 16) & 0xff) * w;
+                sum3 += (float)((pixel >> 24) & 0xff) * w;
+            }
+            out[0] = sum0;
+            out[1] = sum1;
+            out[2] = sum2;
+            out[3] = sum3;
+            out += 4;
+        }
+    }
+    static uint32_t to_channel(float x){
+        x = std::nearbyint(x);
+        x = x < 0 ? 0 : x;
+        x = x > 255 ? 255 : x;
+        return (uint32_t)x;
+    }
+    void vertical(uint32_t* out, size_t width, const float* const* rows, const float* weights, size_t taps) const{
+        for (size_t c = 0; c < width; c++){
+            float sum[4] = {};
+            for (size_t t = 0; t < taps; t++){
+                const float* src = rows[t] + 4*c;
+                float w = weights[t];
+                sum[0] += src[0] * w;
+                sum[1] += src[1] * w;
+                sum[2] += src[2] * w;
+                sum[3] += src[3] * w;
+            }
+            out[c] =
+                (to_channel(sum[0]) <<  0) |
+                (to_channel(sum[1]) <<  8) |
+                (to_channel(sum[2]) << 16) |
+                (to_channel(sum[3]) << 24);
+        }
+    }
+};
+
+
+void scale_image_filtered_Default(
+    const ImageScalePlan& plan,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    ImageScaleScratch& scratch
+){
+    scale_image_filtered(plan, in, in_bytes_per_row, out, out_bytes_per_row, scratch, ImageScaler_Default());
+}
+
+
+
+}
+}
@@ -0,0 +1,84 @@
+/*  Image Scale Routines
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Arch-independent driver for the filtered (non-nearest) scaling modes.
+ *
+ *  Input rows are first scaled horizontally into rows of floats (4 per pixel)
+ *  which are then combined vertically into the output rows. The horizontal
+ *  rows are kept in a ring buffer of "y_axis().max_taps" rows since each
+ *  output row only needs that many consecutive input rows.
+ *
+ *  The "Scaler" provides the arch-specific inner loops:
+ *
+ *      void horizontal(float* out, const uint32_t* in, const ImageScaleAxis& axis) const;
+ *      void vertical(uint32_t* out, size_t width, const float* const* rows, const float* weights, size_t taps) const;
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageScale_Routines_H
+#define PokemonAutomation_Kernels_ImageScale_Routines_H
+
+#include "Kernels_ImageScale.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct ImageScaleScratch{
+    std::vector<float> rows;
+    std::vector<size_t> tags;
+    std::vector<const float*> taps;
+};
+
+
+template <typename Scaler>
+void scale_image_filtered(
+    const ImageScalePlan& plan,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    ImageScaleScratch& scratch,
+    const Scaler& scaler
+){
+    const ImageScaleAxis& x_axis = plan.x_axis();
+    const ImageScaleAxis& y_axis = plan.y_axis();
+
+    size_t out_width = plan.out_width();
+    size_t out_height = plan.out_height();
+    size_t ring = y_axis.max_taps;
+    size_t row_floats = 4 * out_width;
+
+    scratch.rows.resize(ring * row_floats);
+    scratch.tags.assign(ring, (size_t)-1);
+    scratch.taps.resize(ring);
+
+    for (size_t r = 0; r < out_height; r++){
+        size_t first = y_axis.first[r];
+        size_t count = y_axis.count[r];
+        for (size_t t = 0; t < count; t++){
+            size_t row = first + t;
+            size_t slot = row % ring;
+            float* buffer = scratch.rows.data() + slot * row_floats;
+            if (scratch.tags[slot] != row){
+                scaler.horizontal(
+                    buffer,
+                    (const uint32_t*)((const char*)in + row * in_bytes_per_row),
+                    x_axis
+                );
+                scratch.tags[slot] = row;
+            }
+            scratch.taps[t] = buffer;
+        }
+        scaler.vertical(
+            out, out_width,
+            scratch.taps.data(), y_axis.weights.data() + y_axis.offset[r], count
+        );
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,83 @@
+/*  Image Scale (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <arm_neon.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImageScale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct ImageScaler_arm64_NEON{
+    static PA_FORCE_INLINE float32x4_t load_pixel(const uint32_t* pixel){
+        uint8x8_t bytes = vreinterpret_u8_u32(vld1_dup_u32(pixel));
+        return vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(bytes))));
+    }
+    static PA_FORCE_INLINE float32x4_t vertical_pixel(const float* const* rows, const float* weights, size_t taps, size_t c){
+        float32x4_t sum = vmovq_n_f32(0);
+        for (size_t t = 0; t < taps; t++){
+            sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(rows[t] + 4*c), weights[t]));
+        }
+        return sum;
+    }
+    static PA_FORCE_INLINE uint16x4_t to_u16(float32x4_t x){
+        return vqmovun_s32(vcvtnq_s32_f32(x));
+    }
+
+    void horizontal(float* out, const uint32_t* in, const ImageScaleAxis& axis) const{
+        size_t width = axis.first.size();
+        for (size_t c = 0; c < width; c++){
+            const uint32_t* src = in + axis.first[c];
+            const float* weight = axis.weights.data() + axis.offset[c];
+            size_t taps = axis.count[c];
+            float32x4_t sum = vmovq_n_f32(0);
+            for (size_t t = 0; t < taps; t++){
+                sum = vaddq_f32(sum, vmulq_n_f32(load_pixel(src + t), weight[t]));
+            }
+            vst1q_f32(out, sum);
+            out += 4;
+        }
+    }
+    void vertical(uint32_t* out, size_t width, const float* const* rows, const float* weights, size_t taps) const{
+        size_t c = 0;
+        for (; c + 4 <= width; c += 4){
+            uint16x8_t p01 = vcombine_u16(
+                to_u16(vertical_pixel(rows, weights, taps, c + 0)),
+                to_u16(vertical_pixel(rows, weights, taps, c + 1))
+            );
+            uint16x8_t p23 = vcombine_u16(
+                to_u16(vertical_pixel(rows, weights, taps, c + 2)),
+                to_u16(vertical_pixel(rows, weights, taps, c + 3))
+            );
+            uint8x16_t pixels = vcombine_u8(vqmovn_u16(p01), vqmovn_u16(p23));
+            vst1q_u32(out + c, vreinterpretq_u32_u8(pixels));
+        }
+        for (; c < width; c++){
+            uint16x4_t p = to_u16(vertical_pixel(rows, weights, taps, c));
+            uint8x8_t bytes = vqmovn_u16(vcombine_u16(p, p));
+            out[c] = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+        }
+    }
+};
+
+
+void scale_image_filtered_arm64_NEON(
+    const ImageScalePlan& plan,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    ImageScaleScratch& scratch
+){
+    scale_image_filtered(plan, in, in_bytes_per_row, out, out_bytes_per_row, scratch, ImageScaler_arm64_NEON());
+}
+
+
+
+}
+}
+#endif
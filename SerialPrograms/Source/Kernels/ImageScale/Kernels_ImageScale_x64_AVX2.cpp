@@ -0,0 +1,92 @@
+/*  Image Scale (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  The horizontal pass is the same as SSE4.1 since each output pixel has its
+ *  own set of taps. The vertical pass uses the same taps for the entire row
+ *  and runs two pixels per vector.
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImageScale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct ImageScaler_x64_AVX2{
+    static PA_FORCE_INLINE __m128 load_pixel(const uint32_t* pixel){
+        return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int*)pixel)));
+    }
+    static PA_FORCE_INLINE __m256 vertical_pixel2(const float* const* rows, const float* weights, size_t taps, size_t c){
+        __m256 sum = _mm256_setzero_ps();
+        for (size_t t = 0; t < taps; t++){
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(rows[t] + 4*c), _mm256_set1_ps(weights[t])));
+        }
+        return sum;
+    }
+    static PA_FORCE_INLINE __m128 vertical_pixel(const float* const* rows, const float* weights, size_t taps, size_t c){
+        __m128 sum = _mm_setzero_ps();
+        for (size_t t = 0; t < taps; t++){
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(rows[t] + 4*c), _mm_set1_ps(weights[t])));
+        }
+        return sum;
+    }
+
+    void horizontal(float* out, const uint32_t* in, const ImageScaleAxis& axis) const{
+        size_t width = axis.first.size();
+        for (size_t c = 0; c < width; c++){
+            const uint32_t* src = in + axis.first[c];
+            const float* weight = axis.weights.data() + axis.offset[c];
+            size_t taps = axis.count[c];
+            __m128 sum = _mm_setzero_ps();
+            for (size_t t = 0; t < taps; t++){
+                sum = _mm_add_ps(sum, _mm_mul_ps(load_pixel(src + t), _mm_set1_ps(weight[t])));
+            }
+            _mm_storeu_ps(out, sum);
+            out += 4;
+        }
+    }
+    void vertical(uint32_t* out, size_t width, const float* const* rows, const float* weights, size_t taps) const{
+        size_t c = 0;
+        for (; c + 8 <= width; c += 8){
+            //  Lanes: p01 = [0, 1], p23 = [2, 3], ...
+            __m256i p01 = _mm256_cvtps_epi32(vertical_pixel2(rows, weights, taps, c + 0));
+            __m256i p23 = _mm256_cvtps_epi32(vertical_pixel2(rows, weights, taps, c + 2));
+            __m256i p45 = _mm256_cvtps_epi32(vertical_pixel2(rows, weights, taps, c + 4));
+            __m256i p67 = _mm256_cvtps_epi32(vertical_pixel2(rows, weights, taps, c + 6));
+
+            //  Packs are in-lane: [0, 2, 4, 6 | 1, 3, 5, 7]
+            p01 = _mm256_packus_epi32(p01, p23);
+            p45 = _mm256_packus_epi32(p45, p67);
+            __m256i pixels = _mm256_packus_epi16(p01, p45);
+            pixels = _mm256_permutevar8x32_epi32(pixels, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+            _mm256_storeu_si256((__m256i*)(out + c), pixels);
+        }
+        for (; c < width; c++){
+            __m128i p = _mm_cvtps_epi32(vertical_pixel(rows, weights, taps, c));
+            p = _mm_packus_epi32(p, p);
+            out[c] = (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(p, p));
+        }
+    }
+};
+
+
+void scale_image_filtered_x64_AVX2(
+    const ImageScalePlan& plan,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    ImageScaleScratch& scratch
+){
+    scale_image_filtered(plan, in, in_bytes_per_row, out, out_bytes_per_row, scratch, ImageScaler_x64_AVX2());
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,76 @@
+/*  Image Scale (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImageScale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct ImageScaler_x64_SSE41{
+    static PA_FORCE_INLINE __m128 load_pixel(const uint32_t* pixel){
+        return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int*)pixel)));
+    }
+    static PA_FORCE_INLINE __m128 vertical_pixel(const float* const* rows, const float* weights, size_t taps, size_t c){
+        __m128 sum = _mm_setzero_ps();
+        for (size_t t = 0; t < taps; t++){
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(rows[t] + 4*c), _mm_set1_ps(weights[t])));
+        }
+        return sum;
+    }
+
+    void horizontal(float* out, const uint32_t* in, const ImageScaleAxis& axis) const{
+        size_t width = axis.first.size();
+        for (size_t c = 0; c < width; c++){
+            const uint32_t* src = in + axis.first[c];
+            const float* weight = axis.weights.data() + axis.offset[c];
+            size_t taps = axis.count[c];
+            __m128 sum = _mm_setzero_ps();
+            for (size_t t = 0; t < taps; t++){
+                sum = _mm_add_ps(sum, _mm_mul_ps(load_pixel(src + t), _mm_set1_ps(weight[t])));
+            }
+            _mm_storeu_ps(out, sum);
+            out += 4;
+        }
+    }
+    void vertical(uint32_t* out, size_t width, const float* const* rows, const float* weights, size_t taps) const{
+        size_t c = 0;
+        for (; c + 4 <= width; c += 4){
+            __m128i p0 = _mm_cvtps_epi32(vertical_pixel(rows, weights, taps, c + 0));
+            __m128i p1 = _mm_cvtps_epi32(vertical_pixel(rows, weights, taps, c + 1));
+            __m128i p2 = _mm_cvtps_epi32(vertical_pixel(rows, weights, taps, c + 2));
+            __m128i p3 = _mm_cvtps_epi32(vertical_pixel(rows, weights, taps, c + 3));
+            p0 = _mm_packus_epi32(p0, p1);
+            p2 = _mm_packus_epi32(p2, p3);
+            _mm_storeu_si128((__m128i*)(out + c), _mm_packus_epi16(p0, p2));
+        }
+        for (; c < width; c++){
+            __m128i p = _mm_cvtps_epi32(vertical_pixel(rows, weights, taps, c));
+            p = _mm_packus_epi32(p, p);
+            out[c] = (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(p, p));
+        }
+    }
+};
+
+
+void scale_image_filtered_x64_SSE41(
+    const ImageScalePlan& plan,
+    const uint32_t* in, size_t in_bytes_per_row,
+    uint32_t* out, size_t out_bytes_per_row,
+    ImageScaleScratch& scratch
+){
+    scale_image_filtered(plan, in, in_bytes_per_row, out, out_bytes_per_row, scratch, ImageScaler_x64_SSE41());
+}
+
+
+
+}
+}
+#endif
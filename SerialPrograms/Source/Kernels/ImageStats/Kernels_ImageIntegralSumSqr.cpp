@@ -0,0 +1,65 @@
+/*  Image Integral Sum + Sum of Squares
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageIntegralSumSqr.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void build_integral_sum_sqr_Default(
+    uint32_t* sums, uint64_t* sqrs, size_t stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+void build_integral_sum_sqr_x64_SSE41(
+    uint32_t* sums, uint64_t* sqrs, size_t stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+void build_integral_sum_sqr_x64_AVX2(
+    uint32_t* sums, uint64_t* sqrs, size_t stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+
+
+void build_integral_sum_sqr(
+    uint32_t* sums, uint64_t* sqrs, size_t stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        build_integral_sum_sqr_x64_AVX2(
+            sums, sqrs, stride,
+            width, height,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        build_integral_sum_sqr_x64_SSE41(
+            sums, sqrs, stride,
+            width, height,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+    build_integral_sum_sqr_Default(
+        sums, sqrs, stride,
+        width, height,
+        image, bytes_per_row
+    );
+}
+
+
+}
+}
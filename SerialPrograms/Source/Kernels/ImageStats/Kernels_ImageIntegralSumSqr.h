@@ -0,0 +1,74 @@
+/*  Image Integral Sum + Sum of Squares
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Build a summed-area table of an image so that the pixel sums of any
+ *  rectangle can be looked up in constant time.
+ *
+ *  The table has (width + 1) x (height + 1) entries. The first row and column
+ *  are zero. Entry (x, y) holds the sums of all pixels in [0, x) x [0, y).
+ *
+ *  Like "pixel_sum_sqr()", pixels with alpha < 128 are ignored.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageIntegralSumSqr_H
+#define PokemonAutomation_Kernels_ImageIntegralSumSqr_H
+
+#include <stdint.h>
+#include <cstddef>
+#include "Kernels_ImagePixelSumSqr.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  "sums" is an array of 4 x uint32_t per entry: B, G, R, count
+//  "sqrs" is an array of 3 x uint64_t per entry: B, G, R
+//
+//  "stride" is the # of entries per row of the table. It must be >= width + 1.
+//
+//  The 32-bit sums wrap around. But since the rectangle lookups are done in
+//  modular arithmetic, they are exact as long as the rectangle has fewer than
+//  2^32 / 255 pixels.
+void build_integral_sum_sqr(
+    uint32_t* sums, uint64_t* sqrs, size_t stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+
+
+//  Look up the pixel sums of [x, x + width) x [y, y + height) in a table
+//  built by "build_integral_sum_sqr()". The result is added to "sums".
+inline void integral_sum_sqr_lookup(
+    PixelSums& sums,
+    const uint32_t* table_sums, const uint64_t* table_sqrs, size_t stride,
+    size_t x, size_t y, size_t width, size_t height
+){
+    size_t i00 = y * stride + x;
+    size_t i01 = i00 + width;
+    size_t i10 = i00 + height * stride;
+    size_t i11 = i10 + width;
+
+    const uint32_t* s00 = table_sums + 4 * i00;
+    const uint32_t* s01 = table_sums + 4 * i01;
+    const uint32_t* s10 = table_sums + 4 * i10;
+    const uint32_t* s11 = table_sums + 4 * i11;
+    sums.sumB  += (uint32_t)(s11[0] - s10[0] - s01[0] + s00[0]);
+    sums.sumG  += (uint32_t)(s11[1] - s10[1] - s01[1] + s00[1]);
+    sums.sumR  += (uint32_t)(s11[2] - s10[2] - s01[2] + s00[2]);
+    sums.count += (uint32_t)(s11[3] - s10[3] - s01[3] + s00[3]);
+
+    const uint64_t* q00 = table_sqrs + 3 * i00;
+    const uint64_t* q01 = table_sqrs + 3 * i01;
+    const uint64_t* q10 = table_sqrs + 3 * i10;
+    const uint64_t* q11 = table_sqrs + 3 * i11;
+    sums.sqrB += q11[0] - q10[0] - q01[0] + q00[0];
+    sums.sqrG += q11[1] - q10[1] - q01[1] + q00[1];
+    sums.sqrR += q11[2] - q10[2] - q01[2] + q00[2];
+}
+
+
+}
+}
+#endif
@@ -0,0 +1,83 @@
+/*  Image Integral Sum + Sum of Squares (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImageIntegralSumSqr.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE void build_integral_sum_sqr_row_Default(
+    uint32_t* sums, uint64_t* sqrs,
+    const uint32_t* prev_sums, const uint64_t* prev_sqrs,
+    size_t width, const uint32_t* image
+){
+    uint32_t sumB = 0;
+    uint32_t sumG = 0;
+    uint32_t sumR = 0;
+    uint32_t sumA = 0;
+    uint64_t sqrB = 0;
+    uint64_t sqrG = 0;
+    uint64_t sqrR = 0;
+
+    memset(sums, 0, 4 * sizeof(uint32_t));
+    memset(sqrs, 0, 3 * sizeof(uint64_t));
+
+    for (size_t c = 0; c < width; c++){
+        uint32_t p = image[c];
+        p &= (uint32_t)((int32_t)p >> 31);
+
+        uint32_t r0 = p & 0x000000ff;
+        uint32_t r1 = (p >>  8) & 0x000000ff;
+        uint32_t r2 = (p >> 16) & 0x000000ff;
+        uint32_t r3 = p >> 31;
+
+        sumB += r0;
+        sumG += r1;
+        sumR += r2;
+        sumA += r3;
+        sqrB += r0 * r0;
+        sqrG += r1 * r1;
+        sqrR += r2 * r2;
+
+        uint32_t* s = sums + 4 * (c + 1);
+        const uint32_t* ps = prev_sums + 4 * (c + 1);
+        s[0] = ps[0] + sumB;
+        s[1] = ps[1] + sumG;
+        s[2] = ps[2] + sumR;
+        s[3] = ps[3] + sumA;
+
+        uint64_t* q = sqrs + 3 * (c + 1);
+        const uint64_t* pq = prev_sqrs + 3 * (c + 1);
+        q[0] = pq[0] + sqrB;
+        q[1] = pq[1] + sqrG;
+        q[2] = pq[2] + sqrR;
+    }
+}
+void build_integral_sum_sqr_Default(
+    uint32_t* sums, uint64_t* sqrs, size_t stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+    memset(sums, 0, 4 * sizeof(uint32_t) * (width + 1));
+    memset(sqrs, 0, 3 * sizeof(uint64_t) * (width + 1));
+    for (size_t r = 0; r < height; r++){
+        build_integral_sum_sqr_row_Default(
+            sums + 4 * stride, sqrs + 3 * stride,
+            sums, sqrs,
+            width, image
+        );
+        sums += 4 * stride;
+        sqrs += 3 * stride;
+        image = (const uint32_t*)((const char*)image + bytes_per_row);
+    }
+}
+
+
+}
+}
@@ -0,0 +1,74 @@
+/*  Image Integral Sum + Sum of Squares (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <string.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImageIntegralSumSqr.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Same as the SSE4.1 version, but all 3 squared channels fit in one vector.
+PA_FORCE_INLINE void build_integral_sum_sqr_row_x64_AVX2(
+    uint32_t* sums, uint64_t* sqrs,
+    const uint32_t* prev_sums, const uint64_t* prev_sqrs,
+    size_t width, const uint32_t* image
+){
+    const __m256i mask = _mm256_setr_epi64x(-1, -1, -1, 0);
+
+    __m128i sum = _mm_setzero_si128();
+    __m256i sqr = _mm256_setzero_si256();
+
+    memset(sums, 0, 4 * sizeof(uint32_t));
+    memset(sqrs, 0, 3 * sizeof(uint64_t));
+
+    for (size_t c = 0; c < width; c++){
+        uint32_t p = image[c];
+        p &= (uint32_t)((int32_t)p >> 31);
+        p = (p & 0x00ffffff) | ((p >> 31) << 24);
+
+        __m128i v = _mm_cvtepu8_epi32(_mm_cvtsi32_si128((int)p));
+        sum = _mm_add_epi32(sum, v);
+
+        __m128i* s = (__m128i*)(sums + 4 * (c + 1));
+        const __m128i* ps = (const __m128i*)(prev_sums + 4 * (c + 1));
+        _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(ps), sum));
+
+        v = _mm_mullo_epi32(v, v);
+        sqr = _mm256_add_epi64(sqr, _mm256_cvtepu32_epi64(v));
+
+        long long* q = (long long*)(sqrs + 3 * (c + 1));
+        const long long* pq = (const long long*)(prev_sqrs + 3 * (c + 1));
+        _mm256_maskstore_epi64(q, mask, _mm256_add_epi64(_mm256_maskload_epi64(pq, mask), sqr));
+    }
+}
+void build_integral_sum_sqr_x64_AVX2(
+    uint32_t* sums, uint64_t* sqrs, size_t stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+    memset(sums, 0, 4 * sizeof(uint32_t) * (width + 1));
+    memset(sqrs, 0, 3 * sizeof(uint64_t) * (width + 1));
+    for (size_t r = 0; r < height; r++){
+        build_integral_sum_sqr_row_x64_AVX2(
+            sums + 4 * stride, sqrs + 3 * stride,
+            sums, sqrs,
+            width, image
+        );
+        sums += 4 * stride;
+        sqrs += 3 * stride;
+        image = (const uint32_t*)((const char*)image + bytes_per_row);
+    }
+}
+
+
+}
+}
+#endif
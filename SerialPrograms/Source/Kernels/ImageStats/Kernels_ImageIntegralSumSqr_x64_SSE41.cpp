@@ -0,0 +1,76 @@
+/*  Image Integral Sum + Sum of Squares (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <string.h>
+#include <smmintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImageIntegralSumSqr.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  The prefix sum along a row is inherently serial. So instead of vectorizing
+//  across pixels, we vectorize across the channels of each pixel.
+PA_FORCE_INLINE void build_integral_sum_sqr_row_x64_SSE41(
+    uint32_t* sums, uint64_t* sqrs,
+    const uint32_t* prev_sums, const uint64_t* prev_sqrs,
+    size_t width, const uint32_t* image
+){
+    __m128i sum = _mm_setzero_si128();
+    __m128i sqrBG = _mm_setzero_si128();
+    __m128i sqrR = _mm_setzero_si128();
+
+    memset(sums, 0, 4 * sizeof(uint32_t));
+    memset(sqrs, 0, 3 * sizeof(uint64_t));
+
+    for (size_t c = 0; c < width; c++){
+        uint32_t p = image[c];
+        p &= (uint32_t)((int32_t)p >> 31);
+        p = (p & 0x00ffffff) | ((p >> 31) << 24);
+
+        __m128i v = _mm_cvtepu8_epi32(_mm_cvtsi32_si128((int)p));
+        sum = _mm_add_epi32(sum, v);
+
+        __m128i* s = (__m128i*)(sums + 4 * (c + 1));
+        const __m128i* ps = (const __m128i*)(prev_sums + 4 * (c + 1));
+        _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(ps), sum));
+
+        v = _mm_mullo_epi32(v, v);
+        sqrBG = _mm_add_epi64(sqrBG, _mm_cvtepu32_epi64(v));
+        sqrR = _mm_add_epi64(sqrR, _mm_cvtepu32_epi64(_mm_unpackhi_epi64(v, v)));
+
+        uint64_t* q = sqrs + 3 * (c + 1);
+        const uint64_t* pq = prev_sqrs + 3 * (c + 1);
+        _mm_storeu_si128((__m128i*)q, _mm_add_epi64(_mm_loadu_si128((const __m128i*)pq), sqrBG));
+        _mm_storel_epi64((__m128i*)(q + 2), _mm_add_epi64(_mm_loadl_epi64((const __m128i*)(pq + 2)), sqrR));
+    }
+}
+void build_integral_sum_sqr_x64_SSE41(
+    uint32_t* sums, uint64_t* sqrs, size_t stride,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+    memset(sums, 0, 4 * sizeof(uint32_t) * (width + 1));
+    memset(sqrs, 0, 3 * sizeof(uint64_t) * (width + 1));
+    for (size_t r = 0; r < height; r++){
+        build_integral_sum_sqr_row_x64_SSE41(
+            sums + 4 * stride, sqrs + 3 * stride,
+            sums, sqrs,
+            width, image
+        );
+        sums += 4 * stride;
+        sqrs += 3 * stride;
+        image = (const uint32_t*)((const char*)image + bytes_per_row);
+    }
+}
+
+
+}
+}
+#endif
@@ -0,0 +1,93 @@
+/*  Sum of Squares of Deviation (Scaled Reference)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImagePixelSumSqrDevScaled.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+bool sum_sqr_deviation_scaled_Default(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB,
+    uint64_t max_sumsqrs
+);
+bool sum_sqr_deviation_scaled_x64_SSE41(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB,
+    uint64_t max_sumsqrs
+);
+bool sum_sqr_deviation_scaled_x64_AVX2(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB,
+    uint64_t max_sumsqrs
+);
+
+
+//  Each variant rounds the scaled reference the same way as the
+//  "scale_brightness()" variant for the same CPU.
+bool sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB,
+    uint64_t max_sumsqrs
+){
+    if (width == 0 || height == 0){
+        return true;
+    }
+    scaleR = std::max(scaleR, 0.0f);
+    scaleG = std::max(scaleG, 0.0f);
+    scaleB = std::max(scaleB, 0.0f);
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return sum_sqr_deviation_scaled_x64_AVX2(
+            count, sumsqrs,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            scaleR, scaleG, scaleB,
+            max_sumsqrs
+        );
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        return sum_sqr_deviation_scaled_x64_SSE41(
+            count, sumsqrs,
+            width, height,
+            ref, ref_bytes_per_line,
+            img, img_bytes_per_line,
+            scaleR, scaleG, scaleB,
+            max_sumsqrs
+        );
+    }
+#endif
+    return sum_sqr_deviation_scaled_Default(
+        count, sumsqrs,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        scaleR, scaleG, scaleB,
+        max_sumsqrs
+    );
+}
+
+
+}
+}
@@ -0,0 +1,41 @@
+/*  Sum of Squares of Deviation (Scaled Reference)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImagePixelSumSqrDevScaled_H
+#define PokemonAutomation_Kernels_ImagePixelSumSqrDevScaled_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//
+//  Same as "sum_sqr_deviation()", but the RGB channels of "ref" are first
+//  multiplied by "scaleR/G/B" the same way "scale_brightness()" does it.
+//  This gives the same result as scaling a copy of "ref" and then calling
+//  "sum_sqr_deviation()", but without the copy.
+//
+//  Rows are processed in order. If "sumsqrs" exceeds "max_sumsqrs" at the end
+//  of a row, the remaining rows are skipped and this returns false.
+//
+//  count   = # of non-zero alpha pixels in "ref".
+//  sumsqrs = Sum of squares of differences between scaled "ref" and "img".
+//
+bool sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB,
+    uint64_t max_sumsqrs
+);
+
+
+}
+}
+#endif
@@ -0,0 +1,74 @@
+/*  Sum of Squares of Deviation (Scaled Reference) (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdint.h>
+#include <algorithm>
+#include "Common/Compiler.h"
+#include "Kernels_ImagePixelSumSqrDevScaled.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE int32_t scale_channel_Default(uint32_t x, float scale){
+    return (int32_t)std::min((uint32_t)((float)x * scale), (uint32_t)255);
+}
+PA_FORCE_INLINE void sum_sqr_deviation_scaled_Default(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width,
+    const uint32_t* ref, const uint32_t* img,
+    float scaleR, float scaleG, float scaleB
+){
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    for (size_t c = 0; c < width; c++){
+        uint32_t r = ref[c];
+        uint32_t i = img[c];
+
+        uint32_t alphaR = (int32_t)r >> 31;
+
+        int32_t r0 = scale_channel_Default(r & 0x000000ff, scaleB);
+        int32_t r1 = scale_channel_Default((r >> 8) & 0x000000ff, scaleG);
+        int32_t r2 = scale_channel_Default((r >> 16) & 0x000000ff, scaleR);
+
+        r0 -= (int32_t)(i & 0x000000ff);
+        r1 -= (int32_t)((i >> 8) & 0x000000ff);
+        r2 -= (int32_t)((i >> 16) & 0x000000ff);
+
+        uint32_t dev = (uint32_t)(r0 * r0 + r1 * r1 + r2 * r2);
+
+        total -= (int32_t)alphaR;
+        sum += dev & alphaR;
+    }
+    count += total;
+    sumsqrs += sum;
+}
+bool sum_sqr_deviation_scaled_Default(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB,
+    uint64_t max_sumsqrs
+){
+    for (size_t r = 0; r < height; r++){
+        sum_sqr_deviation_scaled_Default(
+            count, sumsqrs,
+            width, ref, img,
+            scaleR, scaleG, scaleB
+        );
+        if (sumsqrs > max_sumsqrs){
+            return false;
+        }
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+    return true;
+}
+
+
+}
+}
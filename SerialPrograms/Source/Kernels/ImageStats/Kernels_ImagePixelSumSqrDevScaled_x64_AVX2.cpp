@@ -0,0 +1,123 @@
+/*  Sum of Squares of Deviation (Scaled Reference) (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels/Kernels_x64_AVX2.h"
+#include "Kernels_ImagePixelSumSqrDevScaled.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Matches the rounding of "scale_brightness_x64_AVX2()".
+PA_FORCE_INLINE __m256i scale_channel_x64_AVX2(__m256i x, __m256 scale){
+    __m256 f = _mm256_cvtepi32_ps(x);
+    f = _mm256_mul_ps(f, scale);
+    f = _mm256_min_ps(f, _mm256_set1_ps(255.));
+    f = _mm256_max_ps(f, _mm256_set1_ps(0.));
+    return _mm256_cvtps_epi32(f);
+}
+PA_FORCE_INLINE void sum_sqr_deviation_scaled_x64_AVX2(
+    __m256i& total, __m256i& sum,
+    __m256i r, __m256i i,
+    __m256 scaleR, __m256 scaleG, __m256 scaleB
+){
+    const __m256i MASK = _mm256_set1_epi32(0x000000ff);
+    __m256i alphaR = _mm256_srai_epi32(r, 31);
+
+    __m256i r0 = scale_channel_x64_AVX2(_mm256_and_si256(r, MASK), scaleB);
+    __m256i r1 = scale_channel_x64_AVX2(_mm256_and_si256(_mm256_srli_epi32(r, 8), MASK), scaleG);
+    __m256i r2 = scale_channel_x64_AVX2(_mm256_and_si256(_mm256_srli_epi32(r, 16), MASK), scaleR);
+
+    r0 = _mm256_sub_epi32(r0, _mm256_and_si256(i, MASK));
+    r1 = _mm256_sub_epi32(r1, _mm256_and_si256(_mm256_srli_epi32(i, 8), MASK));
+    r2 = _mm256_sub_epi32(r2, _mm256_and_si256(_mm256_srli_epi32(i, 16), MASK));
+
+    //  All differences fit in 16 bits. Pack B and G into the two halves of
+    //  each 32-bit lane so that a single madd squares and adds them.
+    r0 = _mm256_blend_epi16(r0, _mm256_slli_epi32(r1, 16), 0xaa);
+    r2 = _mm256_blend_epi16(r2, _mm256_setzero_si256(), 0xaa);
+    r0 = _mm256_madd_epi16(r0, r0);
+    r2 = _mm256_madd_epi16(r2, r2);
+    r0 = _mm256_add_epi32(r0, r2);
+
+    total = _mm256_sub_epi32(total, alphaR);
+    sum = _mm256_add_epi32(sum, _mm256_and_si256(r0, alphaR));
+}
+PA_FORCE_INLINE void sum_sqr_deviation_scaled_x64_AVX2(
+    uint64_t& count, uint64_t& sumsqrs,
+    uint16_t width,
+    const uint32_t* ref, const uint32_t* img,
+    __m256 scaleR, __m256 scaleG, __m256 scaleB
+){
+    __m256i total = _mm256_setzero_si256();
+    __m256i sum = _mm256_setzero_si256();
+
+    const __m256i* ptrR = (const __m256i*)ref;
+    const __m256i* ptrI = (const __m256i*)img;
+
+    size_t lc = width / 8;
+    while (lc--){
+        __m256i r = _mm256_loadu_si256(ptrR);
+        __m256i i = _mm256_loadu_si256(ptrI);
+        sum_sqr_deviation_scaled_x64_AVX2(total, sum, r, i, scaleR, scaleG, scaleB);
+        ptrR++;
+        ptrI++;
+    }
+
+    if (width % 8){
+        //  Masked-off pixels load as zero and have no alpha.
+        __m256i mask = _mm256_cmpgt_epi32(
+            _mm256_set1_epi32(width % 8),
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+        );
+        __m256i r = _mm256_maskload_epi32((const int*)ptrR, mask);
+        __m256i i = _mm256_maskload_epi32((const int*)ptrI, mask);
+        sum_sqr_deviation_scaled_x64_AVX2(total, sum, r, i, scaleR, scaleG, scaleB);
+    }
+
+    count += reduce_add32_x64_AVX2(total);
+    sumsqrs += reduce_add32_x64_AVX2(sum);
+}
+bool sum_sqr_deviation_scaled_x64_AVX2(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB,
+    uint64_t max_sumsqrs
+){
+    //  Narrow images are not sent to the default implementation since that
+    //  one rounds differently. The masked load handles them.
+    if (width > 22017){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    __m256 vscaleR = _mm256_set1_ps(scaleR);
+    __m256 vscaleG = _mm256_set1_ps(scaleG);
+    __m256 vscaleB = _mm256_set1_ps(scaleB);
+    for (size_t r = 0; r < height; r++){
+        sum_sqr_deviation_scaled_x64_AVX2(
+            count, sumsqrs,
+            (uint16_t)width, ref, img,
+            vscaleR, vscaleG, vscaleB
+        );
+        if (sumsqrs > max_sumsqrs){
+            return false;
+        }
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+    return true;
+}
+
+
+
+}
+}
+#endif
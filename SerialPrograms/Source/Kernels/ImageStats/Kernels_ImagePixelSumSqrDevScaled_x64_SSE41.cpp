@@ -0,0 +1,140 @@
+/*  Sum of Squares of Deviation (Scaled Reference) (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels/Kernels_x64_SSE41.h"
+#include "Kernels_ImagePixelSumSqrDevScaled.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Matches the rounding of "scale_brightness_x64_SSE41()".
+PA_FORCE_INLINE __m128i scale_channel_x64_SSE41(__m128i x, __m128 scale){
+    __m128 f = _mm_cvtepi32_ps(x);
+    f = _mm_mul_ps(f, scale);
+    f = _mm_min_ps(f, _mm_set1_ps(255.));
+    f = _mm_max_ps(f, _mm_set1_ps(0.));
+    return _mm_cvtps_epi32(f);
+}
+PA_FORCE_INLINE void sum_sqr_deviation_scaled_x64_SSE41(
+    __m128i& total, __m128i& sum,
+    __m128i r, __m128i i,
+    __m128 scaleR, __m128 scaleG, __m128 scaleB
+){
+    const __m128i MASK = _mm_set1_epi32(0x000000ff);
+    __m128i alphaR = _mm_srai_epi32(r, 31);
+
+    __m128i r0 = scale_channel_x64_SSE41(_mm_and_si128(r, MASK), scaleB);
+    __m128i r1 = scale_channel_x64_SSE41(_mm_and_si128(_mm_srli_epi32(r, 8), MASK), scaleG);
+    __m128i r2 = scale_channel_x64_SSE41(_mm_and_si128(_mm_srli_epi32(r, 16), MASK), scaleR);
+
+    r0 = _mm_sub_epi32(r0, _mm_and_si128(i, MASK));
+    r1 = _mm_sub_epi32(r1, _mm_and_si128(_mm_srli_epi32(i, 8), MASK));
+    r2 = _mm_sub_epi32(r2, _mm_and_si128(_mm_srli_epi32(i, 16), MASK));
+
+    //  All differences fit in 16 bits. Pack B and G into the two halves of
+    //  each 32-bit lane so that a single madd squares and adds them.
+    r0 = _mm_blend_epi16(r0, _mm_slli_epi32(r1, 16), 0xaa);
+    r2 = _mm_blend_epi16(r2, _mm_setzero_si128(), 0xaa);
+    r0 = _mm_madd_epi16(r0, r0);
+    r2 = _mm_madd_epi16(r2, r2);
+    r0 = _mm_add_epi32(r0, r2);
+
+    total = _mm_sub_epi32(total, alphaR);
+    sum = _mm_add_epi32(sum, _mm_and_si128(r0, alphaR));
+}
+PA_FORCE_INLINE void sum_sqr_deviation_scaled_x64_SSE41(
+    uint64_t& count, uint64_t& sumsqrs,
+    uint16_t width,
+    const uint32_t* ref, const uint32_t* img,
+    __m128 scaleR, __m128 scaleG, __m128 scaleB
+){
+    __m128i total = _mm_setzero_si128();
+    __m128i sum = _mm_setzero_si128();
+
+    const __m128i* ptrR = (const __m128i*)ref;
+    const __m128i* ptrI = (const __m128i*)img;
+
+    size_t lc = width / 4;
+    while (lc--){
+        __m128i r = _mm_loadu_si128(ptrR);
+        __m128i i = _mm_loadu_si128(ptrI);
+        sum_sqr_deviation_scaled_x64_SSE41(total, sum, r, i, scaleR, scaleG, scaleB);
+        ptrR++;
+        ptrI++;
+    }
+
+    if (width < 4){
+        //  Too narrow for the overlapping load below.
+        alignas(16) uint32_t bufferR[4] = {};
+        alignas(16) uint32_t bufferI[4] = {};
+        for (size_t c = 0; c < width; c++){
+            bufferR[c] = ref[c];
+            bufferI[c] = img[c];
+        }
+        __m128i r = _mm_load_si128((const __m128i*)bufferR);
+        __m128i i = _mm_load_si128((const __m128i*)bufferI);
+        sum_sqr_deviation_scaled_x64_SSE41(total, sum, r, i, scaleR, scaleG, scaleB);
+    }else if (width % 4){
+        __m128i r = _mm_loadu_si128((const __m128i*)(ref + width - 4));
+        __m128i i = _mm_loadu_si128((const __m128i*)(img + width - 4));
+
+        uint8_t shift = (uint8_t)(ref + width - (const uint32_t*)ptrR);
+
+        //  Move the remaining pixels to the bottom and zero the rest.
+        //  Zero pixels have no alpha so they don't contribute.
+        __m128i s = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        s = _mm_add_epi8(s, _mm_set1_epi8(128 - 4*shift));
+
+        r = _mm_shuffle_epi8(r, s);
+        i = _mm_shuffle_epi8(i, s);
+
+        sum_sqr_deviation_scaled_x64_SSE41(total, sum, r, i, scaleR, scaleG, scaleB);
+    }
+
+    count += reduce32_x64_SSE41(total);
+    sumsqrs += reduce32_x64_SSE41(sum);
+}
+bool sum_sqr_deviation_scaled_x64_SSE41(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB,
+    uint64_t max_sumsqrs
+){
+    //  Narrow images are not sent to the default implementation since that
+    //  one rounds differently.
+    if (width > 22017){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
+    }
+    __m128 vscaleR = _mm_set1_ps(scaleR);
+    __m128 vscaleG = _mm_set1_ps(scaleG);
+    __m128 vscaleB = _mm_set1_ps(scaleB);
+    for (size_t r = 0; r < height; r++){
+        sum_sqr_deviation_scaled_x64_SSE41(
+            count, sumsqrs,
+            (uint16_t)width, ref, img,
+            vscaleR, vscaleG, vscaleB
+        );
+        if (sumsqrs > max_sumsqrs){
+            return false;
+        }
+        ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+        img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+    }
+    return true;
+}
+
+
+
+}
+}
+#endif
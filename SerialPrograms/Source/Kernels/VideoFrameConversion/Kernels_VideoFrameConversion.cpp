@@ -0,0 +1,159 @@
+/*  Video Frame Conversion
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_VideoFrameConversion.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+YuvToRgbCoefficients YuvToRgbCoefficients::make(bool bt709, bool full_range){
+    const double kr = bt709 ? 0.2126 : 0.299;
+    const double kb = bt709 ? 0.0722 : 0.114;
+    const double kg = 1 - kr - kb;
+
+    double y_scale = full_range ? 1.0 : 255. / 219;
+    double c_scale = full_range ? 1.0 : 255. / 224;
+
+    const double ONE = (double)(1 << YUV_TO_RGB_SHIFT);
+    YuvToRgbCoefficients ret;
+    ret.y_offset = full_range ? 0 : 16;
+    ret.y_scale = (int32_t)(y_scale * ONE + 0.5);
+    ret.v_to_r  = (int32_t)(c_scale * 2 * (1 - kr) * ONE + 0.5);
+    ret.u_to_g  = (int32_t)(c_scale * 2 * (1 - kb) * kb / kg * ONE + 0.5);
+    ret.v_to_g  = (int32_t)(c_scale * 2 * (1 - kr) * kr / kg * ONE + 0.5);
+    ret.u_to_b  = (int32_t)(c_scale * 2 * (1 - kb) * ONE + 0.5);
+    return ret;
+}
+
+
+
+void convert_NV12_to_rgb32_Default(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+);
+void convert_NV12_to_rgb32_x64_SSE41(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+);
+void convert_NV12_to_rgb32_x64_AVX2(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+);
+void convert_NV12_to_rgb32_x64_AVX512(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+);
+void convert_NV12_to_rgb32(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_NV12_to_rgb32_x64_AVX512(
+            y_plane, y_bytes_per_row, uv_plane, uv_bytes_per_row,
+            width, height, out, out_bytes_per_row, coefficients
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_NV12_to_rgb32_x64_AVX2(
+            y_plane, y_bytes_per_row, uv_plane, uv_bytes_per_row,
+            width, height, out, out_bytes_per_row, coefficients
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        convert_NV12_to_rgb32_x64_SSE41(
+            y_plane, y_bytes_per_row, uv_plane, uv_bytes_per_row,
+            width, height, out, out_bytes_per_row, coefficients
+        );
+        return;
+    }
+#endif
+    convert_NV12_to_rgb32_Default(
+        y_plane, y_bytes_per_row, uv_plane, uv_bytes_per_row,
+        width, height, out, out_bytes_per_row, coefficients
+    );
+}
+
+
+
+void convert_YUYV_to_rgb32_Default(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+);
+void convert_YUYV_to_rgb32_x64_SSE41(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+);
+void convert_YUYV_to_rgb32_x64_AVX2(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+);
+void convert_YUYV_to_rgb32_x64_AVX512(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+);
+void convert_YUYV_to_rgb32(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_YUYV_to_rgb32_x64_AVX512(in, in_bytes_per_row, width, height, out, out_bytes_per_row, coefficients);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_YUYV_to_rgb32_x64_AVX2(in, in_bytes_per_row, width, height, out, out_bytes_per_row, coefficients);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        convert_YUYV_to_rgb32_x64_SSE41(in, in_bytes_per_row, width, height, out, out_bytes_per_row, coefficients);
+        return;
+    }
+#endif
+    convert_YUYV_to_rgb32_Default(in, in_bytes_per_row, width, height, out, out_bytes_per_row, coefficients);
+}
+
+
+
+}
+}
@@ -0,0 +1,64 @@
+/*  Video Frame Conversion
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Convert raw YUV video frames from capture devices into RGB32 images.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_VideoFrameConversion_H
+#define PokemonAutomation_Kernels_VideoFrameConversion_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Fixed-point YUV -> RGB matrix. All multipliers have "YUV_TO_RGB_SHIFT" bits
+//  of fraction. U and V are centered on 128 before multiplying.
+//
+//      R = (Y - y_offset) * y_scale + (V - 128) * v_to_r
+//      G = (Y - y_offset) * y_scale - (U - 128) * u_to_g - (V - 128) * v_to_g
+//      B = (Y - y_offset) * y_scale + (U - 128) * u_to_b
+//
+const int YUV_TO_RGB_SHIFT = 14;
+struct YuvToRgbCoefficients{
+    int32_t y_offset;
+    int32_t y_scale;
+    int32_t v_to_r;
+    int32_t u_to_g;
+    int32_t v_to_g;
+    int32_t u_to_b;
+
+    //  If "bt709" is false, use BT.601.
+    //  If "full_range" is false, use the video range. (Y in [16, 235], UV in [16, 240])
+    static YuvToRgbCoefficients make(bool bt709, bool full_range);
+};
+
+
+
+//  NV12: A full resolution Y plane followed by a half resolution (both
+//  dimensions) plane of interleaved U and V samples.
+void convert_NV12_to_rgb32(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+);
+
+//  YUYV (YUY2): Packed 4:2:2. Each pair of pixels is stored as: Y0 U Y1 V
+void convert_YUYV_to_rgb32(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+);
+
+
+
+}
+}
+#endif
@@ -0,0 +1,65 @@
+/*  Video Frame Conversion (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdint.h>
+#include <cstddef>
+#include "Kernels_VideoFrameConversion_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class VideoFrameConverter_Default{
+public:
+    static const size_t VECTOR_SIZE = 2;
+
+public:
+    VideoFrameConverter_Default(const YuvToRgbCoefficients& coefficients)
+        : m_coefficients(coefficients)
+    {}
+
+    PA_FORCE_INLINE void NV12_full(uint32_t* out, const uint8_t* y, const uint8_t* uv) const{
+        out[0] = yuv_to_rgb32_pixel(m_coefficients, y[0], uv[0], uv[1]);
+        out[1] = yuv_to_rgb32_pixel(m_coefficients, y[1], uv[0], uv[1]);
+    }
+    PA_FORCE_INLINE void YUYV_full(uint32_t* out, const uint8_t* in) const{
+        out[0] = yuv_to_rgb32_pixel(m_coefficients, in[0], in[1], in[3]);
+        out[1] = yuv_to_rgb32_pixel(m_coefficients, in[2], in[1], in[3]);
+    }
+
+private:
+    const YuvToRgbCoefficients m_coefficients;
+};
+
+
+
+void convert_NV12_to_rgb32_Default(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+    convert_NV12_to_rgb32<VideoFrameConverter_Default>(
+        y_plane, y_bytes_per_row, uv_plane, uv_bytes_per_row,
+        width, height, out, out_bytes_per_row, coefficients
+    );
+}
+void convert_YUYV_to_rgb32_Default(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+    convert_YUYV_to_rgb32<VideoFrameConverter_Default>(
+        in, in_bytes_per_row, width, height, out, out_bytes_per_row, coefficients
+    );
+}
+
+
+
+}
+}
@@ -0,0 +1,109 @@
+/*  Video Frame Conversion Routines
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_VideoFrameConversion_Routines_H
+#define PokemonAutomation_Kernels_VideoFrameConversion_Routines_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include "Common/Compiler.h"
+#include "Kernels_VideoFrameConversion.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE uint32_t yuv_to_rgb32_pixel(
+    const YuvToRgbCoefficients& coefficients,
+    int32_t y, int32_t u, int32_t v
+){
+    const int32_t ROUND = 1 << (YUV_TO_RGB_SHIFT - 1);
+    y = (y - coefficients.y_offset) * coefficients.y_scale + ROUND;
+    u -= 128;
+    v -= 128;
+    int32_t r = (y + v * coefficients.v_to_r) >> YUV_TO_RGB_SHIFT;
+    int32_t g = (y - u * coefficients.u_to_g - v * coefficients.v_to_g) >> YUV_TO_RGB_SHIFT;
+    int32_t b = (y + u * coefficients.u_to_b) >> YUV_TO_RGB_SHIFT;
+    r = std::min(std::max(r, 0), 255);
+    g = std::min(std::max(g, 0), 255);
+    b = std::min(std::max(b, 0), 255);
+    return 0xff000000 | ((uint32_t)r << 16) | ((uint32_t)g << 8) | (uint32_t)b;
+}
+
+
+
+//  "Converter" processes "VECTOR_SIZE" pixels at a time. "VECTOR_SIZE" must be
+//  even so that each vector starts on a chroma boundary. The leftover pixels
+//  at the end of each row are done here one at a time.
+
+template <typename Converter>
+PA_FORCE_INLINE void convert_NV12_to_rgb32(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+    if (width == 0 || height == 0){
+        return;
+    }
+    Converter converter(coefficients);
+    const size_t VECTOR_SIZE = Converter::VECTOR_SIZE;
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* y = y_plane + r * y_bytes_per_row;
+        const uint8_t* uv = uv_plane + (r / 2) * uv_bytes_per_row;
+        size_t c = 0;
+        for (; c + VECTOR_SIZE <= width; c += VECTOR_SIZE){
+            converter.NV12_full(out + c, y + c, uv + c);
+        }
+        for (; c < width; c++){
+            size_t chroma = c & ~(size_t)1;
+            out[c] = yuv_to_rgb32_pixel(coefficients, y[c], uv[chroma], uv[chroma + 1]);
+        }
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+template <typename Converter>
+PA_FORCE_INLINE void convert_YUYV_to_rgb32(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+    if (width == 0 || height == 0){
+        return;
+    }
+    Converter converter(coefficients);
+    const size_t VECTOR_SIZE = Converter::VECTOR_SIZE;
+    do{
+        size_t c = 0;
+        for (; c + VECTOR_SIZE <= width; c += VECTOR_SIZE){
+            converter.YUYV_full(out + c, in + 2*c);
+        }
+        for (; c + 2 <= width; c += 2){
+            out[c + 0] = yuv_to_rgb32_pixel(coefficients, in[2*c + 0], in[2*c + 1], in[2*c + 3]);
+            out[c + 1] = yuv_to_rgb32_pixel(coefficients, in[2*c + 2], in[2*c + 1], in[2*c + 3]);
+        }
+        if (c < width){
+            //  Odd width: the last macropixel is cut off after its U byte.
+            //  Borrow V from the previous macropixel instead of reading past
+            //  the end of the row.
+            int32_t v = c >= 2 ? in[2*c - 1] : 128;
+            out[c] = yuv_to_rgb32_pixel(coefficients, in[2*c], in[2*c + 1], v);
+        }
+        in += in_bytes_per_row;
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }while (--height);
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,122 @@
+/*  Video Frame Conversion (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <stdint.h>
+#include <cstddef>
+#include <immintrin.h>
+#include "Kernels_VideoFrameConversion_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class VideoFrameConverter_x64_AVX2{
+public:
+    static const size_t VECTOR_SIZE = 8;
+
+public:
+    VideoFrameConverter_x64_AVX2(const YuvToRgbCoefficients& coefficients)
+        : m_y_offset(_mm256_set1_epi32(coefficients.y_offset))
+        , m_y_scale(_mm256_set1_epi32(coefficients.y_scale))
+        , m_v_to_r(_mm256_set1_epi32(coefficients.v_to_r))
+        , m_u_to_g(_mm256_set1_epi32(coefficients.u_to_g))
+        , m_v_to_g(_mm256_set1_epi32(coefficients.v_to_g))
+        , m_u_to_b(_mm256_set1_epi32(coefficients.u_to_b))
+    {}
+
+    PA_FORCE_INLINE void NV12_full(uint32_t* out, const uint8_t* y, const uint8_t* uv) const{
+        __m128i y8 = _mm_loadl_epi64((const __m128i*)y);
+        __m128i uv8 = _mm_loadl_epi64((const __m128i*)uv);
+        __m128i u = _mm_shuffle_epi8(uv8, _mm_setr_epi8(0, 0, 2, 2, 4, 4, 6, 6, -1, -1, -1, -1, -1, -1, -1, -1));
+        __m128i v = _mm_shuffle_epi8(uv8, _mm_setr_epi8(1, 1, 3, 3, 5, 5, 7, 7, -1, -1, -1, -1, -1, -1, -1, -1));
+        __m256i pixels = process_word(
+            _mm256_cvtepu8_epi32(y8),
+            _mm256_cvtepu8_epi32(u),
+            _mm256_cvtepu8_epi32(v)
+        );
+        _mm256_storeu_si256((__m256i*)out, pixels);
+    }
+    PA_FORCE_INLINE void YUYV_full(uint32_t* out, const uint8_t* in) const{
+        __m128i yuyv = _mm_loadu_si128((const __m128i*)in);
+        __m128i y = _mm_shuffle_epi8(yuyv, _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1));
+        __m128i u = _mm_shuffle_epi8(yuyv, _mm_setr_epi8(1, 1, 5, 5, 9, 9, 13, 13, -1, -1, -1, -1, -1, -1, -1, -1));
+        __m128i v = _mm_shuffle_epi8(yuyv, _mm_setr_epi8(3, 3, 7, 7, 11, 11, 15, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+        __m256i pixels = process_word(
+            _mm256_cvtepu8_epi32(y),
+            _mm256_cvtepu8_epi32(u),
+            _mm256_cvtepu8_epi32(v)
+        );
+        _mm256_storeu_si256((__m256i*)out, pixels);
+    }
+
+private:
+    //  Inputs are 8 x 32-bit lanes. Returns 8 packed BGRA pixels.
+    PA_FORCE_INLINE __m256i process_word(__m256i y, __m256i u, __m256i v) const{
+        y = _mm256_mullo_epi32(_mm256_sub_epi32(y, m_y_offset), m_y_scale);
+        y = _mm256_add_epi32(y, _mm256_set1_epi32(1 << (YUV_TO_RGB_SHIFT - 1)));
+        u = _mm256_sub_epi32(u, _mm256_set1_epi32(128));
+        v = _mm256_sub_epi32(v, _mm256_set1_epi32(128));
+
+        __m256i r = _mm256_add_epi32(y, _mm256_mullo_epi32(v, m_v_to_r));
+        __m256i g = _mm256_sub_epi32(y, _mm256_mullo_epi32(u, m_u_to_g));
+        g = _mm256_sub_epi32(g, _mm256_mullo_epi32(v, m_v_to_g));
+        __m256i b = _mm256_add_epi32(y, _mm256_mullo_epi32(u, m_u_to_b));
+        r = _mm256_srai_epi32(r, YUV_TO_RGB_SHIFT);
+        g = _mm256_srai_epi32(g, YUV_TO_RGB_SHIFT);
+        b = _mm256_srai_epi32(b, YUV_TO_RGB_SHIFT);
+
+        //  The packs and the shuffle stay within each 128-bit lane. So each
+        //  lane ends up with 4 consecutive pixels in the right order.
+        __m256i bg = _mm256_packs_epi32(b, g);
+        __m256i ra = _mm256_packs_epi32(r, _mm256_set1_epi32(255));
+        __m256i planar = _mm256_packus_epi16(bg, ra);
+        return _mm256_shuffle_epi8(planar, _mm256_setr_epi8(
+            0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+            0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15
+        ));
+    }
+
+private:
+    const __m256i m_y_offset;
+    const __m256i m_y_scale;
+    const __m256i m_v_to_r;
+    const __m256i m_u_to_g;
+    const __m256i m_v_to_g;
+    const __m256i m_u_to_b;
+};
+
+
+
+void convert_NV12_to_rgb32_x64_AVX2(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+    convert_NV12_to_rgb32<VideoFrameConverter_x64_AVX2>(
+        y_plane, y_bytes_per_row, uv_plane, uv_bytes_per_row,
+        width, height, out, out_bytes_per_row, coefficients
+    );
+}
+void convert_YUYV_to_rgb32_x64_AVX2(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+    convert_YUYV_to_rgb32<VideoFrameConverter_x64_AVX2>(
+        in, in_bytes_per_row, width, height, out, out_bytes_per_row, coefficients
+    );
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,124 @@
+/*  Video Frame Conversion (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <stdint.h>
+#include <cstddef>
+#include <immintrin.h>
+#include "Kernels_VideoFrameConversion_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class VideoFrameConverter_x64_AVX512{
+public:
+    static const size_t VECTOR_SIZE = 16;
+
+public:
+    VideoFrameConverter_x64_AVX512(const YuvToRgbCoefficients& coefficients)
+        : m_y_offset(_mm512_set1_epi32(coefficients.y_offset))
+        , m_y_scale(_mm512_set1_epi32(coefficients.y_scale))
+        , m_v_to_r(_mm512_set1_epi32(coefficients.v_to_r))
+        , m_u_to_g(_mm512_set1_epi32(coefficients.u_to_g))
+        , m_v_to_g(_mm512_set1_epi32(coefficients.v_to_g))
+        , m_u_to_b(_mm512_set1_epi32(coefficients.u_to_b))
+    {}
+
+    PA_FORCE_INLINE void NV12_full(uint32_t* out, const uint8_t* y, const uint8_t* uv) const{
+        __m128i y16 = _mm_loadu_si128((const __m128i*)y);
+        __m128i uv16 = _mm_loadu_si128((const __m128i*)uv);
+        __m128i u = _mm_shuffle_epi8(uv16, _mm_setr_epi8(0, 0, 2, 2, 4, 4, 6, 6, 8, 8, 10, 10, 12, 12, 14, 14));
+        __m128i v = _mm_shuffle_epi8(uv16, _mm_setr_epi8(1, 1, 3, 3, 5, 5, 7, 7, 9, 9, 11, 11, 13, 13, 15, 15));
+        __m512i pixels = process_word(
+            _mm512_cvtepu8_epi32(y16),
+            _mm512_cvtepu8_epi32(u),
+            _mm512_cvtepu8_epi32(v)
+        );
+        _mm512_storeu_si512(out, pixels);
+    }
+    PA_FORCE_INLINE void YUYV_full(uint32_t* out, const uint8_t* in) const{
+        __m128i lo = _mm_loadu_si128((const __m128i*)in + 0);
+        __m128i hi = _mm_loadu_si128((const __m128i*)in + 1);
+        const __m128i Y = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i U = _mm_setr_epi8(1, 1, 5, 5, 9, 9, 13, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i V = _mm_setr_epi8(3, 3, 7, 7, 11, 11, 15, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+        __m128i y = _mm_unpacklo_epi64(_mm_shuffle_epi8(lo, Y), _mm_shuffle_epi8(hi, Y));
+        __m128i u = _mm_unpacklo_epi64(_mm_shuffle_epi8(lo, U), _mm_shuffle_epi8(hi, U));
+        __m128i v = _mm_unpacklo_epi64(_mm_shuffle_epi8(lo, V), _mm_shuffle_epi8(hi, V));
+        __m512i pixels = process_word(
+            _mm512_cvtepu8_epi32(y),
+            _mm512_cvtepu8_epi32(u),
+            _mm512_cvtepu8_epi32(v)
+        );
+        _mm512_storeu_si512(out, pixels);
+    }
+
+private:
+    //  Inputs are 16 x 32-bit lanes. Returns 16 packed BGRA pixels.
+    PA_FORCE_INLINE __m512i process_word(__m512i y, __m512i u, __m512i v) const{
+        y = _mm512_mullo_epi32(_mm512_sub_epi32(y, m_y_offset), m_y_scale);
+        y = _mm512_add_epi32(y, _mm512_set1_epi32(1 << (YUV_TO_RGB_SHIFT - 1)));
+        u = _mm512_sub_epi32(u, _mm512_set1_epi32(128));
+        v = _mm512_sub_epi32(v, _mm512_set1_epi32(128));
+
+        __m512i r = _mm512_add_epi32(y, _mm512_mullo_epi32(v, m_v_to_r));
+        __m512i g = _mm512_sub_epi32(y, _mm512_mullo_epi32(u, m_u_to_g));
+        g = _mm512_sub_epi32(g, _mm512_mullo_epi32(v, m_v_to_g));
+        __m512i b = _mm512_add_epi32(y, _mm512_mullo_epi32(u, m_u_to_b));
+        r = _mm512_srai_epi32(r, YUV_TO_RGB_SHIFT);
+        g = _mm512_srai_epi32(g, YUV_TO_RGB_SHIFT);
+        b = _mm512_srai_epi32(b, YUV_TO_RGB_SHIFT);
+
+        //  Same as AVX2. Everything stays within 128-bit lanes.
+        __m512i bg = _mm512_packs_epi32(b, g);
+        __m512i ra = _mm512_packs_epi32(r, _mm512_set1_epi32(255));
+        __m512i planar = _mm512_packus_epi16(bg, ra);
+        return _mm512_shuffle_epi8(planar, _mm512_broadcast_i32x4(
+            _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15)
+        ));
+    }
+
+private:
+    const __m512i m_y_offset;
+    const __m512i m_y_scale;
+    const __m512i m_v_to_r;
+    const __m512i m_u_to_g;
+    const __m512i m_v_to_g;
+    const __m512i m_u_to_b;
+};
+
+
+
+void convert_NV12_to_rgb32_x64_AVX512(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+    convert_NV12_to_rgb32<VideoFrameConverter_x64_AVX512>(
+        y_plane, y_bytes_per_row, uv_plane, uv_bytes_per_row,
+        width, height, out, out_bytes_per_row, coefficients
+    );
+}
+void convert_YUYV_to_rgb32_x64_AVX512(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+    convert_YUYV_to_rgb32<VideoFrameConverter_x64_AVX512>(
+        in, in_bytes_per_row, width, height, out, out_bytes_per_row, coefficients
+    );
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,120 @@
+/*  Video Frame Conversion (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <stdint.h>
+#include <string.h>
+#include <cstddef>
+#include <smmintrin.h>
+#include "Kernels_VideoFrameConversion_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class VideoFrameConverter_x64_SSE41{
+public:
+    static const size_t VECTOR_SIZE = 4;
+
+public:
+    VideoFrameConverter_x64_SSE41(const YuvToRgbCoefficients& coefficients)
+        : m_y_offset(_mm_set1_epi32(coefficients.y_offset))
+        , m_y_scale(_mm_set1_epi32(coefficients.y_scale))
+        , m_v_to_r(_mm_set1_epi32(coefficients.v_to_r))
+        , m_u_to_g(_mm_set1_epi32(coefficients.u_to_g))
+        , m_v_to_g(_mm_set1_epi32(coefficients.v_to_g))
+        , m_u_to_b(_mm_set1_epi32(coefficients.u_to_b))
+    {}
+
+    PA_FORCE_INLINE void NV12_full(uint32_t* out, const uint8_t* y, const uint8_t* uv) const{
+        uint32_t y4, uv4;
+        memcpy(&y4, y, sizeof(uint32_t));
+        memcpy(&uv4, uv, sizeof(uint32_t));
+        __m128i u = _mm_shuffle_epi8(_mm_cvtsi32_si128(uv4), _mm_setr_epi8(0, 0, 2, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+        __m128i v = _mm_shuffle_epi8(_mm_cvtsi32_si128(uv4), _mm_setr_epi8(1, 1, 3, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+        __m128i pixels = process_word(
+            _mm_cvtepu8_epi32(_mm_cvtsi32_si128(y4)),
+            _mm_cvtepu8_epi32(u),
+            _mm_cvtepu8_epi32(v)
+        );
+        _mm_storeu_si128((__m128i*)out, pixels);
+    }
+    PA_FORCE_INLINE void YUYV_full(uint32_t* out, const uint8_t* in) const{
+        __m128i yuyv = _mm_loadl_epi64((const __m128i*)in);
+        __m128i y = _mm_shuffle_epi8(yuyv, _mm_setr_epi8(0, 2, 4, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+        __m128i u = _mm_shuffle_epi8(yuyv, _mm_setr_epi8(1, 1, 5, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+        __m128i v = _mm_shuffle_epi8(yuyv, _mm_setr_epi8(3, 3, 7, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+        __m128i pixels = process_word(
+            _mm_cvtepu8_epi32(y),
+            _mm_cvtepu8_epi32(u),
+            _mm_cvtepu8_epi32(v)
+        );
+        _mm_storeu_si128((__m128i*)out, pixels);
+    }
+
+private:
+    //  Inputs are 4 x 32-bit lanes. Returns 4 packed BGRA pixels.
+    PA_FORCE_INLINE __m128i process_word(__m128i y, __m128i u, __m128i v) const{
+        y = _mm_mullo_epi32(_mm_sub_epi32(y, m_y_offset), m_y_scale);
+        y = _mm_add_epi32(y, _mm_set1_epi32(1 << (YUV_TO_RGB_SHIFT - 1)));
+        u = _mm_sub_epi32(u, _mm_set1_epi32(128));
+        v = _mm_sub_epi32(v, _mm_set1_epi32(128));
+
+        __m128i r = _mm_add_epi32(y, _mm_mullo_epi32(v, m_v_to_r));
+        __m128i g = _mm_sub_epi32(y, _mm_mullo_epi32(u, m_u_to_g));
+        g = _mm_sub_epi32(g, _mm_mullo_epi32(v, m_v_to_g));
+        __m128i b = _mm_add_epi32(y, _mm_mullo_epi32(u, m_u_to_b));
+        r = _mm_srai_epi32(r, YUV_TO_RGB_SHIFT);
+        g = _mm_srai_epi32(g, YUV_TO_RGB_SHIFT);
+        b = _mm_srai_epi32(b, YUV_TO_RGB_SHIFT);
+
+        //  The saturating packs also clamp to [0, 255].
+        __m128i bg = _mm_packs_epi32(b, g);
+        __m128i ra = _mm_packs_epi32(r, _mm_set1_epi32(255));
+        __m128i planar = _mm_packus_epi16(bg, ra);
+        return _mm_shuffle_epi8(planar, _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15));
+    }
+
+private:
+    const __m128i m_y_offset;
+    const __m128i m_y_scale;
+    const __m128i m_v_to_r;
+    const __m128i m_u_to_g;
+    const __m128i m_v_to_g;
+    const __m128i m_u_to_b;
+};
+
+
+
+void convert_NV12_to_rgb32_x64_SSE41(
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+    convert_NV12_to_rgb32<VideoFrameConverter_x64_SSE41>(
+        y_plane, y_bytes_per_row, uv_plane, uv_bytes_per_row,
+        width, height, out, out_bytes_per_row, coefficients
+    );
+}
+void convert_YUYV_to_rgb32_x64_SSE41(
+    const uint8_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    const YuvToRgbCoefficients& coefficients
+){
+    convert_YUYV_to_rgb32<VideoFrameConverter_x64_SSE41>(
+        in, in_bytes_per_row, width, height, out, out_bytes_per_row, coefficients
+    );
+}
+
+
+
+}
+}
+#endif
@@ -12,6 +12,7 @@
 #include "Kernels_Waterfill_Types.h"
 
 namespace PokemonAutomation{
+    class AsyncDispatcher;
 namespace Kernels{
 namespace Waterfill{
 
@@ -20,6 +21,15 @@ namespace Waterfill{
 //  Find all the objects in the matrix. This will destroy "matrix".
 std::vector<WaterfillObject> find_objects_inplace(PackedBinaryMatrix_IB& matrix, size_t min_area);
 
+//  Same as above, but the matrix is split into horizontal bands that are
+//  processed in parallel on "dispatcher". Objects that cross between bands are
+//  merged afterwards. The output is identical to the serial version.
+//  Use this for large (full-frame) matrices.
+std::vector<WaterfillObject> find_objects_inplace(
+    AsyncDispatcher& dispatcher,
+    PackedBinaryMatrix_IB& matrix, size_t min_area
+);
+
 
 
 
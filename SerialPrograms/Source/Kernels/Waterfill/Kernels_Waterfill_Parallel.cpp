@@ -0,0 +1,200 @@
+/*  Waterfill Algorithm (Parallel)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Split the matrix into horizontal bands and run waterfill on each band
+ *  in parallel. Then stitch together the objects that cross the seams
+ *  between the bands.
+ *
+ *  To get the exact same output as the serial version:
+ *
+ *    - Each band is scanned in the same tile order as the serial version.
+ *      Bands are multiples of every tile height, so the scan order of all the
+ *      bands concatenated is the same as the scan order of the whole matrix.
+ *
+ *    - A merged object takes its "body_x/body_y" from its first part in that
+ *      order. That is the same bit the serial version would have started from.
+ *
+ *    - Merged objects are returned in the order of their first part.
+ *
+ */
+
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "Kernels/Algorithm/Kernels_Algorithm_DisjointSet.h"
+#include "Kernels_Waterfill_Session.h"
+#include "Kernels_Waterfill.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace Waterfill{
+
+
+//  Must be a multiple of the tallest tile.
+const size_t BAND_HEIGHT = 128;
+
+
+struct WaterfillBand{
+    size_t y_offset;
+    size_t height;
+    std::unique_ptr<PackedBinaryMatrix_IB> matrix;
+
+    //  All the objects in this band in scan order. Objects that can't
+    //  cross a seam and are too small are already dropped.
+    std::vector<WaterfillObject> objects;
+
+    //  For each bit of the first and last rows of the band, the index + 1 of
+    //  the object it belongs to. Zero if the bit isn't set.
+    std::vector<uint32_t> top;
+    std::vector<uint32_t> bottom;
+};
+
+
+//  "pending" is the list of set bits in "row" that haven't been assigned to
+//  an object yet. The object that was just removed from "matrix" owns every
+//  one of them that has now been cleared.
+void label_seam(
+    std::vector<uint32_t>& labels, std::vector<size_t>& pending,
+    const PackedBinaryMatrix_IB& matrix, size_t row,
+    const WaterfillObject& object, uint32_t label
+){
+    size_t c = 0;
+    while (c < pending.size()){
+        size_t x = pending[c];
+        if (object.min_x <= x && x < object.max_x && !matrix.get(x, row)){
+            labels[x] = label;
+            pending[c] = pending.back();
+            pending.pop_back();
+        }else{
+            c++;
+        }
+    }
+}
+std::vector<size_t> seam_bits(const PackedBinaryMatrix_IB& matrix, size_t row){
+    std::vector<size_t> ret;
+    for (size_t x = 0; x < matrix.width(); x++){
+        if (matrix.get(x, row)){
+            ret.emplace_back(x);
+        }
+    }
+    return ret;
+}
+
+
+void find_objects_in_band(WaterfillBand& band, bool is_first, bool is_last, size_t min_area){
+    PackedBinaryMatrix_IB& matrix = *band.matrix;
+    size_t width = matrix.width();
+    size_t last_row = band.height - 1;
+
+    std::vector<size_t> top_pending;
+    std::vector<size_t> bottom_pending;
+    if (!is_first){
+        band.top.resize(width);
+        top_pending = seam_bits(matrix, 0);
+    }
+    if (!is_last){
+        band.bottom.resize(width);
+        bottom_pending = seam_bits(matrix, last_row);
+    }
+
+    std::unique_ptr<WaterfillSession> session = make_WaterfillSession(matrix);
+    std::unique_ptr<WaterfillIterator> iter = session->make_iterator(0);
+    WaterfillObject object;
+    while (iter->find_next(object, false)){
+        bool on_top = !is_first && object.min_y == 0;
+        bool on_bottom = !is_last && object.max_y == band.height;
+        if (!on_top && !on_bottom && object.area < min_area){
+            continue;
+        }
+
+        uint32_t label = (uint32_t)band.objects.size() + 1;
+        if (on_top){
+            label_seam(band.top, top_pending, matrix, 0, object, label);
+        }
+        if (on_bottom){
+            label_seam(band.bottom, bottom_pending, matrix, last_row, object, label);
+        }
+
+        object.body_y += band.y_offset;
+        object.min_y += band.y_offset;
+        object.max_y += band.y_offset;
+        object.sum_y += (uint64_t)band.y_offset * object.area;
+        band.objects.emplace_back(std::move(object));
+    }
+}
+
+
+std::vector<WaterfillObject> find_objects_inplace(
+    AsyncDispatcher& dispatcher,
+    PackedBinaryMatrix_IB& matrix, size_t min_area
+){
+    size_t width = matrix.width();
+    size_t height = matrix.height();
+    if (height <= BAND_HEIGHT){
+        return find_objects_inplace(matrix, min_area);
+    }
+
+    std::vector<WaterfillBand> bands((height + BAND_HEIGHT - 1) / BAND_HEIGHT);
+    dispatcher.run_in_parallel(
+        0, bands.size(),
+        [&](size_t index){
+            WaterfillBand& band = bands[index];
+            band.y_offset = index * BAND_HEIGHT;
+            band.height = std::min(BAND_HEIGHT, height - band.y_offset);
+            band.matrix = matrix.submatrix(0, band.y_offset, width, band.height);
+            find_objects_in_band(band, index == 0, index + 1 == bands.size(), min_area);
+            band.matrix.reset();
+        }
+    );
+
+    //  Global index of the first object in each band.
+    std::vector<size_t> offsets(bands.size());
+    size_t total = 0;
+    for (size_t c = 0; c < bands.size(); c++){
+        offsets[c] = total;
+        total += bands[c].objects.size();
+    }
+
+    //  Merge everything that touches across a seam.
+    DisjointSet sets(total);
+    for (size_t c = 1; c < bands.size(); c++){
+        const std::vector<uint32_t>& above = bands[c - 1].bottom;
+        const std::vector<uint32_t>& below = bands[c].top;
+        for (size_t x = 0; x < width; x++){
+            if (above[x] != 0 && below[x] != 0){
+                sets.merge(offsets[c - 1] + above[x] - 1, offsets[c] + below[x] - 1);
+            }
+        }
+    }
+
+    //  Combine the parts in scan order.
+    std::vector<WaterfillObject> merged;
+    std::vector<size_t> slots(total, (size_t)0 - 1);
+    size_t index = 0;
+    for (WaterfillBand& band : bands){
+        for (WaterfillObject& part : band.objects){
+            size_t& slot = slots[sets.find(index++)];
+            if (slot == (size_t)0 - 1){
+                slot = merged.size();
+                merged.emplace_back(std::move(part));
+            }else{
+                merged[slot].merge_assume_no_overlap(part);
+            }
+        }
+    }
+
+    matrix.set_zero();
+
+    std::vector<WaterfillObject> ret;
+    for (WaterfillObject& object : merged){
+        if (object.area >= min_area){
+            ret.emplace_back(std::move(object));
+        }
+    }
+    return ret;
+}
+
+
+
+}
+}
+}
@@ -4,8 +4,11 @@
  *
  */
 
+#include "CommonFramework/Logging/FileWindowLogger.h"
 #include "CommonFramework/VideoPipeline/ThreadUtilizationStats.h"
+#include "CommonFramework/VideoPipeline/BufferPoolStats.h"
 #include "CommonFramework/VideoPipeline/Backends/CameraImplementations.h"
+#include "CommonFramework/OCR/OCR_ResultCache.h"
 #include "Integrations/ProgramTracker.h"
 #include "NintendoSwitch/NintendoSwitch_Settings.h"
 #include "NintendoSwitch_SwitchSystemOption.h"
@@ -22,6 +25,10 @@ namespace NintendoSwitch{
 
 SwitchSystemSession::~SwitchSystemSession(){
     ProgramTracker::instance().remove_console(m_console_id);
+    m_camera->remove_listener(*this);
+    m_overlay.remove_stat(*m_buffer_pool);
+    m_overlay.remove_stat(*m_ocr_cache);
+    m_overlay.remove_stat(*m_logger_backlog);
     m_overlay.remove_stat(*m_main_thread_utilization);
     m_option.m_camera.info = m_camera->current_device();
     m_option.m_camera.current_resolution = m_camera->current_resolution();
@@ -39,11 +46,18 @@ SwitchSystemSession::SwitchSystemSession(
     , m_audio(m_logger, option.m_audio)
     , m_overlay(option.m_overlay)
     , m_main_thread_utilization(new ThreadUtilizationStat(current_thread_handle(), "Main Qt Thread:"))
+    , m_logger_backlog(new LoggerBacklogStat())
+    , m_ocr_cache(new OCR::ResultCacheStat())
+    , m_buffer_pool(new BufferPoolStat())
 {
+    m_camera->add_listener(*this);
     m_camera->set_resolution(option.m_camera.current_resolution);
     m_camera->set_source(option.m_camera.info);
     m_console_id = ProgramTracker::instance().add_console(program_id, *this);
     m_overlay.add_stat(*m_main_thread_utilization);
+    m_overlay.add_stat(*m_logger_backlog);
+    m_overlay.add_stat(*m_ocr_cache);
+    m_overlay.add_stat(*m_buffer_pool);
 }
 
 void SwitchSystemSession::get(SwitchSystemOption& option){
@@ -63,6 +77,12 @@ void SwitchSystemSession::set(const SwitchSystemOption& option){
 void SwitchSystemSession::set_allow_user_commands(bool allow){
     m_serial.botbase().set_allow_user_commands(allow);
 }
+void SwitchSystemSession::recorded_audio(const std::string& file){
+    //  The camera is replaying a recording. Serve its audio through the
+    //  same audio feed that programs listen to.
+    m_logger.log("Playing recorded audio: " + file);
+    m_audio.set_audio_input(file);
+}
 
 
 
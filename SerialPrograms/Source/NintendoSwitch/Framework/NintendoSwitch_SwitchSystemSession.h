@@ -30,6 +30,11 @@
 
 namespace PokemonAutomation{
     class ThreadUtilizationStat;
+    class LoggerBacklogStat;
+    class BufferPoolStat;
+namespace OCR{
+    class ResultCacheStat;
+}
 namespace NintendoSwitch{
 
 class SwitchSystemOption;
@@ -37,7 +42,7 @@ class SwitchSystemOption;
 
 
 
-class SwitchSystemSession final : public TrackableConsole{
+class SwitchSystemSession final : public TrackableConsole, private CameraSession::Listener{
 public:
     ~SwitchSystemSession();
     SwitchSystemSession(
@@ -69,6 +74,12 @@ public:
 public:
     void set_allow_user_commands(bool allow);
 
+private:
+    virtual void shutdown() override{}
+    virtual void new_source(const CameraInfo& device, Resolution resolution) override{}
+    virtual void resolution_change(Resolution resolution) override{}
+    virtual void recorded_audio(const std::string& file) override;
+
 private:
     //  The console # within a program.
     const size_t m_console_number;
@@ -85,6 +96,9 @@ private:
     VideoOverlaySession m_overlay;
 
     std::unique_ptr<ThreadUtilizationStat> m_main_thread_utilization;
+    std::unique_ptr<LoggerBacklogStat> m_logger_backlog;
+    std::unique_ptr<OCR::ResultCacheStat> m_ocr_cache;
+    std::unique_ptr<BufferPoolStat> m_buffer_pool;
 };
 
 
@@ -15,6 +15,7 @@
 #include "CommonFramework/Tools/ConsoleHandle.h"
 #include "CommonFramework/OCR/OCR_RawOCR.h"
 #include "CommonFramework/OCR/OCR_NumberReader.h"
+#include "CommonFramework/OCR/OCR_GlyphClassifier.h"
 #include "CommonFramework/OCR/OCR_StringNormalization.h"
 #include "NintendoSwitch/Commands/NintendoSwitch_Commands_PushButtons.h"
 #include "NintendoSwitch_DateReader.h"
@@ -27,6 +28,13 @@ namespace PokemonAutomation{
 namespace NintendoSwitch{
 
 
+//  Digits in the Switch system font.
+OCR::GlyphClassifier& DATE_GLYPHS(){
+    static OCR::GlyphClassifier glyphs;
+    return glyphs;
+}
+
+
 DateReader::DateReader()
     : m_background_top(0.50, 0.02, 0.45, 0.08)
     , m_window_top(0.50, 0.36, 0.45, 0.07)
@@ -102,7 +110,7 @@ int8_t DateReader::read_hours(Logger& logger, const ImageViewRGB32& screen) cons
     bool format_us = stddev > 30;
     if (format_us){
         ImageRGB32 us_hours_filtered = to_blackwhite_rgb32_range(us_hours, 0xff000000, 0xff7f7f7f, white_theme);
-        int hours = OCR::read_number(logger, us_hours_filtered);
+        int hours = OCR::read_number(logger, us_hours_filtered, DATE_GLYPHS());
         if (hours < 1 || hours > 12){
             return -1;
         }
@@ -125,7 +133,7 @@ int8_t DateReader::read_hours(Logger& logger, const ImageViewRGB32& screen) cons
     }else{
         ImageViewRGB32 h24_hours = extract_box_reference(screen, m_24_hours);
         ImageRGB32 h24_hours_filtered = to_blackwhite_rgb32_range(h24_hours, 0xff000000, 0xff7f7f7f, white_theme);
-        int hours = OCR::read_number(logger, h24_hours_filtered);
+        int hours = OCR::read_number(logger, h24_hours_filtered, DATE_GLYPHS());
         if (hours < 0 || hours > 23){
             return -1;
         }
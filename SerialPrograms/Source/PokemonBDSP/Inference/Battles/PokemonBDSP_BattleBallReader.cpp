@@ -8,6 +8,7 @@
 #include "CommonFramework/ImageTools/ImageFilter.h"
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/OCR/OCR_NumberReader.h"
+#include "CommonFramework/OCR/OCR_GlyphClassifier.h"
 #include "CommonFramework/Tools/ErrorDumper.h"
 #include "PokemonBDSP/Inference/PokemonBDSP_PokeballSpriteMatcher.h"
 #include "PokemonBDSP_BattleBallReader.h"
@@ -25,6 +26,10 @@ const PokeballSpriteMatcher& BALL_SPRITE_MATCHER(){
     static PokeballSpriteMatcher matcher;
     return matcher;
 }
+OCR::GlyphClassifier& BALL_QUANTITY_GLYPHS(){
+    static OCR::GlyphClassifier glyphs;
+    return glyphs;
+}
 
 
 
@@ -108,7 +113,7 @@ uint16_t BattleBallReader::read_quantity(const ImageViewRGB32& screen) const{
         extract_box_reference(screen, m_box_quantity),
         0xff808080, 0xffffffff, true
     );
-    int qty = OCR::read_number(m_console, image);
+    int qty = OCR::read_number(m_console, image, BALL_QUANTITY_GLYPHS());
     return (uint16_t)std::max(qty, 0);
 }
 
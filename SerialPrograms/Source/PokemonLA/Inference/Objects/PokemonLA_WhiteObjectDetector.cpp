@@ -9,6 +9,7 @@
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
+#include "CommonFramework/ImageTools/WaterfillUtilities.h"
 #include "CommonFramework/ImageMatch/SubObjectTemplateMatcher.h"
 #include "PokemonLA_WhiteObjectDetector.h"
 
@@ -48,14 +49,13 @@ void find_overworld_white_objects(
         std::vector<PackedBinaryMatrix> matrix = compress_rgb32_to_binary_range(image, filters);
 
 #if 1
-        std::unique_ptr<WaterfillSession> session = make_WaterfillSession();
+        //  These are full-frame matrices. Split each of them into bands and
+        //  waterfill the bands in parallel.
         for (size_t c = 0; c < filters.size(); c++){
 //            cout << matrix[c].width() << " x " << matrix[c].height() << endl;
 //            cout << matrix[c].dump() << endl;
-            session->set_source(matrix[c]);
-            auto finder = session->make_iterator(50);
-            WaterfillObject object;
-            while (finder->find_next(object, false)){
+            std::vector<WaterfillObject> objects = find_objects_inplace_parallel(matrix[c], 50);
+            for (const WaterfillObject& object : objects){
 //                cout << object.area << endl;
                 for (const auto& detector : detectors){
                     const std::set<Color>& thresholds = detector.first.thresholds();
@@ -8,6 +8,7 @@
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTools/ImageFilter.h"
 #include "CommonFramework/OCR/OCR_NumberReader.h"
+#include "CommonFramework/OCR/OCR_GlyphClassifier.h"
 #include "CommonFramework/Tools/ErrorDumper.h"
 #include "PokemonSV_BattleBallReader.h"
 
@@ -16,6 +17,13 @@ namespace NintendoSwitch{
 namespace PokemonSV{
 
 
+OCR::GlyphClassifier& BALL_QUANTITY_GLYPHS(){
+    static OCR::GlyphClassifier glyphs;
+    return glyphs;
+}
+
+
+
 BattleBallReader::BattleBallReader(ConsoleHandle& console, Language language, Color color)
     : m_name_reader(PokeballNameReader::instance())
     , m_language(language)
@@ -59,7 +67,7 @@ uint16_t BattleBallReader::read_quantity(const ImageViewRGB32& screen) const{
         extract_box_reference(screen, m_quantity),
         0xff000000, 0xff7f7f7f, true
     );
-    int qty = OCR::read_number(m_console, image);
+    int qty = OCR::read_number(m_console, image, BALL_QUANTITY_GLYPHS());
     return (uint16_t)std::max(qty, 0);
 }
 
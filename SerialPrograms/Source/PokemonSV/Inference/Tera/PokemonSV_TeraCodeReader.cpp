@@ -14,6 +14,7 @@
 #include "CommonFramework/ImageTools/ImageManip.h"
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
 #include "CommonFramework/OCR/OCR_RawOCR.h"
+#include "CommonFramework/OCR/OCR_GlyphClassifier.h"
 #include "PokemonSV_TeraCodeReader.h"
 
 //#include <iostream>
@@ -60,15 +61,28 @@ struct WaterfillOCRResult{
 };
 
 
+OCR::GlyphClassifier& RAID_TIMER_GLYPHS(){
+    static OCR::GlyphClassifier glyphs;
+    return glyphs;
+}
+OCR::GlyphClassifier& RAID_CODE_GLYPHS(){
+    static OCR::GlyphClassifier glyphs;
+    return glyphs;
+}
+
+
 std::vector<WaterfillOCRResult> waterfill_OCR(
     AsyncDispatcher& dispatcher,
     const ImageViewRGB32& image,
-    uint32_t threshold
+    uint32_t threshold,
+    OCR::GlyphClassifier& glyphs
 ){
     using namespace Kernels::Waterfill;
 
     //  Direct OCR is unreliable. Instead, we will waterfill each character
     //  to isolate them, then OCR them individually.
+    //
+    //  Characters that "glyphs" already knows skip Tesseract.
 
     ImageRGB32 filtered = to_blackwhite_rgb32_range(image, 0xff000000, threshold, true);
     PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(image, 0xff000000, threshold);
@@ -88,12 +102,30 @@ std::vector<WaterfillOCRResult> waterfill_OCR(
         0, objects.size(),
         [&](size_t index){
             WaterfillObject& object = objects[index];
-            ImageRGB32 cropped = extract_box_reference(filtered, object).copy();
             PackedBinaryMatrix tmp(object.packed_matrix());
+            OCR::GlyphClassifier::Glyph glyph = OCR::GlyphClassifier::make_glyph(tmp);
+            char ch = glyphs.classify(glyph);
+            if (ch != 0){
+                ret[index].matrix = std::move(tmp);
+                ret[index].ocr = std::string(1, ch);
+                return;
+            }
+
+            ImageRGB32 cropped = extract_box_reference(filtered, object).copy();
             filter_by_mask(tmp, cropped, Color(0xffffffff), true);
             ImageRGB32 padded = pad_image(cropped, cropped.width(), 0xffffffff);
             ret[index].matrix = std::move(tmp);
             ret[index].ocr = OCR::ocr_read(Language::English, padded);
+
+            //  Only learn from clean single-character reads.
+            std::string& ocr = ret[index].ocr;
+            size_t length = ocr.size();
+            while (length > 0 && (uint8_t)ocr[length - 1] < (uint8_t)32){
+                length--;
+            }
+            if (length == 1 && (uint8_t)ocr[0] > (uint8_t)32 && (uint8_t)ocr[0] < (uint8_t)128){
+                glyphs.learn(glyph, ocr[0]);
+            }
         }
     );
 
@@ -112,7 +144,7 @@ std::vector<WaterfillOCRResult> waterfill_OCR(
 
 
 int16_t read_raid_timer(Logger& logger, AsyncDispatcher& dispatcher, const ImageViewRGB32& image){
-    std::vector<WaterfillOCRResult> characters = waterfill_OCR(dispatcher, image, 0xff7f7f7f);
+    std::vector<WaterfillOCRResult> characters = waterfill_OCR(dispatcher, image, 0xff7f7f7f, RAID_TIMER_GLYPHS());
 
 //    cout << "map.size() = " << map.size() << endl;
 //    for (auto& item : map){
@@ -179,7 +211,7 @@ std::string read_raid_code(Logger& logger, AsyncDispatcher& dispatcher, const Im
     };
 
     for (uint32_t filter : filters){
-        std::vector<WaterfillOCRResult> characters = waterfill_OCR(dispatcher, image, filter);
+        std::vector<WaterfillOCRResult> characters = waterfill_OCR(dispatcher, image, filter, RAID_CODE_GLYPHS());
 
         static const std::map<char, char> SUBSTITUTIONS{
             {'I', '1'},
@@ -28,6 +28,11 @@ ImageMatch::SilhouetteDictionaryMatcher make_TERA_RAID_SILHOUETTE_MATCHER(){
         ImageRGB32 filtered_image = to_blackwhite_rgb32_range(item.second.icon, 0xff000000, 0xff5f5f5f, true);
         matcher.add(item.first, filtered_image);
     }
+
+    //  There are 1000+ silhouettes. Only fully compare the best thumbnail
+    //  matches. Also run the exhaustive search and log any disagreement until
+    //  the pruning has been proven on real raids.
+    matcher.set_pruning(64, true);
     return matcher;
 }
 const ImageMatch::SilhouetteDictionaryMatcher& TERA_RAID_SILHOUETTE_MATCHER(){
@@ -58,6 +58,12 @@ PokemonSpriteMatcherCropped::PokemonSpriteMatcherCropped(const std::set<std::str
             add(item.first, item.second.sprite);
         }
     }
+
+    //  Without a subset, this is every sprite in the game. Only fully compare
+    //  the best thumbnail matches. (This does nothing for subsets of 64 or
+    //  fewer.) Also run the exhaustive search and log any disagreement until
+    //  the pruning has been proven on real dens.
+    set_pruning(64, true);
 }
 
 ImageRGB32 PokemonSpriteMatcherCropped::process_image(const ImageViewRGB32& image, Color& background) const{
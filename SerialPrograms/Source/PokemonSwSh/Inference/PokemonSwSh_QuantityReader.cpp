@@ -6,6 +6,7 @@
 
 #include "CommonFramework/Language.h"
 #include "CommonFramework/OCR/OCR_NumberReader.h"
+#include "CommonFramework/OCR/OCR_GlyphClassifier.h"
 #include "PokemonSwSh_QuantityReader.h"
 
 namespace PokemonAutomation{
@@ -13,6 +14,12 @@ namespace NintendoSwitch{
 namespace PokemonSwSh{
 
 
+OCR::GlyphClassifier& QUANTITY_GLYPHS(){
+    static OCR::GlyphClassifier glyphs;
+    return glyphs;
+}
+
+
 std::string ReadableQuantity999::to_str() const{
     if (unknown){
         return "?";
@@ -53,7 +60,7 @@ void ReadableQuantity999::update_with_ocr(
     Logger& logger, const ImageViewRGB32& image,
     int16_t max_quantity_differential
 ){
-    return update_with_ocr((int16_t)OCR::read_number(logger, image), max_quantity_differential);
+    return update_with_ocr((int16_t)OCR::read_number(logger, image, QUANTITY_GLYPHS()), max_quantity_differential);
 }
 
 
@@ -0,0 +1,268 @@
+/*  Command Line Benchmark
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdint.h>
+#include <chrono>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <streambuf>
+#include <iostream>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/AllocationCounter.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Environment/Environment.h"
+#include "CommonFramework/OCR/OCR_ResultCache.h"
+#include "CommonFramework/OCR/OCR_GlyphClassifier.h"
+#include "CommandLineBenchmark.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+// One frame at 60 fps.
+const double FRAME_MICROSECONDS = 1000000. / 60;
+
+struct TestObjectStats{
+    size_t files = 0;
+    std::vector<double> microseconds;   // One per timed run.
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+    uint64_t input_bytes = 0;
+};
+
+struct BenchmarkState{
+    size_t iterations;
+
+    // The test object whose test function is running.
+    std::string current_key;
+
+    std::map<std::string, TestObjectStats> stats;
+};
+
+// Non-null only while a benchmark is running.
+BenchmarkState* g_benchmark = nullptr;
+
+
+// Drops everything written to it. Used to silence the test code while it
+// runs over and over.
+class NullStreamBuffer : public std::streambuf{
+protected:
+    virtual int_type overflow(int_type ch) override{
+        return traits_type::not_eof(ch);
+    }
+    virtual std::streamsize xsputn(const char*, std::streamsize count) override{
+        return count;
+    }
+};
+
+class SuppressConsoleOutput{
+public:
+    SuppressConsoleOutput()
+        : m_cout(cout.rdbuf(&m_null))
+        , m_cerr(cerr.rdbuf(&m_null))
+    {}
+    ~SuppressConsoleOutput(){
+        cout.rdbuf(m_cout);
+        cerr.rdbuf(m_cerr);
+    }
+
+private:
+    NullStreamBuffer m_null;
+    std::streambuf* m_cout;
+    std::streambuf* m_cerr;
+};
+
+
+// Nearest-rank percentile. "sorted" must not be empty.
+double percentile(const std::vector<double>& sorted, double p){
+    size_t rank = (size_t)(p * sorted.size() + 0.999999);
+    rank = std::max<size_t>(rank, 1);
+    return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+
+JsonObject to_json(const TestObjectStats& stats){
+    std::vector<double> sorted = stats.microseconds;
+    std::sort(sorted.begin(), sorted.end());
+
+    double total = 0;
+    for (double x : sorted){
+        total += x;
+    }
+    double runs = (double)sorted.size();
+    double p99 = percentile(sorted, 0.99);
+
+    JsonObject obj;
+    obj["Files"] = stats.files;
+    obj["Runs"] = sorted.size();
+    obj["p50_us"] = percentile(sorted, 0.50);
+    obj["p95_us"] = percentile(sorted, 0.95);
+    obj["p99_us"] = p99;
+    obj["Mean_us"] = total / runs;
+    obj["AllocationsPerRun"] = stats.allocations / runs;
+    obj["AllocatedBytesPerRun"] = stats.allocated_bytes / runs;
+    obj["InputBytesPerRun"] = stats.input_bytes / runs;
+    obj["BytesTouchedPerRun"] = (stats.input_bytes + stats.allocated_bytes) / runs;
+    obj["FrameBudgetPercent_p99"] = 100 * p99 / FRAME_MICROSECONDS;
+    return obj;
+}
+
+void print_summary(const std::map<std::string, TestObjectStats>& stats){
+    cout << "===========================================" << endl;
+    cout << "Benchmark (p50 / p95 / p99 in microseconds, allocations per run, % of a 60 fps frame at p99):" << endl;
+    for (const auto& item : stats){
+        std::vector<double> sorted = item.second.microseconds;
+        std::sort(sorted.begin(), sorted.end());
+        double p99 = percentile(sorted, 0.99);
+        cout << "- " << item.first << ": "
+             << tostr_fixed(percentile(sorted, 0.50), 1) << " / "
+             << tostr_fixed(percentile(sorted, 0.95), 1) << " / "
+             << tostr_fixed(p99, 1) << ", "
+             << tostr_fixed((double)item.second.allocations / sorted.size(), 1) << " allocs, "
+             << tostr_fixed(100 * p99 / FRAME_MICROSECONDS, 2) << "%" << endl;
+    }
+}
+
+}
+
+
+
+int run_benchmarked_test(size_t input_bytes, const std::function<int()>& test){
+    //  Start every run with untrained glyph classifiers. So the runs of a file
+    //  don't depend on what the files before it taught them.
+    if (g_benchmark != nullptr){
+        OCR::GlyphClassifier::clear_all();
+    }
+    int ret = test();
+    if (g_benchmark == nullptr || ret != 0){
+        return ret;
+    }
+
+    TestObjectStats& stats = g_benchmark->stats[g_benchmark->current_key];
+    stats.files++;
+
+    SuppressConsoleOutput suppress;
+    AllocationCounter::set_enabled(true);
+    for (size_t c = 0; c < g_benchmark->iterations; c++){
+        OCR::GlyphClassifier::clear_all();
+        AllocationStats alloc_start = AllocationCounter::current();
+        auto time_start = std::chrono::steady_clock::now();
+        test();
+        auto time_end = std::chrono::steady_clock::now();
+        AllocationStats alloc_end = AllocationCounter::current();
+
+        stats.microseconds.emplace_back(std::chrono::duration<double, std::micro>(time_end - time_start).count());
+        stats.allocations += alloc_end.allocations - alloc_start.allocations;
+        stats.allocated_bytes += alloc_end.bytes - alloc_start.bytes;
+        stats.input_bytes += input_bytes;
+    }
+    AllocationCounter::set_enabled(false);
+
+    return ret;
+}
+
+TestFunction benchmark_test_function(std::string test_key, TestFunction test_func){
+    if (g_benchmark == nullptr){
+        return test_func;
+    }
+    return [test_key = std::move(test_key), test_func = std::move(test_func)](const std::string& test_file_path){
+        g_benchmark->current_key = test_key;
+        return test_func(test_file_path);
+    };
+}
+
+
+
+int run_command_line_benchmark(const std::function<int()>& run_tests){
+    GlobalSettings& settings = GlobalSettings::instance();
+
+    BenchmarkState state;
+    state.iterations = settings.COMMAND_LINE_BENCHMARK_ITERATIONS;
+
+    // Benchmark at the current level, or at every available level.
+    const std::vector<CpuCapabilityOption>& LEVELS = AVAILABLE_CAPABILITIES();
+    std::vector<size_t> levels;
+    if (settings.COMMAND_LINE_BENCHMARK_ALL_PROCESSOR_LEVELS){
+        for (size_t c = 0; c < LEVELS.size(); c++){
+            if (LEVELS[c].available){
+                levels.emplace_back(c);
+            }
+        }
+    }else{
+        levels.emplace_back(settings.PROCESSOR_LEVEL0.current_value());
+    }
+
+    //  Every repeat reads the same image. Don't let them hit the cache.
+    OCR::ResultCache& ocr_cache = OCR::ResultCache::instance();
+    ocr_cache.clear();
+    ocr_cache.set_suspended(true);
+
+    JsonArray results;
+    int ret = 0;
+    for (size_t level : levels){
+        cout << "Benchmark at processor level: " << LEVELS[level].display << endl;
+        settings.PROCESSOR_LEVEL0.set_global(level);
+
+        state.stats.clear();
+        g_benchmark = &state;
+        ret = run_tests();
+        g_benchmark = nullptr;
+        if (ret != 0){
+            break;
+        }
+
+        print_summary(state.stats);
+
+        JsonObject tests;
+        for (const auto& item : state.stats){
+            tests[item.first] = to_json(item.second);
+        }
+        JsonObject obj;
+        obj["Level"] = LEVELS[level].slug;
+        obj["Display"] = LEVELS[level].display;
+        obj["Tests"] = std::move(tests);
+        results.push_back(std::move(obj));
+    }
+
+    // Restore the level from the settings.
+    settings.PROCESSOR_LEVEL0.set_global();
+    ocr_cache.set_suspended(false);
+
+    if (ret != 0){
+        cerr << "Error: tests failed. No benchmark results are written." << endl;
+        return ret;
+    }
+
+    JsonObject root;
+    root["Processor"] = get_processor_name();
+    root["Iterations"] = state.iterations;
+    root["Levels"] = std::move(results);
+
+    const std::string& path = settings.COMMAND_LINE_BENCHMARK_OUTPUT;
+    try{
+        root.dump(path);
+    }catch (FileException& e){
+        cerr << "Error: " << e.message() << endl;
+        return 1;
+    }
+    cout << "Benchmark results written to " << path << endl;
+    return 0;
+}
+
+
+
+}
@@ -0,0 +1,73 @@
+/*  Command Line Benchmark
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Benchmark mode of the command line tests. (see CommandLineTests.h)
+ *
+ *  Enable it by setting "20-GlobalSettings": "COMMAND_LINE_TESTS":
+ *  "BENCHMARK_ITERATIONS" to a positive number. The same tests are then run
+ *  as usual. Each test file is first run once to check the result. If it
+ *  passes, the test code is run that many more times with console output
+ *  suppressed. Each of those runs is timed.
+ *
+ *  Only the call into the test code is timed. Loading the image or audio file
+ *  and parsing the filename is not.
+ *
+ *  The OCR result cache is cleared and suspended for the whole benchmark.
+ *  Otherwise every repeat after the first would be a cache hit and OCR
+ *  detectors would time a lookup instead of OCR. The glyph classifiers of the
+ *  number readers (see OCR_GlyphClassifier.h) are cleared before every run,
+ *  outside the timing. They are off by default ("DEBUG": "OCR_GLYPH_CLASSIFIER"),
+ *  in which case the timings are of the Tesseract path. If they are turned on,
+ *  the timings are of the untrained path, which also falls back to Tesseract.
+ *
+ *  The results are printed and written as JSON to
+ *  "20-GlobalSettings": "COMMAND_LINE_TESTS": "BENCHMARK_OUTPUT".
+ *  (default "CommandLineBenchmark.json") For each test object, it has:
+ *  -   Latency percentiles (p50/p95/p99) and mean of a run, in microseconds.
+ *  -   Heap allocations and bytes allocated per run. (see AllocationCounter.h)
+ *  -   Input bytes per run. This is the size of the image or the spectrums.
+ *  -   Bytes touched per run. This is input bytes plus bytes allocated. It is
+ *      a lower bound on the memory traffic.
+ *      Replacing "operator new" is only built into the program with the
+ *      CMake option PA_COUNT_ALLOCATIONS. (qmake: CONFIG+=pa_count_allocations)
+ *      Without it, only "aligned_malloc()" is counted.
+ *  -   The p99 latency as a percentage of a 60 fps frame.
+ *
+ *  Set "BENCHMARK_ALL_PROCESSOR_LEVELS" to true to repeat everything at each
+ *  processor level this machine supports. (see ProcessorLevelOption)
+ *
+ *  Test objects that don't go through the helpers in TestMap.cpp are run
+ *  once and don't show up in the results.
+ *
+ */
+
+
+#ifndef PokemonAutomation_Tests_CommandLineBenchmark_H
+#define PokemonAutomation_Tests_CommandLineBenchmark_H
+
+#include <stddef.h>
+#include <string>
+#include <functional>
+#include "TestMap.h"
+
+namespace PokemonAutomation{
+
+
+// Called by the TestMap.cpp helpers to run the test code on one test file.
+// If a benchmark is running, "test" is repeated and timed. Otherwise it is
+// run once. Returns the result of the first run.
+int run_benchmarked_test(size_t input_bytes, const std::function<int()>& test);
+
+// If a benchmark is running, return a TestFunction that records its timings
+// under "test_key". Otherwise return "test_func" unchanged.
+TestFunction benchmark_test_function(std::string test_key, TestFunction test_func);
+
+// Called by run_command_line_tests() when benchmarking is enabled.
+// "run_tests" runs all the selected tests once. Return 0 if all tests pass.
+int run_command_line_benchmark(const std::function<int()>& run_tests);
+
+
+
+}
+#endif
@@ -6,6 +6,7 @@
 
 
 #include "CommandLineTests.h"
+#include "CommandLineBenchmark.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "PokemonLA_Tests.h"
 #include "TestMap.h"
@@ -158,11 +159,8 @@ int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::v
 
 
 
-} // end of anonymous namespace
-
-
-
-int run_command_line_tests(){
+// Run all tests, or only the ones in TEST_LIST.
+int run_selected_tests(){
     const auto& root_folder_name = GlobalSettings::instance().COMMAND_LINE_TEST_FOLDER;
 
     QDir test_root_dir(root_folder_name.c_str());
@@ -285,4 +283,22 @@ int run_command_line_tests(){
 }
 
 
+
+
+} // end of anonymous namespace
+
+
+
+int run_command_line_tests(){
+    if (GlobalSettings::instance().COMMAND_LINE_BENCHMARK_ITERATIONS > 0){
+        return run_command_line_benchmark(run_selected_tests);
+    }
+
+    //  Cross-check the OCR dictionary index against the exhaustive search on
+    //  every test image. (Not when benchmarking since it doubles the cost.)
+    PreloadSettings::debug().OCR_DICTIONARY_INDEX = true;
+    return run_selected_tests();
+}
+
+
 }
\ No newline at end of file
@@ -44,6 +44,9 @@
  *  If you have put some test files for experimental code in a folder and later decide to not run that code for a while, you can use
  *  "20-GlobalSettings": "COMMAND_LINE_TESTS": "IGNORE_LIST" as a list of strings to skip the paths to those tests.
  *  Each string in the list serves as a prefix to the test path that the test framework uses to filter out paths.
+ *
+ *  To measure how long the tested code takes, set "20-GlobalSettings": "COMMAND_LINE_TESTS": "BENCHMARK_ITERATIONS".
+ *  See CommandLineBenchmark.h.
  *  
  * Those "hidden" files are useful for storing some metadata in the folder, or serving as an extra file in case some tests need more than one test files.
  * 
@@ -5,11 +5,16 @@
  */
 
 
+#include <algorithm>
+#include <QImage>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels/ImageHSV/Kernels_ImageHSV.h"
+#include "CommonFramework/ImageTypes/ImageHSV32.h"
+#include "CommonFramework/ImageTools/BinaryImage_FilterHsv32.h"
 #include "Kernels_Tests.h"
 
 #include <iostream>
@@ -40,4 +45,140 @@ int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image){
     return 0;
 }
 
+
+namespace{
+
+bool hsv32_in_range(uint32_t pixel, uint32_t mins, uint32_t maxs){
+    for (int shift = 0; shift < 32; shift += 8){
+        uint8_t x = (uint8_t)(pixel >> shift);
+        uint8_t lo = (uint8_t)(mins >> shift);
+        uint8_t hi = (uint8_t)(maxs >> shift);
+        bool in = shift == 16 && lo > hi
+            ? x >= lo || x <= hi    //  Hue wraps around.
+            : lo <= x && x <= hi;
+        if (!in){
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+//  Compare the vectorized RGB to HSV conversion and the HSV range filters
+//  against the per-pixel reference. Any image can be used as a test file.
+int test_kernels_FilterHsv32(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+
+    ImageHSV32 hsv(image);
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            uint32_t expected = rgb32_to_hsv32(image.pixel(c, r));
+            if (hsv.pixel(c, r) != expected){
+                cerr << "Error: HSV mismatch at (" << c << ", " << r << "): " << hsv.pixel(c, r) << " vs. " << expected << endl;
+                return 1;
+            }
+        }
+    }
+
+    const std::vector<std::pair<uint32_t, uint32_t>> filters{
+        {0xff000000, 0xffffffff},   //  Everything opaque.
+        {0xff202080, 0xff60ffff},   //  Bright, saturated yellows and greens.
+        {0xffe04040, 0xff20ffff},   //  Reds. The hue range wraps around.
+        {0xff000000, 0xffff30ff},   //  Unsaturated. (white, grey, black)
+    };
+
+    std::vector<PackedBinaryMatrix> batch = compress_hsv32_to_binary_range(hsv, filters);
+    for (size_t i = 0; i < filters.size(); i++){
+        const uint32_t mins = filters[i].first;
+        const uint32_t maxs = filters[i].second;
+        PackedBinaryMatrix single = compress_rgb32_to_binary_hsv_range(image, mins, maxs);
+        for (size_t r = 0; r < height; r++){
+            for (size_t c = 0; c < width; c++){
+                bool expected = hsv32_in_range(hsv.pixel(c, r), mins, maxs);
+                if (batch[i].get(c, r) != expected || single.get(c, r) != expected){
+                    cerr << "Error: HSV filter " << i << " mismatch at (" << c << ", " << r << ")." << endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    cout << "HSV conversion and filters match the reference." << endl;
+    return 0;
+}
+
+
+//  Compare nearest-neighbor "scale_to()" against "QImage::scaled()" over a
+//  sweep of output sizes. "scale_to()" must sample exactly at the pixel
+//  centers. Qt may round to a neighboring source pixel, but no further.
+//  Any image can be used as a test file.
+int test_kernels_ImageScale(const ImageViewRGB32& image){
+    //  Compare opaque pixels only. Qt composites when scaling, which changes
+    //  the colors of transparent pixels.
+    ImageRGB32 opaque = image.copy();
+    for (size_t r = 0; r < opaque.height(); r++){
+        for (size_t c = 0; c < opaque.width(); c++){
+            opaque.pixel(c, r) |= 0xff000000;
+        }
+    }
+
+    const size_t in_width = opaque.width();
+    const size_t in_height = opaque.height();
+    std::vector<std::pair<size_t, size_t>> sizes{
+        {1, 1}, {7, 5}, {16, 16}, {50, 50},
+        {in_width / 3, in_height / 3},
+        {in_width / 2, in_height / 2},
+        {in_width * 2 / 3, in_height * 2 / 3},
+        {in_width * 97 / 100, in_height * 97 / 100},
+        {in_width + 1, in_height - 1},
+        {in_width * 3 / 2, in_height * 3 / 2},
+        {in_width * 2, in_height * 2},
+    };
+
+    for (const auto& size : sizes){
+        const size_t width = size.first;
+        const size_t height = size.second;
+        if (width == 0 || height == 0){
+            continue;
+        }
+
+        ImageRGB32 ours = opaque.scale_to(width, height);
+        ImageRGB32 qt(opaque.scaled_to_QImage(width, height).convertToFormat(QImage::Format_ARGB32));
+
+        size_t exact = 0;
+        for (size_t r = 0; r < height; r++){
+            size_t sy = (2*r + 1) * in_height / (2 * height);
+            for (size_t c = 0; c < width; c++){
+                size_t sx = (2*c + 1) * in_width / (2 * width);
+                if (ours.pixel(c, r) != opaque.pixel(sx, sy)){
+                    cerr << "Error: " << width << " x " << height << ": scale_to() sampled the wrong pixel at (" << c << ", " << r << ")." << endl;
+                    return 1;
+                }
+
+                uint32_t qt_pixel = qt.pixel(c, r);
+                if (qt_pixel == ours.pixel(c, r)){
+                    exact++;
+                    continue;
+                }
+                bool near = false;
+                for (size_t y = (sy == 0 ? 0 : sy - 1); y <= std::min(sy + 1, in_height - 1) && !near; y++){
+                    for (size_t x = (sx == 0 ? 0 : sx - 1); x <= std::min(sx + 1, in_width - 1) && !near; x++){
+                        near = opaque.pixel(x, y) == qt_pixel;
+                    }
+                }
+                if (!near){
+                    cerr << "Error: " << width << " x " << height << ": QImage::scaled() differs by more than one source pixel at (" << c << ", " << r << ")." << endl;
+                    return 1;
+                }
+            }
+        }
+        cout << width << " x " << height << ": " << 100. * exact / (width * height) << "% identical to QImage::scaled()" << endl;
+    }
+
+    return 0;
+}
+
+
 }
@@ -15,6 +15,10 @@ class ImageViewRGB32;
 
 int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image);
 
+int test_kernels_FilterHsv32(const ImageViewRGB32& image);
+
+int test_kernels_ImageScale(const ImageViewRGB32& image);
+
 }
 
 #endif
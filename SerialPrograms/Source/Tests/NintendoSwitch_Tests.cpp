@@ -9,7 +9,9 @@
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/Logging/Logger.h"
 #include "NintendoSwitch/Inference/NintendoSwitch_DetectHome.h"
+#include "NintendoSwitch/Inference/NintendoSwitch_DateReader.h"
 #include "NintendoSwitch_Tests.h"
 #include "TestUtils.h"
 
@@ -30,6 +32,23 @@ int test_NintendoSwitch_UpdateMenuDetector(const ImageViewRGB32& image, bool tar
     return 0;
 }
 
+int test_NintendoSwitch_DateReader(const ImageViewRGB32& image, int target){
+    auto& logger = global_logger_command_line();
+    DateReader reader;
+
+    int result = reader.read_hours(logger, image);
+    TEST_RESULT_EQUAL(result, target);
+
+    // Read it again with the hours going through the glyph classifier.
+    int glyph_result = -1;
+    uint64_t classified = run_with_trained_glyphs(image, [&](const ImageViewRGB32& frame){
+        glyph_result = reader.read_hours(logger, frame);
+    });
+    cout << "Characters read by the glyph classifier: " << classified << endl;
+    TEST_RESULT_COMPONENT_EQUAL(glyph_result, target, "glyph classifier");
+    return 0;
+}
+
 
 
 }
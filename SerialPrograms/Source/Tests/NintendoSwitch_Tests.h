@@ -15,6 +15,8 @@ class ImageViewRGB32;
 
 int test_NintendoSwitch_UpdateMenuDetector(const ImageViewRGB32& image, bool target);
 
+int test_NintendoSwitch_DateReader(const ImageViewRGB32& image, int target);
+
 }
 
 #endif
@@ -6,6 +6,7 @@
 
 
 #include "Common/Compiler.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
 #include "PokemonSV_Tests.h"
 #include "TestUtils.h"
 
@@ -18,6 +19,7 @@
 #include "PokemonSV/Inference/Tera/PokemonSV_TeraCardDetector.h"
 #include "PokemonSV/Inference/Tera/PokemonSV_TeraSilhouetteReader.h"
 #include "PokemonSV/Inference/Tera/PokemonSV_TeraTypeReader.h"
+#include "PokemonSV/Inference/Tera/PokemonSV_TeraCodeReader.h"
 #include "PokemonSV/Inference/Picnics/PokemonSV_PicnicDetector.h"
 #include "PokemonSV/Inference/Picnics/PokemonSV_SandwichRecipeDetector.h"
 #include "PokemonSV/Inference/Picnics/PokemonSV_SandwichHandDetector.h"
@@ -370,4 +372,29 @@ int test_pokemonSV_SandwichIngredientsDetector(const ImageViewRGB32& image, cons
     return 0;
 }
 
+int test_pokemonSV_TeraCodeReader(const ImageViewRGB32& image, const std::vector<std::string>& words){
+    // last word: <raid code>, e.g. "Code_4QPS6R.png", "Code_1234.png".
+    if (words.size() == 0){
+        cerr << "Error: no raid code found in the filename." << endl;
+        return 1;
+    }
+    const std::string& target = words[words.size()-1];
+
+    auto& logger = global_logger_command_line();
+    AsyncDispatcher dispatcher([]{}, 1);
+
+    std::string result = read_raid_code(logger, dispatcher, image);
+    TEST_RESULT_EQUAL(result, target);
+
+    // Read it again with the characters going through the glyph classifier.
+    std::string glyph_result;
+    uint64_t classified = run_with_trained_glyphs(image, [&](const ImageViewRGB32& frame){
+        glyph_result = read_raid_code(logger, dispatcher, frame);
+    });
+    cout << "Characters read by the glyph classifier: " << classified << endl;
+    TEST_RESULT_COMPONENT_EQUAL(glyph_result, target, "glyph classifier");
+
+    return 0;
+}
+
 }
@@ -46,6 +46,8 @@ int test_pokemonSV_BoxBottomButtonDetector(const ImageViewRGB32& image, const st
 
 int test_pokemonSV_SandwichIngredientsDetector(const ImageViewRGB32& image, const std::vector<std::string>& words);
 
+int test_pokemonSV_TeraCodeReader(const ImageViewRGB32& image, const std::vector<std::string>& words);
+
 }
 
 #endif
@@ -16,6 +16,7 @@
 #include "PokemonSwSh/MaxLair/Inference/PokemonSwSh_MaxLair_Detect_BattleMenu.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_DialogBoxDetector.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_BoxShinySymbolDetector.h"
+#include "PokemonSwSh/Inference/PokemonSwSh_QuantityReader.h"
 
 #include <QFileInfo>
 #include <QDir>
@@ -125,4 +126,24 @@ int test_pokemonSwSh_BoxGenderDetector(const ImageViewRGB32& image, int target){
     return 0;
 }
 
+int test_pokemonSwSh_QuantityReader(const ImageViewRGB32& image, int target){
+    auto& logger = global_logger_command_line();
+
+    ReadableQuantity999 quantity;
+    quantity.update_with_ocr(logger, image);
+    TEST_RESULT_EQUAL(quantity.read_error, false);
+    TEST_RESULT_EQUAL((int)quantity.quantity, target);
+
+    // Read it again with the digits going through the glyph classifier.
+    ReadableQuantity999 glyph_quantity;
+    uint64_t classified = run_with_trained_glyphs(image, [&](const ImageViewRGB32& frame){
+        glyph_quantity = ReadableQuantity999();
+        glyph_quantity.update_with_ocr(logger, frame);
+    });
+    cout << "Characters read by the glyph classifier: " << classified << endl;
+    TEST_RESULT_COMPONENT_EQUAL(glyph_quantity.read_error, false, "glyph classifier read error");
+    TEST_RESULT_COMPONENT_EQUAL((int)glyph_quantity.quantity, target, "glyph classifier");
+    return 0;
+}
+
 }
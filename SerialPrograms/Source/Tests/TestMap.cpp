@@ -14,6 +14,7 @@
 #include "PokemonSV_Tests.h"
 #include "TestMap.h"
 #include "TestUtils.h"
+#include "CommandLineBenchmark.h"
 #include "CommonFramework/AudioPipeline/AudioTemplate.h"
 
 #include <QFileInfo>
@@ -46,14 +47,20 @@ using ImageWordsDetectorFunction = std::function<int(const ImageViewRGB32& image
 
 using ImageVoidDetectorFunction = std::function<void(const ImageViewRGB32& image)>;
 
+using ImageCheckFunction = std::function<int(const ImageViewRGB32& image)>;
+
+using ImageFilenameParser = std::function<ImageCheckFunction(const std::string& filename_base)>;
+
 using SoundBoolDetectorFunction = std::function<int(const std::vector<AudioSpectrum>& spectrums, bool target)>;
 
 // Basic check on whether an image can be loaded.
 // Also strip the image format suffix (.png and so on)
 
-// Helper for testing code that reads an image and uses filename to get the target outcome for the code.
-// test_func: reads an image and the image filename base and returns an int code.
-int image_filename_detector_helper(ImageFilenameFunction test_func, const std::string& test_path){
+// Helper for the image helpers below.
+// parse_filename: reads the target outcome from the image filename base and returns the test
+// to run on the image. It returns nullptr if the filename is malformed, after printing the error.
+// The filename is parsed before the test runs. So a benchmark only times the returned test.
+int image_parsed_filename_helper(ImageFilenameParser parse_filename, const std::string& test_path){
     ImageRGB32 image;
     std::string basename;
     try{
@@ -74,7 +81,26 @@ int image_filename_detector_helper(ImageFilenameFunction test_func, const std::s
         cout << "Skip " << test_path << " as it cannot be read as image" << endl;
         return -1;
     }
-    return test_func(image, basename);
+
+    const ImageCheckFunction test = parse_filename(basename);
+    if (!test){
+        return 1;
+    }
+
+    const size_t image_bytes = image.width() * image.height() * sizeof(uint32_t);
+    return run_benchmarked_test(image_bytes, [&]{ return test(image); });
+}
+
+// Helper for testing code that reads an image and uses filename to get the target outcome for the code.
+// test_func: reads an image and the image filename base and returns an int code.
+int image_filename_detector_helper(ImageFilenameFunction test_func, const std::string& test_path){
+    auto parse_filename = [&](const std::string& filename_base) -> ImageCheckFunction{
+        return [&test_func, filename_base](const ImageViewRGB32& image){
+            return test_func(image, filename_base);
+        };
+    };
+
+    return image_parsed_filename_helper(parse_filename, test_path);
 }
 
 
@@ -82,7 +108,7 @@ int image_filename_detector_helper(ImageFilenameFunction test_func, const std::s
 // The target test result (whether this test file should be detected as true or false)
 // is stored as part of the filename. For example, IngoBattleDayTime_True.png.
 int image_bool_detector_helper(ImageBoolDetectorFunction test_func, const std::string& test_path){
-    auto parse_filename_and_run_test = [&](const ImageViewRGB32& image, const std::string& filename_base){
+    auto parse_filename = [&](const std::string& filename_base) -> ImageCheckFunction{
         const auto name_base = QString::fromStdString(filename_base);
         bool target_bool = false;
         if (name_base.endsWith("_True")){
@@ -91,66 +117,77 @@ int image_bool_detector_helper(ImageBoolDetectorFunction test_func, const std::s
             target_bool = false;
         } else{
             cerr << "Error: image test file " << test_path << " has incorrect target detection result (_True/_False) set in the filename." << endl;
-            return 1;
+            return nullptr;
         }
 
-        return test_func(image, target_bool);
+        return [&test_func, target_bool](const ImageViewRGB32& image){
+            return test_func(image, target_bool);
+        };
     };
 
-    return image_filename_detector_helper(parse_filename_and_run_test, test_path);
+    return image_parsed_filename_helper(parse_filename, test_path);
 }
 
 // Helper for testing detector code that reads an image and returns some custom data that can be described
 // by words included in the test filename.
 // The helper will split the filename by "_" into words and send it in the same order to the test function.
 int image_words_detector_helper(ImageWordsDetectorFunction test_func, const std::string& test_path){
-    auto parse_filename_and_run_test = [&](const ImageViewRGB32& image, const std::string& filename_base){
-        return test_func(image, parse_words(filename_base));
+    auto parse_filename = [&](const std::string& filename_base) -> ImageCheckFunction{
+        std::vector<std::string> words = parse_words(filename_base);
+        return [&test_func, words = std::move(words)](const ImageViewRGB32& image){
+            return test_func(image, words);
+        };
     };
 
-    return image_filename_detector_helper(parse_filename_and_run_test, test_path);
+    return image_parsed_filename_helper(parse_filename, test_path);
 }
 
 // Helper for testing detector code that reads an image and returns a non-negative float that can be described
 // in the filename for example <name_base>_0.4.png.
 int image_non_negative_float_detector_helper(ImageFloatDetectorFunction test_func, const std::string& test_path){
-    auto parse_filename_and_run_test = [&](const ImageViewRGB32& image, const std::vector<std::string>& words) -> int{
+    auto parse_filename = [&](const std::string& filename_base) -> ImageCheckFunction{
+        const std::vector<std::string> words = parse_words(filename_base);
         if (words.size() < 2){
             cerr << "Error: image test file " << test_path << " does not have two non-negative floats (e.g image_0.4_0.001.png) set in the filename." << endl;
-            return 1;
+            return nullptr;
         }
 
         float target_number = 0.0f, threshold = 0.0f;
 
         if (parse_float(words[words.size()-2], target_number) == false || parse_float(words[words.size()-1], threshold) == false){
             cerr << "Error: image test file " << test_path << " does not have two non-negative floats (e.g image_0.4_0.001.png) set in the filename." << endl;
-            return 1;
+            return nullptr;
         }
 
-        return test_func(image, target_number, threshold);
+        return [&test_func, target_number, threshold](const ImageViewRGB32& image){
+            return test_func(image, target_number, threshold);
+        };
     };
 
-    return image_words_detector_helper(parse_filename_and_run_test, test_path);
+    return image_parsed_filename_helper(parse_filename, test_path);
 }
 
 int image_int_detector_helper(ImageIntDetectorFunction test_func, const std::string& test_path){
-    auto parse_filename_and_run_test = [&](const ImageViewRGB32& image, const std::vector<std::string>& words) -> int{
+    auto parse_filename = [&](const std::string& filename_base) -> ImageCheckFunction{
+        const std::vector<std::string> words = parse_words(filename_base);
         if (words.size() == 0){
             cerr << "Error: image test file " << test_path << " does not have an int (e.g image_5.png) set in the filename." << endl;
-            return 1;
+            return nullptr;
         }
 
         int target_number = 0;
 
         if (parse_int(words[words.size()-1], target_number) == false){
             cerr << "Error: image test file " << test_path << " does not have an int (e.g image_5.png) set in the filename." << endl;
-            return 1;
+            return nullptr;
         }
 
-        return test_func(image, target_number);
+        return [&test_func, target_number](const ImageViewRGB32& image){
+            return test_func(image, target_number);
+        };
     };
 
-    return image_words_detector_helper(parse_filename_and_run_test, test_path);
+    return image_parsed_filename_helper(parse_filename, test_path);
 }
 
 
@@ -158,12 +195,25 @@ int image_int_detector_helper(ImageIntDetectorFunction test_func, const std::str
 // This is used for developing visual inference code where the developer writes custom
 // debugging output. So no need to get target values from the test framework.
 int image_void_detector_helper(ImageVoidDetectorFunction test_func, const std::string& test_path){
-    auto run_test = [&](const ImageViewRGB32& image, const std::string&) -> int{
-        test_func(image);
-        return 0;
+    auto parse_filename = [&](const std::string&) -> ImageCheckFunction{
+        return [&test_func](const ImageViewRGB32& image){
+            test_func(image);
+            return 0;
+        };
+    };
+
+    return image_parsed_filename_helper(parse_filename, test_path);
+}
+
+// Helper for testing code whose correct output can be computed from the image alone,
+// like a kernel against its reference implementation. Any image can be used as a test
+// file. The test function returns non-zero on a mismatch.
+int image_check_helper(ImageCheckFunction test_func, const std::string& test_path){
+    auto parse_filename = [&](const std::string&) -> ImageCheckFunction{
+        return test_func;
     };
 
-    return image_filename_detector_helper(run_test, test_path);
+    return image_parsed_filename_helper(parse_filename, test_path);
 }
 
 
@@ -213,7 +263,8 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
     // from newest (largest timestamp) to oldest (smallest timestamp) in the vector.
     std::reverse(spectrums.begin(), spectrums.end());
 
-    return test_func(spectrums, target_bool);
+    const size_t spectrum_bytes = spectrums.size() * audio_stream.numFrequencies() * sizeof(float);
+    return run_benchmarked_test(spectrum_bytes, [&]{ return test_func(spectrums, target_bool); });
 }
 
 
@@ -221,8 +272,11 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
 
 const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_ImageScaleBrightness", std::bind(image_void_detector_helper, test_kernels_ImageScaleBrightness, _1)},
+    {"Kernels_FilterHsv32", std::bind(image_check_helper, test_kernels_FilterHsv32, _1)},
+    {"Kernels_ImageScale", std::bind(image_check_helper, test_kernels_ImageScale, _1)},
     {"CommonFramework_BlackBorderDetector", std::bind(image_bool_detector_helper, test_CommonFramework_BlackBorderDetector, _1)},
     {"NintendoSwitch_UpdateMenuDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_UpdateMenuDetector, _1)},
+    {"NintendoSwitch_DateReader", std::bind(image_int_detector_helper, test_NintendoSwitch_DateReader, _1)},
     {"PokemonSwSh_YCommMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_YCommMenuDetector, _1)},
     {"PokemonSwSh_MaxLair_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_MaxLair_BattleMenuDetector, _1)},
     {"PokemonSwSh_DialogTriangleDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_DialogTriangleDetector, _1)},
@@ -234,6 +288,7 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSwSh_BlackDialogBoxDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_BlackDialogBoxDetector, _1)},
     {"PokemonSwSh_BoxShinySymbolDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_BoxShinySymbolDetector, _1)},
     {"PokemonSwSh_BoxGenderDetector", std::bind(image_int_detector_helper, test_pokemonSwSh_BoxGenderDetector, _1)},
+    {"PokemonSwSh_QuantityReader", std::bind(image_int_detector_helper, test_pokemonSwSh_QuantityReader, _1)},
     {"PokemonLA_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonLA_BattleMenuDetector, _1)},
     {"PokemonLA_BattlePokemonSwitchDetector", std::bind(image_bool_detector_helper, test_pokemonLA_BattlePokemonSwitchDetector, _1)},
     {"PokemonLA_TransparentDialogueDetector", std::bind(image_bool_detector_helper, test_pokemonLA_TransparentDialogueDetector, _1)},
@@ -261,6 +316,7 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSV_TerastallizingDetector", std::bind(image_bool_detector_helper, test_pokemonSV_TerastallizingDetector, _1)},
     {"PokemonSV_TeraSilhouetteReader", std::bind(image_words_detector_helper, test_pokemonSV_TeraSilhouetteReader, _1)},
     {"PokemonSV_TeraTypeReader", std::bind(image_words_detector_helper, test_pokemonSV_TeraTypeReader, _1)},
+    {"PokemonSV_TeraCodeReader", std::bind(image_words_detector_helper, test_pokemonSV_TeraCodeReader, _1)},
     {"PokemonSV_SandwichRecipeDetector", std::bind(image_words_detector_helper, test_pokemonSV_SandwichRecipeDetector, _1)},
     {"PokemonSV_SandwichHandDetector", std::bind(image_words_detector_helper, test_pokemonSV_SandwichHandDetector, _1)},
     {"PokemonSV_BoxPokemonInfoDetector", std::bind(image_words_detector_helper, test_pokemonSV_BoxPokemonInfoDetector, _1)},
@@ -278,7 +334,7 @@ TestFunction find_test_function(const std::string& test_space, const std::string
         cerr << "Warning: no test object named " << test_space << "_" << test_name << " found in the code." << endl;
         return nullptr;
     }
-    return it->second;
+    return benchmark_test_function(it->first, it->second);
 }
 
 }
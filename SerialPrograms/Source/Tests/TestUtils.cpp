@@ -5,6 +5,9 @@
  *  
  */
 
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/OCR/OCR_GlyphClassifier.h"
 #include "TestUtils.h"
 
 #include <iostream>
@@ -100,5 +103,32 @@ bool load_slug_list(const std::string& filepath, std::vector<std::string>& sprit
     return true;
 }
 
+uint64_t run_with_trained_glyphs(const ImageViewRGB32& image, const std::function<void(const ImageViewRGB32& image)>& read){
+    // Tesseract reads the same pixels the same way every time. So the
+    // classifiers only learn from different renderings of the characters.
+    const double SCALES[] = {0.94, 0.96, 0.97, 0.98, 1.02, 1.03, 1.04, 1.06};
+
+    DebugSettings& debug = PreloadSettings::debug();
+    const bool enabled = debug.OCR_GLYPH_CLASSIFIER;
+    debug.OCR_GLYPH_CLASSIFIER = true;
+    OCR::GlyphClassifier::clear_all();
+
+    for (double scale : SCALES){
+        ImageRGB32 scaled = image.scale_to(
+            (size_t)(image.width() * scale + 0.5),
+            (size_t)(image.height() * scale + 0.5)
+        );
+        read(scaled);
+    }
+
+    const uint64_t before = OCR::GlyphClassifier::total_classified();
+    read(image);
+    const uint64_t classified = OCR::GlyphClassifier::total_classified() - before;
+
+    OCR::GlyphClassifier::clear_all();
+    debug.OCR_GLYPH_CLASSIFIER = enabled;
+    return classified;
+}
+
 
 }
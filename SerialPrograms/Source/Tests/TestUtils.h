@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <functional>
 
 namespace PokemonAutomation{
 
@@ -47,6 +48,14 @@ bool load_sprite_count(const std::string& filepath, std::map<std::string, int>&
 bool load_slug_list(const std::string& filepath, std::vector<std::string>& sprites);
 
 
+// Run "read" with the learned glyph classifiers turned on. (see OCR_GlyphClassifier.h)
+// All classifiers are cleared and then trained by reading slightly rescaled copies
+// of the image. The last call to "read" is on the image itself.
+// Return the number of characters the classifiers recognized in that last call.
+// The classifiers are cleared again and the setting is restored afterwards.
+uint64_t run_with_trained_glyphs(const ImageViewRGB32& image, const std::function<void(const ImageViewRGB32& image)>& read);
+
+
 // Implement the dummy interface of BotBase so that we can run the test code
 // that relies on a BotBase.
 class DummyBotBase: public BotBase{